@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bench {
+// Heap allocations made so far through the global operator new, which the
+// benchmark binary replaces with a counting one.
+size_t allocation_count();
+} // namespace bench
@@ -0,0 +1,200 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+using bench::BenchFunction;
+using bench::Registration;
+using bench::State;
+
+namespace {
+struct Benchmark {
+    std::string name;
+    BenchFunction function;
+    std::vector<long> args;
+};
+
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+void report(const std::string& name, const State& state)
+{
+    double seconds = state.elapsed_seconds();
+    double per_iteration = seconds / static_cast<double>(state.iterations());
+
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(10) << state.iterations() << " it "
+              << std::setw(14) << std::fixed << std::setprecision(1)
+              << per_iteration * 1e9 << " ns/it";
+    if (state.bytes_processed() != 0) {
+        std::cout << std::setw(12) << std::setprecision(1)
+                  << static_cast<double>(state.bytes_processed()) / seconds
+                        / (1024.0 * 1024.0)
+                  << " MiB/s";
+    }
+    if (state.items_processed() != 0) {
+        std::cout << std::setw(14) << std::setprecision(0)
+                  << static_cast<double>(state.items_processed()) / seconds
+                  << " items/s";
+    }
+    for (auto&& [counter, value] : state.counters) {
+        std::cout << "  " << counter << "=" << std::setprecision(3) << value;
+    }
+    std::cout << std::endl;
+}
+
+// Doubles the iteration count until one run takes at least min_time, so that
+// every reported figure is averaged over a measurable amount of work.
+void run(
+        const std::string& name,
+        BenchFunction function,
+        long arg,
+        double min_time)
+{
+    size_t iterations = 1;
+    while (true) {
+        State state(iterations, arg);
+        function(state);
+        double seconds = state.elapsed_seconds();
+        if (seconds >= min_time || iterations >= (size_t{1} << 30)) {
+            report(name, state);
+            return;
+        }
+        size_t next = seconds > 0
+                ? static_cast<size_t>(
+                        static_cast<double>(iterations) * 1.4 * min_time
+                        / seconds)
+                : iterations * 10;
+        iterations = std::max(iterations * 2, next);
+    }
+}
+} // namespace
+
+State::State(size_t iterations, long arg)
+    : iterations_{iterations},
+      remaining_{iterations},
+      arg_{arg},
+      started_{false},
+      paused_{false},
+      elapsed_{0},
+      bytes_processed_{0},
+      items_processed_{0}
+{
+}
+
+bool State::keep_running()
+{
+    if (!started_) {
+        started_ = true;
+        start_ = Clock::now();
+    }
+    if (remaining_ == 0) {
+        if (!paused_) {
+            elapsed_ += Clock::now() - start_;
+            paused_ = true;
+        }
+        return false;
+    }
+    remaining_--;
+    return true;
+}
+
+void State::pause_timing()
+{
+    if (!paused_) {
+        elapsed_ += Clock::now() - start_;
+        paused_ = true;
+    }
+}
+
+void State::resume_timing()
+{
+    if (paused_) {
+        start_ = Clock::now();
+        paused_ = false;
+    }
+}
+
+size_t State::iterations() const
+{
+    return iterations_;
+}
+
+long State::arg() const
+{
+    return arg_;
+}
+
+double State::elapsed_seconds() const
+{
+    return std::chrono::duration<double>(elapsed_).count();
+}
+
+void State::set_bytes_processed(size_t bytes)
+{
+    bytes_processed_ = bytes;
+}
+
+void State::set_items_processed(size_t items)
+{
+    items_processed_ = items;
+}
+
+size_t State::bytes_processed() const
+{
+    return bytes_processed_;
+}
+
+size_t State::items_processed() const
+{
+    return items_processed_;
+}
+
+Registration::Registration(
+        const char* suite,
+        const char* name,
+        BenchFunction function,
+        std::vector<long> args)
+{
+    registry().push_back(
+            {std::string(suite) + "/" + name, function, std::move(args)});
+}
+
+int bench::run_all(int argc, char* argv[])
+{
+    std::string_view filter;
+    double min_time = 0.5;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        if (arg.substr(0, 11) == "--min-time=") {
+            min_time = std::stod(std::string(arg.substr(11)));
+        } else if (arg.substr(0, 9) == "--filter=") {
+            filter = arg.substr(9);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter=<substring>] [--min-time=<seconds>]\n";
+            return 1;
+        }
+    }
+
+    for (auto&& benchmark : registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if (benchmark.args.empty()) {
+            run(benchmark.name, benchmark.function, 0, min_time);
+        }
+        for (long arg : benchmark.args) {
+            run(benchmark.name + "/" + std::to_string(arg),
+                benchmark.function,
+                arg,
+                min_time);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bench {
+class State {
+public:
+    State(size_t iterations, long arg);
+    bool keep_running();
+    void pause_timing();
+    void resume_timing();
+    size_t iterations() const;
+    long arg() const;
+    double elapsed_seconds() const;
+    void set_bytes_processed(size_t bytes);
+    void set_items_processed(size_t items);
+    size_t bytes_processed() const;
+    size_t items_processed() const;
+
+    // Extra per-benchmark figures, printed as they are after the timings.
+    std::map<std::string, double> counters;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    size_t iterations_;
+    size_t remaining_;
+    long arg_;
+    bool started_;
+    bool paused_;
+    Clock::time_point start_;
+    Clock::duration elapsed_;
+    size_t bytes_processed_;
+    size_t items_processed_;
+};
+
+using BenchFunction = void (*)(State&);
+
+struct Registration {
+    Registration(
+            const char* suite,
+            const char* name,
+            BenchFunction function,
+            std::vector<long> args = {});
+};
+
+int run_all(int argc, char* argv[]);
+
+// Keeps the compiler from discarding a computed value as dead code.
+template <typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+} // namespace bench
+
+#define BENCH_REGISTER(suite, name, args)                                     \
+    static void bench_##suite##_##name(bench::State& state);                   \
+    static const bench::Registration bench_registration_##suite##_##name(      \
+            #suite, #name, bench_##suite##_##name, args);                      \
+    static void bench_##suite##_##name(bench::State& state)
+
+// BENCH_ARGS runs the benchmark once per argument, available as state.arg().
+#define BENCH_ARGS(suite, name, ...)                                          \
+    BENCH_REGISTER(suite, name, (std::vector<long>{__VA_ARGS__}))
+
+#define BENCH(suite, name) BENCH_REGISTER(suite, name, std::vector<long>{})
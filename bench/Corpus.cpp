@@ -0,0 +1,176 @@
+#include "Corpus.hpp"
+
+#include <array>
+#include <random>
+#include <string_view>
+
+namespace {
+constexpr std::array<std::string_view, 8> Names{
+        "users",
+        "orders",
+        "name",
+        "age",
+        "meters",
+        "price",
+        "city",
+        "created"};
+
+class CorpusWriter {
+public:
+    explicit CorpusWriter(unsigned seed) : random_{seed}
+    {
+    }
+
+    void statement(std::string& out, bool broken)
+    {
+        std::string statement;
+        switch (pick(8)) {
+        case 0:
+            create(statement);
+            break;
+        case 1:
+        case 2:
+        case 3:
+            insert(statement);
+            break;
+        case 4:
+        case 5:
+            select(statement);
+            break;
+        case 6:
+            remove(statement);
+            break;
+        default:
+            statement += "DROP TABLE ";
+            statement += name();
+            statement += ";";
+        }
+        if (broken) {
+            // Drop a character from the middle of the statement, which turns
+            // it into a misspelt keyword, a broken list or a missing token.
+            statement.erase(statement.length() / 2, 1);
+        }
+        out += statement;
+        out += pick(4) == 0 ? "\n\n    " : "\n";
+    }
+
+private:
+    std::mt19937 random_;
+
+    size_t pick(size_t bound)
+    {
+        return std::uniform_int_distribution<size_t>(0, bound - 1)(random_);
+    }
+
+    std::string_view name()
+    {
+        return Names[pick(Names.size())];
+    }
+
+    void value(std::string& out)
+    {
+        switch (pick(3)) {
+        case 0:
+            out += std::to_string(pick(100000));
+            break;
+        case 1:
+            out += std::to_string(pick(1000));
+            out += ".";
+            out += std::to_string(pick(100));
+            break;
+        default:
+            out += "\"";
+            out += name();
+            out += " ";
+            out += name();
+            out += "\"";
+        }
+    }
+
+    void expression(std::string& out)
+    {
+        constexpr std::array<std::string_view, 6> Operations{
+                ">=", "<=", "!=", "=", "<", ">"};
+        out += " WHERE ";
+        out += name();
+        out += " ";
+        out += Operations[pick(Operations.size())];
+        out += " ";
+        value(out);
+    }
+
+    void create(std::string& out)
+    {
+        constexpr std::array<std::string_view, 3> Types{"INT", "REAL", "TEXT"};
+        out += "CREATE TABLE ";
+        out += name();
+        out += " (";
+        size_t columns = 1 + pick(5);
+        for (size_t i = 0; i < columns; i++) {
+            out += i == 0 ? "" : ", ";
+            out += name();
+            out += " ";
+            out += Types[pick(Types.size())];
+        }
+        out += ");";
+    }
+
+    void insert(std::string& out)
+    {
+        size_t columns = 1 + pick(5);
+        out += "INSERT INTO ";
+        out += name();
+        out += " (";
+        for (size_t i = 0; i < columns; i++) {
+            out += i == 0 ? "" : ", ";
+            out += name();
+        }
+        out += ") VALUES (";
+        for (size_t i = 0; i < columns; i++) {
+            out += i == 0 ? "" : ", ";
+            value(out);
+        }
+        out += ");";
+    }
+
+    void select(std::string& out)
+    {
+        out += "SELECT";
+        size_t columns = 1 + pick(4);
+        for (size_t i = 0; i < columns; i++) {
+            out += " ";
+            out += name();
+        }
+        out += " FROM ";
+        out += name();
+        if (pick(2) == 0) {
+            expression(out);
+        }
+        out += ";";
+    }
+
+    void remove(std::string& out)
+    {
+        out += "DELETE FROM ";
+        out += name();
+        if (pick(2) == 0) {
+            expression(out);
+        }
+        out += ";";
+    }
+};
+} // namespace
+
+std::string
+bench::make_sql_corpus(size_t bytes, double error_rate, unsigned seed)
+{
+    CorpusWriter writer(seed);
+    std::mt19937 random(seed ^ 0x5eedU);
+    std::bernoulli_distribution broken(error_rate);
+    std::string corpus;
+    corpus.reserve(bytes + 256);
+    while (corpus.length() < bytes) {
+        writer.statement(corpus, broken(random));
+    }
+    return corpus;
+}
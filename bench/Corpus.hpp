@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace bench {
+// Generates a deterministic SQL script of roughly `bytes` bytes mixing every
+// statement kind the parser accepts. A share of `error_rate` statements is
+// made syntactically invalid.
+std::string
+make_sql_corpus(size_t bytes, double error_rate = 0.0, unsigned seed = 42);
+} // namespace bench
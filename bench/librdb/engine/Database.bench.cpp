@@ -0,0 +1,202 @@
+#include "Bench.hpp"
+#include "librdb/engine/Database.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/PreparedStatement.hpp"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using rdb::engine::Database;
+
+namespace {
+constexpr size_t ScanRows = 1 << 20;
+
+// INSERTs of rows_per_statement rows each, rows in all, into
+// users (id INT, name TEXT, score REAL).
+std::string make_inserts(size_t rows, size_t rows_per_statement)
+{
+    std::string sql;
+    for (size_t row = 0; row < rows; row++) {
+        sql += (row % rows_per_statement == 0)
+                ? "INSERT INTO users (id, name, score) VALUES "
+                : ", ";
+        sql += "(" + std::to_string(row) + ", \"user" + std::to_string(row)
+                + "\", " + std::to_string(row % 100) + ".5)";
+        if ((row + 1) % rows_per_statement == 0) {
+            sql += ";\n";
+        }
+    }
+    return sql;
+}
+
+constexpr std::string_view CreateUsers
+        = "CREATE TABLE users (id INT, name TEXT, score REAL);";
+} // namespace
+
+// Rows executed per second from already parsed INSERTs, the argument being
+// the rows per statement.
+BENCH_ARGS(Engine, InsertRate, 1, 100, 10000)
+{
+    constexpr size_t Rows = 100000;
+    const std::string sql
+            = make_inserts(Rows, static_cast<size_t>(state.arg()));
+    auto parsed = rdb::parser::parse_sql_view(sql);
+    auto create = rdb::parser::parse_sql_view(CreateUsers);
+    while (state.keep_running()) {
+        Database database;
+        database.execute(create.sql_script);
+        bench::do_not_optimize(database.execute(parsed.sql_script).size());
+    }
+    state.set_items_processed(Rows * state.iterations());
+}
+
+// A WHERE scan over 1Mi rows, selecting about one in ten: on the INT column
+// (0), the REAL one (1), the TEXT one (2), or comparing two columns (3).
+BENCH_ARGS(Engine, ScanRate, 0, 1, 2, 3)
+{
+    static const std::string where[] = {
+            "SELECT id FROM users WHERE id < 104857;",
+            "SELECT id FROM users WHERE score >= 90.0;",
+            "SELECT id FROM users WHERE name < \"user104\";",
+            "SELECT id FROM users WHERE score > id;"};
+    static Database database = [] {
+        Database loaded;
+        loaded.execute(rdb::parser::parse_sql_view(CreateUsers).sql_script);
+        std::string sql = make_inserts(ScanRows, 4096);
+        loaded.execute(rdb::parser::parse_sql_view(sql).sql_script);
+        return loaded;
+    }();
+    auto parsed = rdb::parser::parse_sql_view(where[state.arg()]);
+    const auto& select = parsed.sql_script.sql_statements[0];
+    size_t selected = 0;
+    while (state.keep_running()) {
+        selected += database.execute(select)->rows.rows();
+    }
+    bench::do_not_optimize(selected);
+    state.set_items_processed(ScanRows * state.iterations());
+    state.counters["selected"] = static_cast<double>(selected)
+            / static_cast<double>(state.iterations());
+}
+
+namespace {
+// SELECTs of one id from users holding rows rows, through no index, a hash
+// index or an ordered one on id.
+void point_lookup(bench::State& state, std::string_view index)
+{
+    const size_t rows = static_cast<size_t>(state.arg());
+    Database database;
+    database.execute(rdb::parser::parse_sql_view(CreateUsers).sql_script);
+    database.execute(
+            rdb::parser::parse_sql_view(make_inserts(rows, 4096)).sql_script);
+    database.execute(rdb::parser::parse_sql_view(index).sql_script);
+    auto prepared
+            = rdb::parser::prepare("SELECT name FROM users WHERE id = ?;");
+    rdb::parser::Arena arena;
+    std::vector<rdb::parser::ValueView> parameters(1);
+    size_t id = 0;
+    size_t selected = 0;
+    while (state.keep_running()) {
+        parameters[0] = static_cast<long>(id);
+        selected += database.execute(prepared->bind(parameters, arena))
+                            ->rows.rows();
+        id = (id + 7919) % rows;
+        if ((id & 1023) == 0) {
+            arena.release();
+        }
+    }
+    bench::do_not_optimize(selected);
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+// Point SELECTs per second against the table size.
+BENCH_ARGS(Engine, PointLookupScan, 1000, 100000, 1000000)
+{
+    point_lookup(state, "");
+}
+
+BENCH_ARGS(Engine, PointLookupHash, 1000, 100000, 1000000)
+{
+    point_lookup(state, "CREATE HASH INDEX byid ON users (id);");
+}
+
+BENCH_ARGS(Engine, PointLookupOrdered, 1000, 100000, 1000000)
+{
+    point_lookup(state, "CREATE INDEX byid ON users (id);");
+}
+
+// Single-row INSERTs committed per second to a logged database, the argument
+// being the number of threads committing at once. The log is kept in the
+// working directory, to be on local disk rather than in memory.
+BENCH_ARGS(Engine, LoggedCommitRate, 1, 2, 4, 8, 16)
+{
+    constexpr size_t CommitsPerThread = 32;
+    const std::string path = "Engine.LoggedCommitRate.log";
+    std::remove(path.c_str());
+    const auto threads = static_cast<size_t>(state.arg());
+    size_t flushes = 0;
+    {
+        Database database(path);
+        database.execute(rdb::parser::parse_sql_view(CreateUsers).sql_script);
+        flushes = database.log()->flushes();
+        auto parsed = rdb::parser::parse_sql_view(
+                "INSERT INTO users (id, name, score) "
+                "VALUES (1, \"user\", 0.5);");
+        const auto& insert = parsed.sql_script.sql_statements[0];
+        while (state.keep_running()) {
+            std::vector<std::thread> writers;
+            for (size_t thread = 0; thread < threads; thread++) {
+                writers.emplace_back([&database, &insert] {
+                    for (size_t commit = 0; commit < CommitsPerThread;
+                         commit++) {
+                        bench::do_not_optimize(
+                                database.execute(insert)->affected);
+                    }
+                });
+            }
+            for (auto& writer : writers) {
+                writer.join();
+            }
+        }
+        flushes = database.log()->flushes() - flushes;
+    }
+    std::remove(path.c_str());
+    size_t commits = threads * CommitsPerThread * state.iterations();
+    state.set_items_processed(commits);
+    state.counters["commits/flush"]
+            = static_cast<double>(commits) / static_cast<double>(flushes);
+}
+
+// The INT scan of ScanRate on a paged table of about 3900 pages, the
+// argument being the frames of the buffer pool: a pool of 8192 holds the
+// whole table after the first scan, smaller ones read it back every time.
+// The pages are kept in the working directory.
+BENCH_ARGS(Engine, PagedScanRate, 256, 1024, 8192)
+{
+    const std::string path = "Engine.PagedScanRate.pages";
+    {
+        rdb::Pager pager(path);
+        rdb::BufferPool pool(pager, static_cast<size_t>(state.arg()));
+        Database database(pool);
+        database.execute(rdb::parser::parse_sql_view(CreateUsers).sql_script);
+        std::string sql = make_inserts(ScanRows, 4096);
+        database.execute(rdb::parser::parse_sql_view(sql).sql_script);
+        auto parsed = rdb::parser::parse_sql_view(
+                "SELECT id FROM users WHERE id < 104857;");
+        const auto& select = parsed.sql_script.sql_statements[0];
+        pool.reset_stats();
+        size_t selected = 0;
+        while (state.keep_running()) {
+            selected += database.execute(select)->rows.rows();
+        }
+        bench::do_not_optimize(selected);
+        state.set_items_processed(ScanRows * state.iterations());
+        state.counters["pages"] = static_cast<double>(
+                database.paged_table("users")->pages());
+        state.counters["hit_ratio"] = pool.stats().hit_ratio();
+    }
+    std::remove(path.c_str());
+}
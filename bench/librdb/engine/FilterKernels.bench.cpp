@@ -0,0 +1,57 @@
+#include "Bench.hpp"
+#include "librdb/Simd.hpp"
+#include "librdb/engine/FilterKernels.hpp"
+#include "librdb/engine/Selection.hpp"
+#include <random>
+#include <vector>
+
+using rdb::SimdLevel;
+using rdb::engine::Selection;
+using rdb::parser::CompareOp;
+
+namespace {
+constexpr size_t Rows = 1 << 20;
+
+// Filters a column of Rows random values with the level given as the
+// benchmark argument (0 = scalar, 1 = SSE2, 2 = AVX2), selecting about a
+// tenth of them.
+template <typename T>
+void filter_column(bench::State& state, T constant)
+{
+    static const std::vector<T> values = [] {
+        std::mt19937 random(3);
+        std::vector<T> values;
+        for (size_t row = 0; row < Rows; row++) {
+            values.push_back(static_cast<T>(random() % 1000));
+        }
+        return values;
+    }();
+
+    rdb::set_simd_level(static_cast<SimdLevel>(state.arg()));
+    if (rdb::simd_level() != static_cast<SimdLevel>(state.arg())) {
+        state.counters["unsupported"] = 1;
+    }
+    Selection selection(Rows);
+    size_t selected = 0;
+    while (state.keep_running()) {
+        rdb::engine::filter_constant(
+                CompareOp::Less, values.data(), constant, selection);
+        selected += selection.words()[0];
+    }
+    bench::do_not_optimize(selected);
+    rdb::set_simd_level(rdb::detected_simd_level());
+
+    state.set_items_processed(Rows * state.iterations());
+    state.counters["selected"] = static_cast<double>(selection.count());
+}
+} // namespace
+
+BENCH_ARGS(FilterKernels, IntColumn, 0, 1, 2)
+{
+    filter_column(state, 100L);
+}
+
+BENCH_ARGS(FilterKernels, RealColumn, 0, 1, 2)
+{
+    filter_column(state, 100.0);
+}
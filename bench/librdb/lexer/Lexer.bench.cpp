@@ -0,0 +1,51 @@
+#include "Bench.hpp"
+#include "Corpus.hpp"
+#include "librdb/lexer/Fingerprint.hpp"
+#include "librdb/lexer/Lexer.hpp"
+#include "librdb/lexer/RegexLexer.hpp"
+
+using rdb::parser::Lexer;
+using rdb::parser::RegexLexer;
+using rdb::parser::TokenType;
+
+namespace {
+template <typename LexerType>
+void lex_corpus(bench::State& state, const std::string& corpus)
+{
+    size_t tokens = 0;
+    while (state.keep_running()) {
+        LexerType lexer(corpus);
+        while (lexer.get().type != TokenType::EndOfFile) {
+            tokens++;
+        }
+    }
+    bench::do_not_optimize(tokens);
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(tokens);
+}
+} // namespace
+
+BENCH(Lexer, DfaThroughput)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    lex_corpus<Lexer>(state, corpus);
+}
+
+// The regex lexer is two orders of magnitude slower, so it gets a smaller
+// script to keep the run short; the MiB/s figures stay comparable.
+BENCH(Lexer, RegexThroughput)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 14);
+    lex_corpus<RegexLexer>(state, corpus);
+}
+
+BENCH(Lexer, Fingerprint)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    rdb::parser::Fingerprint result;
+    while (state.keep_running()) {
+        rdb::parser::fingerprint(corpus, result);
+        bench::do_not_optimize(result.digest);
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+}
@@ -0,0 +1,53 @@
+#include "Bench.hpp"
+#include "librdb/Simd.hpp"
+#include "librdb/lexer/ScanKernels.hpp"
+
+#include <string>
+
+using rdb::SimdLevel;
+
+namespace {
+using Kernel = const char* (*)(const char*, const char*);
+
+// Scans a 64 KiB run of `fill` with the level given as the benchmark argument
+// (0 = scalar, 1 = SSE2, 2 = AVX2) and reports the cost per byte.
+void scan_run(bench::State& state, Kernel kernel, char fill)
+{
+    static const size_t RunLength = 64 * 1024;
+    std::string run(RunLength, fill);
+    run += '\x01';
+
+    rdb::set_simd_level(static_cast<SimdLevel>(state.arg()));
+    if (rdb::simd_level() != static_cast<SimdLevel>(state.arg())) {
+        state.counters["unsupported"] = 1;
+    }
+    while (state.keep_running()) {
+        bench::do_not_optimize(kernel(run.data(), run.data() + run.length()));
+    }
+    rdb::set_simd_level(rdb::detected_simd_level());
+
+    state.set_bytes_processed(RunLength * state.iterations());
+    state.counters["ns/byte"] = state.elapsed_seconds() * 1e9
+            / static_cast<double>(RunLength * state.iterations());
+}
+} // namespace
+
+BENCH_ARGS(ScanKernels, Whitespace, 0, 1, 2)
+{
+    scan_run(state, rdb::parser::skip_whitespace, ' ');
+}
+
+BENCH_ARGS(ScanKernels, Identifier, 0, 1, 2)
+{
+    scan_run(state, rdb::parser::skip_alnum, 'q');
+}
+
+BENCH_ARGS(ScanKernels, Digits, 0, 1, 2)
+{
+    scan_run(state, rdb::parser::skip_digits, '7');
+}
+
+BENCH_ARGS(ScanKernels, Text, 0, 1, 2)
+{
+    scan_run(state, rdb::parser::skip_text, 'x');
+}
@@ -0,0 +1,67 @@
+#include "Bench.hpp"
+#include "librdb/parser/Literals.hpp"
+
+#include <charconv>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+// Lexemes the way INSERT traffic has them: mostly short ids and counts,
+// some negative, and prices with two decimals.
+std::vector<std::string> make_lexemes(bool reals)
+{
+    std::mt19937 random(42);
+    std::vector<std::string> lexemes;
+    for (int i = 0; i < 4096; i++) {
+        long number = static_cast<long>(random() % 1000000) - 1000;
+        lexemes.push_back(std::to_string(number));
+        if (reals) {
+            lexemes.back() += "." + std::to_string(10 + random() % 90);
+        }
+    }
+    return lexemes;
+}
+
+// Argument 0 decodes with std::from_chars, 1 with rdb::parser::decode_*.
+template <typename T>
+void decode_lexemes(
+        bench::State& state, const std::vector<std::string>& lexemes)
+{
+    T sum{};
+    size_t bytes = 0;
+    for (auto&& lexeme : lexemes) {
+        bytes += lexeme.size();
+    }
+    while (state.keep_running()) {
+        for (auto&& lexeme : lexemes) {
+            T value{};
+            if (state.arg() == 0) {
+                std::from_chars(
+                        lexeme.data(), lexeme.data() + lexeme.size(), value);
+            } else if constexpr (std::is_same_v<T, long>) {
+                rdb::parser::decode_int(lexeme, value);
+            } else {
+                rdb::parser::decode_real(lexeme, value);
+            }
+            sum += value;
+        }
+    }
+    bench::do_not_optimize(sum);
+    state.set_bytes_processed(bytes * state.iterations());
+    state.set_items_processed(lexemes.size() * state.iterations());
+}
+} // namespace
+
+BENCH_ARGS(Literals, DecodeInt, 0, 1)
+{
+    static const std::vector<std::string> lexemes = make_lexemes(false);
+    decode_lexemes<long>(state, lexemes);
+}
+
+BENCH_ARGS(Literals, DecodeReal, 0, 1)
+{
+    static const std::vector<std::string> lexemes = make_lexemes(true);
+    decode_lexemes<double>(state, lexemes);
+}
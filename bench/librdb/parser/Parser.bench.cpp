@@ -0,0 +1,316 @@
+#include "Allocations.hpp"
+#include "Bench.hpp"
+#include "Corpus.hpp"
+#include "librdb/parser/ParallelParser.hpp"
+#include "librdb/parser/ParseCache.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/PreparedStatement.hpp"
+#include "librdb/parser/StreamParser.hpp"
+#include <string>
+#include <variant>
+#include <vector>
+
+BENCH(Parser, ParseSql)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    size_t statements = 0;
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql(corpus));
+        statements += sql.sql_script.sql_statements.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements);
+}
+
+// The argument is the percentage of statements made invalid, so the cost of
+// reporting an error and resuming after it shows against a clean script.
+BENCH_ARGS(Parser, ErrorRate, 0, 10, 50, 90)
+{
+    const std::string corpus = bench::make_sql_corpus(
+            1 << 20, static_cast<double>(state.arg()) / 100.0);
+    size_t statements = 0;
+    size_t errors = 0;
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql(corpus));
+        statements += sql.sql_script.sql_statements.size();
+        errors += sql.errors.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements + errors);
+    state.counters["errors"] = static_cast<double>(errors)
+            / static_cast<double>(state.iterations());
+}
+
+// Statements that fail on their first token, so nearly all of the script is
+// skipped while resuming at the next semicolon.
+BENCH(Parser, Resync)
+{
+    static const std::string corpus = [] {
+        std::string statement = "INSRT INTO t (a, b) VALUES (";
+        for (int i = 0; i < 100; i++) {
+            statement += "12345, \"text; with a semicolon\", 0.5, ";
+        }
+        statement += "1);\n";
+        std::string script;
+        while (script.size() < (1 << 20)) {
+            script += statement;
+        }
+        return script;
+    }();
+    size_t errors = 0;
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql(corpus));
+        errors += sql.errors.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(errors);
+}
+
+// The argument is the number of threads; the pool is built once so that only
+// splitting, parsing and merging are timed.
+BENCH_ARGS(Parser, ParseParallel, 1, 2, 4, 8)
+{
+    static const std::string corpus = bench::make_sql_corpus(16 << 20);
+    rdb::WorkStealingPool pool(static_cast<unsigned>(state.arg()));
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql_parallel(corpus, pool));
+        bench::do_not_optimize(sql.sql_script.sql_statements.size());
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+}
+
+// A few hundred short scripts sent over and over, parsed from scratch with
+// the argument 0 and through a ParseCache that holds them all with 1.
+BENCH_ARGS(Parser, RepeatedScripts, 0, 1)
+{
+    static const std::vector<std::string> scripts = [] {
+        std::vector<std::string> scripts;
+        for (unsigned seed = 0; seed < 300; seed++) {
+            scripts.push_back(bench::make_sql_corpus(200, 0.0, seed));
+        }
+        return scripts;
+    }();
+    rdb::parser::ParseCache cache(64 << 20);
+    size_t bytes = 0;
+    size_t script = 0;
+    while (state.keep_running()) {
+        const std::string& text = scripts[script++ % scripts.size()];
+        if (state.arg() == 0) {
+            auto sql(rdb::parser::parse_sql(text));
+            bench::do_not_optimize(sql.sql_script.sql_statements.size());
+        } else {
+            auto sql(cache.parse(text));
+            bench::do_not_optimize(sql->sql_script.sql_statements.size());
+        }
+        bytes += text.size();
+    }
+    state.set_bytes_processed(bytes);
+    state.set_items_processed(state.iterations());
+}
+
+// One INSERT with new values each time: parsed from its text with the
+// argument 0, bound to a statement prepared once with 1.
+BENCH_ARGS(Parser, InsertRate, 0, 1)
+{
+    static const auto prepared = rdb::parser::prepare(
+            "INSERT INTO users (id, name, score) VALUES (?, ?, ?);");
+    rdb::parser::Arena arena;
+    std::vector<rdb::parser::ValueView> parameters(3);
+    std::string sql;
+    long id = 0;
+    while (state.keep_running()) {
+        id++;
+        if (state.arg() == 0) {
+            sql = "INSERT INTO users (id, name, score) VALUES ("
+                    + std::to_string(id) + ", \"user\", 0.5);";
+            auto parsed(rdb::parser::parse_sql(sql));
+            bench::do_not_optimize(parsed.sql_script.sql_statements.size());
+        } else {
+            parameters[0] = id;
+            parameters[1] = std::string_view("\"user\"");
+            parameters[2] = 0.5;
+            auto bound = prepared->bind(parameters, arena);
+            bench::do_not_optimize(bound.index());
+            // Released every so often, as a caller running each statement
+            // would.
+            if ((id & 1023) == 0) {
+                arena.release();
+            }
+        }
+    }
+    state.set_items_processed(state.iterations());
+}
+
+// The same rows loaded as one INSERT each with the argument 1, and as
+// INSERTs of that many rows otherwise.
+BENCH_ARGS(Parser, BulkInsert, 1, 100, 10000)
+{
+    const size_t rows_per_statement = static_cast<size_t>(state.arg());
+    constexpr size_t Rows = 100000;
+    std::string sql;
+    for (size_t row = 0; row < Rows; row++) {
+        sql += (row % rows_per_statement == 0)
+                ? "INSERT INTO users (id, name, score) VALUES "
+                : ", ";
+        sql += "(" + std::to_string(row) + ", \"user" + std::to_string(row)
+                + "\", " + std::to_string(row % 100) + ".5)";
+        if ((row + 1) % rows_per_statement == 0) {
+            sql += ";\n";
+        }
+    }
+    while (state.keep_running()) {
+        auto parsed(rdb::parser::parse_sql(sql));
+        bench::do_not_optimize(parsed.sql_script.sql_statements.size());
+    }
+    state.set_bytes_processed(sql.size() * state.iterations());
+    state.set_items_processed(Rows * state.iterations());
+}
+
+// Single-row inserts of numbers only: a timestamp-sized id, a count, a
+// price and a ratio, so most of the time goes to decoding literals.
+BENCH(Parser, NumericInserts)
+{
+    constexpr size_t Rows = 100000;
+    std::string sql;
+    for (size_t row = 0; row < Rows; row++) {
+        sql += "INSERT INTO orders (id, quantity, price, discount) VALUES ("
+                + std::to_string(1700000000000 + row * 7919) + ", "
+                + std::to_string(row % 50) + ", "
+                + std::to_string(row % 1000) + "."
+                + std::to_string(row % 90 + 10)
+                + ", -0." + std::to_string(row % 997) + ");\n";
+    }
+    while (state.keep_running()) {
+        auto parsed(rdb::parser::parse_sql_view(sql));
+        bench::do_not_optimize(parsed.sql_script.sql_statements.size());
+    }
+    state.set_bytes_processed(sql.size() * state.iterations());
+    state.set_items_processed(Rows * state.iterations());
+}
+
+BENCH(Parser, ParseSqlView)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    size_t statements = 0;
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql_view(corpus));
+        statements += sql.sql_script.sql_statements.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements);
+}
+
+namespace {
+// Columns a statement names, computed per alternative.
+struct ColumnCount {
+    size_t operator()(const rdb::parser::CreateTableStatement& s) const
+    {
+        return s.columns_defined();
+    }
+    size_t operator()(const rdb::parser::InsertStatement& s) const
+    {
+        return s.columns_defined();
+    }
+    size_t operator()(const rdb::parser::SelectStatement& s) const
+    {
+        return s.columns_defined();
+    }
+    size_t operator()(const rdb::parser::DeleteFromStatement&) const
+    {
+        return 0;
+    }
+    size_t operator()(const rdb::parser::DropTableStatement&) const
+    {
+        return 0;
+    }
+    size_t operator()(const rdb::parser::CreateIndexStatement&) const
+    {
+        return 1;
+    }
+};
+} // namespace
+
+// Dispatch over an already parsed script, as an executor would do it.
+BENCH(Parser, VisitStatements)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    static const auto sql = rdb::parser::parse_sql(corpus);
+    size_t statements = 0;
+    size_t columns = 0;
+    while (state.keep_running()) {
+        for (auto&& statement : sql.sql_script.sql_statements) {
+            columns += std::visit(ColumnCount{}, statement);
+        }
+        statements += sql.sql_script.sql_statements.size();
+    }
+    state.set_items_processed(statements);
+    state.counters["columns/statement"] = static_cast<double>(columns)
+            / static_cast<double>(statements);
+}
+
+// Heap allocations per parsed statement, counted over a whole parse_sql()
+// including the release of its result.
+BENCH(Parser, Allocations)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    size_t statements = 0;
+    size_t allocations = 0;
+    while (state.keep_running()) {
+        size_t before = bench::allocation_count();
+        {
+            auto sql(rdb::parser::parse_sql(corpus));
+            statements += sql.sql_script.sql_statements.size();
+        }
+        allocations += bench::allocation_count() - before;
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements);
+    state.counters["allocs/statement"] = static_cast<double>(allocations)
+            / static_cast<double>(statements);
+}
+
+BENCH(Parser, TokenizeAll)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    size_t tokens = 0;
+    while (state.keep_running()) {
+        auto stream(rdb::parser::tokenize_all(corpus));
+        tokens += stream.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(tokens);
+}
+
+BENCH(Parser, ParseTokenStream)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    static const auto stream = rdb::parser::tokenize_all(corpus);
+    size_t statements = 0;
+    while (state.keep_running()) {
+        auto sql(rdb::parser::parse_sql(stream));
+        statements += sql.sql_script.sql_statements.size();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements);
+}
+
+BENCH(Parser, ParseStream)
+{
+    static const std::string corpus = bench::make_sql_corpus(1 << 20);
+    size_t statements = 0;
+    while (state.keep_running()) {
+        rdb::parser::StreamParser parser(
+                [&statements](const rdb::parser::SqlStatement&) {
+                    statements++;
+                },
+                [](const rdb::parser::Error&) {});
+        std::string_view input(corpus);
+        for (size_t pos = 0; pos < input.size();
+             pos += rdb::parser::StreamChunkSize) {
+            parser.feed(input.substr(pos, rdb::parser::StreamChunkSize));
+        }
+        parser.finish();
+    }
+    state.set_bytes_processed(corpus.size() * state.iterations());
+    state.set_items_processed(statements);
+}
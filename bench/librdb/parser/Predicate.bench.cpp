@@ -0,0 +1,82 @@
+#include "Bench.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/Predicate.hpp"
+
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+using rdb::parser::CompareOp;
+using rdb::parser::ExpressionView;
+using rdb::parser::ValueView;
+
+namespace {
+// What testing a row costs without compiling: the operator and the constant
+// are decoded anew for each value.
+bool interpret(const ExpressionView& expression, long value)
+{
+    return std::visit(
+            [&expression, value](auto&& constant) {
+                using Constant = std::decay_t<decltype(constant)>;
+                if constexpr (std::is_arithmetic_v<Constant>) {
+                    switch (expression.operation) {
+                    case CompareOp::Equal:
+                        return value == constant;
+                    case CompareOp::NotEqual:
+                        return value != constant;
+                    case CompareOp::Less:
+                        return value < constant;
+                    case CompareOp::LessEqual:
+                        return value <= constant;
+                    case CompareOp::Greater:
+                        return value > constant;
+                    case CompareOp::GreaterEqual:
+                        return value >= constant;
+                    }
+                }
+                return false;
+            },
+            expression.roperand.val);
+}
+} // namespace
+
+// Counts the rows of a 64Ki-value INT column matching WHERE age >= 40, the
+// argument choosing interpretation (0) or the compiled predicate (1).
+BENCH_ARGS(Predicate, FilterColumn, 0, 1)
+{
+    static const std::string sql = "SELECT id FROM users WHERE age >= 40;";
+    auto parsed = rdb::parser::parse_sql_view(sql);
+    const auto& expression = std::get<rdb::parser::SelectStatementView>(
+                                     parsed.sql_script.sql_statements[0])
+                                     .expression();
+    std::vector<long> ages(1 << 16);
+    for (size_t row = 0; row < ages.size(); row++) {
+        ages[row] = static_cast<long>((row * 7919) % 100);
+    }
+
+    size_t matches = 0;
+    while (state.keep_running()) {
+        if (state.arg() == 0) {
+            for (long age : ages) {
+                matches += interpret(expression, age);
+            }
+            continue;
+        }
+        std::visit(
+                [&ages, &matches](auto&& predicate) {
+                    using Predicate = std::decay_t<decltype(predicate)>;
+                    if constexpr (std::is_invocable_r_v<
+                                          bool,
+                                          Predicate,
+                                          const long&>) {
+                        for (long age : ages) {
+                            matches += predicate(age);
+                        }
+                    }
+                },
+                rdb::parser::compile_predicate(expression));
+    }
+    bench::do_not_optimize(matches);
+    state.set_items_processed(ages.size() * state.iterations());
+}
@@ -0,0 +1,6 @@
+#include "Bench.hpp"
+
+int main(int argc, char* argv[])
+{
+    return bench::run_all(argc, argv);
+}
@@ -0,0 +1,202 @@
+#include "BufferPool.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+using rdb::BufferPool;
+using rdb::PageId;
+using rdb::PinnedPage;
+
+PinnedPage::PinnedPage(BufferPool& pool, size_t frame)
+    : pool{&pool}, frame{frame}
+{
+    pool.frame_states[frame].pins++;
+}
+
+PinnedPage::PinnedPage(PinnedPage&& other) noexcept
+    : pool{std::exchange(other.pool, nullptr)}, frame{other.frame}
+{
+}
+
+PinnedPage& PinnedPage::operator=(PinnedPage&& other) noexcept
+{
+    if (this != &other) {
+        if (pool != nullptr) {
+            pool->frame_states[frame].pins--;
+        }
+        pool = std::exchange(other.pool, nullptr);
+        frame = other.frame;
+    }
+    return *this;
+}
+
+PinnedPage::~PinnedPage()
+{
+    if (pool != nullptr) {
+        pool->frame_states[frame].pins--;
+    }
+}
+
+PageId PinnedPage::id() const
+{
+    return pool->frame_states[frame].page;
+}
+
+char* PinnedPage::data() const
+{
+    return pool->data(frame);
+}
+
+void PinnedPage::mark_dirty()
+{
+    pool->frame_states[frame].dirty = true;
+}
+
+double BufferPool::Stats::hit_ratio() const
+{
+    size_t pins = hits + misses;
+    return (pins == 0) ? 1.0
+                       : static_cast<double>(hits) / static_cast<double>(pins);
+}
+
+BufferPool::BufferPool(Pager& pager, size_t frames)
+    : pager{pager},
+      frame_states(frames),
+      memory{new char[frames * Pager::PageSize]}
+{
+    if (frames == 0) {
+        throw std::invalid_argument("a buffer pool needs a frame");
+    }
+    frame_of.reserve(frames);
+}
+
+BufferPool::~BufferPool()
+{
+    try {
+        flush();
+    } catch (...) {
+        // The pages are scratch space; losing them on the way out is no
+        // worse than the failure itself.
+    }
+}
+
+PinnedPage BufferPool::pin(PageId page)
+{
+    auto found = frame_of.find(page);
+    if (found != frame_of.end()) {
+        counters.hits++;
+        frame_states[found->second].referenced = true;
+        return PinnedPage(*this, found->second);
+    }
+    counters.misses++;
+    size_t frame = take_frame();
+    pager.read(page, data(frame));
+    Frame& state = frame_states[frame];
+    state = Frame{page, true, false, true, 0};
+    frame_of.emplace(page, frame);
+    return PinnedPage(*this, frame);
+}
+
+PinnedPage BufferPool::pin_new()
+{
+    size_t frame = take_frame();
+    PageId page = pager.allocate();
+    std::memset(data(frame), 0, Pager::PageSize);
+    frame_states[frame] = Frame{page, true, true, true, 0};
+    frame_of.emplace(page, frame);
+    return PinnedPage(*this, frame);
+}
+
+void BufferPool::free(PageId page)
+{
+    auto found = frame_of.find(page);
+    if (found != frame_of.end()) {
+        if (frame_states[found->second].pins != 0) {
+            throw std::logic_error("freeing a pinned page");
+        }
+        frame_states[found->second] = Frame();
+        frame_of.erase(found);
+    }
+    pager.free(page);
+}
+
+void BufferPool::prefetch(const PageId* pages, size_t count)
+{
+    for (size_t index = 0; index < count; index++) {
+        if (frame_of.count(pages[index]) == 0) {
+            pager.prefetch(pages[index]);
+            counters.prefetches++;
+        }
+    }
+}
+
+void BufferPool::flush()
+{
+    for (size_t frame = 0; frame < frame_states.size(); frame++) {
+        if (frame_states[frame].used && frame_states[frame].dirty) {
+            write_back(frame_states[frame], frame);
+        }
+    }
+}
+
+size_t BufferPool::frames() const
+{
+    return frame_states.size();
+}
+
+size_t BufferPool::pin_count(PageId page) const
+{
+    auto found = frame_of.find(page);
+    return (found == frame_of.end()) ? 0 : frame_states[found->second].pins;
+}
+
+BufferPool::Stats BufferPool::stats() const
+{
+    return counters;
+}
+
+void BufferPool::reset_stats()
+{
+    counters = Stats();
+}
+
+// Two turns of the hand clear every reference bit, so a frame is found
+// within them unless all are pinned.
+size_t BufferPool::take_frame()
+{
+    for (size_t step = 0; step < 2 * frame_states.size(); step++) {
+        size_t frame = hand;
+        hand = (hand + 1) % frame_states.size();
+        Frame& state = frame_states[frame];
+        if (!state.used) {
+            return frame;
+        }
+        if (state.pins != 0) {
+            continue;
+        }
+        if (state.referenced) {
+            state.referenced = false;
+            continue;
+        }
+        if (state.dirty) {
+            write_back(state, frame);
+        }
+        counters.evictions++;
+        frame_of.erase(state.page);
+        state = Frame();
+        return frame;
+    }
+    throw std::runtime_error("every frame of the buffer pool is pinned");
+}
+
+char* BufferPool::data(size_t frame) const
+{
+    return memory.get() + frame * Pager::PageSize;
+}
+
+void BufferPool::write_back(Frame& frame, size_t index)
+{
+    pager.write(frame.page, data(index));
+    frame.dirty = false;
+    counters.writes++;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Pager.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace rdb {
+class BufferPool;
+
+// A page held in a frame of a BufferPool, which keeps it there until the
+// PinnedPage is gone. Writes to data() must be followed by mark_dirty() for
+// them to reach the pager.
+class PinnedPage {
+public:
+    PinnedPage(PinnedPage&& other) noexcept;
+    PinnedPage& operator=(PinnedPage&& other) noexcept;
+    PinnedPage(const PinnedPage&) = delete;
+    PinnedPage& operator=(const PinnedPage&) = delete;
+    ~PinnedPage();
+
+    PageId id() const;
+    // Pager::PageSize bytes.
+    char* data() const;
+    void mark_dirty();
+
+private:
+    BufferPool* pool = nullptr;
+    size_t frame = 0;
+
+    PinnedPage(BufferPool& pool, size_t frame);
+    friend class BufferPool;
+};
+
+// A fixed number of frames caching pages of a Pager. A page is read in when
+// first pinned, and stays while anyone pins it; when a frame is needed, the
+// clock hand sweeps over the frames, clearing the reference bit of those
+// used since it last passed and taking the first unpinned one whose bit is
+// already clear. Dirty pages are written back as they are evicted and when
+// the pool is flushed or destroyed.
+//
+// Not safe to use from several threads at once.
+class BufferPool {
+public:
+    struct Stats {
+        // Pins of pages found in a frame, and of pages read in.
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t writes = 0;
+        size_t prefetches = 0;
+
+        // hits / (hits + misses), or 1 before the first pin.
+        double hit_ratio() const;
+    };
+
+    // frames must be at least 1; the pager must outlive the pool.
+    BufferPool(Pager& pager, size_t frames);
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    ~BufferPool();
+
+    // Throws std::runtime_error if every frame is pinned, and
+    // std::system_error if the pager fails.
+    PinnedPage pin(PageId page);
+    // A page newly allocated from the pager, zeroed and already dirty.
+    PinnedPage pin_new();
+    // Drops page, which must not be pinned, and frees it in the pager.
+    void free(PageId page);
+    // Has the pager read the pages not in a frame ahead of their pins.
+    void prefetch(const PageId* pages, size_t count);
+    // Writes back every dirty page.
+    void flush();
+
+    size_t frames() const;
+    // How many PinnedPages hold page; 0 if it is not in a frame.
+    size_t pin_count(PageId page) const;
+    Stats stats() const;
+    void reset_stats();
+
+private:
+    struct Frame {
+        PageId page = 0;
+        bool used = false;
+        bool dirty = false;
+        bool referenced = false;
+        size_t pins = 0;
+    };
+
+    Pager& pager;
+    std::vector<Frame> frame_states;
+    std::unique_ptr<char[]> memory;
+    std::unordered_map<PageId, size_t> frame_of;
+    size_t hand = 0;
+    Stats counters;
+
+    // A frame to put a new page in, written back and forgotten if it held
+    // one.
+    size_t take_frame();
+    char* data(size_t frame) const;
+    void write_back(Frame& frame, size_t index);
+
+    friend class PinnedPage;
+};
+} // namespace rdb
@@ -0,0 +1,184 @@
+#include "InputSource.hpp"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#if defined(RDB_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#endif
+
+using rdb::InputSource;
+
+namespace {
+[[noreturn]] void throw_errno(const std::string& name)
+{
+    throw std::system_error(errno, std::generic_category(), name);
+}
+} // namespace
+
+InputSource InputSource::from_text(std::string text)
+{
+    InputSource input;
+    input.buffer = std::move(text);
+    return input;
+}
+
+#if defined(RDB_POSIX)
+InputSource::InputSource(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw_errno(path);
+    }
+    try {
+        load(fd, path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+InputSource InputSource::standard_input()
+{
+    InputSource input;
+    input.load(STDIN_FILENO, "<stdin>");
+    return input;
+}
+
+bool InputSource::standard_input_is_terminal()
+{
+    return ::isatty(STDIN_FILENO) != 0;
+}
+
+void InputSource::load(int fd, const std::string& name)
+{
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        throw_errno(name);
+    }
+    bool regular = S_ISREG(status.st_mode);
+    auto size = static_cast<size_t>(status.st_size);
+
+    if (regular && size != 0) {
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            // Only a hint: failing to set it costs read-ahead, not correctness.
+            ::madvise(address, size, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(address);
+            mapping_size = size;
+            return;
+        }
+    }
+
+    // Pipes and terminals have no size to map; grow the buffer geometrically
+    // and read straight into it.
+    size_t length = 0;
+    buffer.resize(regular ? size : 64 * 1024);
+    while (true) {
+        if (length == buffer.size()) {
+            buffer.resize(buffer.size() * 2 + 1);
+        }
+        ssize_t count = ::read(fd, &buffer[length], buffer.size() - length);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno(name);
+        }
+        if (count == 0) {
+            break;
+        }
+        length += static_cast<size_t>(count);
+    }
+    buffer.resize(length);
+}
+
+void InputSource::unmap()
+{
+    if (mapping != nullptr) {
+        ::munmap(const_cast<char*>(mapping), mapping_size);
+        mapping = nullptr;
+        mapping_size = 0;
+    }
+}
+#else
+InputSource::InputSource(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::system_error(
+                std::make_error_code(std::errc::no_such_file_or_directory),
+                path);
+    }
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(buffer.data(), buffer.size())) {
+        throw std::system_error(
+                std::make_error_code(std::errc::io_error), path);
+    }
+}
+
+InputSource InputSource::standard_input()
+{
+    return from_text(std::string(
+            std::istreambuf_iterator<char>(std::cin),
+            std::istreambuf_iterator<char>()));
+}
+
+bool InputSource::standard_input_is_terminal()
+{
+    return true;
+}
+
+void InputSource::load(int, const std::string&)
+{
+}
+
+void InputSource::unmap()
+{
+}
+#endif
+
+InputSource::InputSource(InputSource&& other) noexcept
+    : buffer{std::move(other.buffer)},
+      mapping{std::exchange(other.mapping, nullptr)},
+      mapping_size{std::exchange(other.mapping_size, 0)}
+{
+}
+
+InputSource& InputSource::operator=(InputSource&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        buffer = std::move(other.buffer);
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+    }
+    return *this;
+}
+
+InputSource::~InputSource()
+{
+    unmap();
+}
+
+std::string_view InputSource::view() const
+{
+    if (mapping != nullptr) {
+        return std::string_view(mapping, mapping_size);
+    }
+    return buffer;
+}
+
+bool InputSource::is_mapped() const
+{
+    return mapping != nullptr;
+}
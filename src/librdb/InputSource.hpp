@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Platform.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace rdb {
+// The text of a script to be parsed. Regular files are mapped read-only and
+// read ahead sequentially, so even multi-gigabyte dumps are neither copied
+// nor held in anonymous memory; pipes, terminals and platforms without mmap
+// fall back to reading into an owned buffer, pre-sized whenever the length is
+// known up front.
+class InputSource {
+public:
+    // Throws std::system_error if the file cannot be opened or read.
+    explicit InputSource(const std::string& path);
+    // Wraps text that is already in memory, e.g. typed at a prompt.
+    static InputSource from_text(std::string text);
+    // Reads standard input to its end, mapping it if it is redirected from a
+    // regular file.
+    static InputSource standard_input();
+    // Whether standard input is a terminal, to be prompted for a line rather
+    // than read to its end. Always true where this cannot be checked.
+    static bool standard_input_is_terminal();
+
+    InputSource(InputSource&& other) noexcept;
+    InputSource& operator=(InputSource&& other) noexcept;
+    InputSource(const InputSource&) = delete;
+    InputSource& operator=(const InputSource&) = delete;
+    ~InputSource();
+
+    // Valid for the lifetime of the InputSource.
+    std::string_view view() const;
+    bool is_mapped() const;
+
+private:
+    InputSource() = default;
+    void load(int fd, const std::string& name);
+    void unmap();
+
+    std::string buffer;
+    const char* mapping = nullptr;
+    size_t mapping_size = 0;
+};
+} // namespace rdb
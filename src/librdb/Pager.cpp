@@ -0,0 +1,146 @@
+#include "Pager.hpp"
+#include <cerrno>
+#include <system_error>
+
+#if defined(RDB_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using rdb::PageId;
+using rdb::Pager;
+
+namespace {
+[[noreturn]] void throw_errno(const std::string& name)
+{
+    throw std::system_error(errno, std::generic_category(), name);
+}
+} // namespace
+
+#if defined(RDB_POSIX)
+Pager::Pager(const std::string& path) : path{path}
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw_errno(path);
+    }
+}
+
+Pager::~Pager()
+{
+    ::close(fd);
+}
+
+void Pager::read(PageId page, char* data) const
+{
+    auto offset = static_cast<off_t>(page) * static_cast<off_t>(PageSize);
+    size_t done = 0;
+    while (done < PageSize) {
+        ssize_t count = ::pread(
+                fd,
+                data + done,
+                PageSize - done,
+                offset + static_cast<off_t>(done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw_errno(path);
+        }
+        if (count == 0) {
+            throw std::system_error(
+                    std::make_error_code(std::errc::io_error), path);
+        }
+        done += static_cast<size_t>(count);
+    }
+}
+
+void Pager::write(PageId page, const char* data)
+{
+    auto offset = static_cast<off_t>(page) * static_cast<off_t>(PageSize);
+    size_t done = 0;
+    while (done < PageSize) {
+        ssize_t count = ::pwrite(
+                fd,
+                data + done,
+                PageSize - done,
+                offset + static_cast<off_t>(done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw_errno(path);
+        }
+        done += static_cast<size_t>(count);
+    }
+}
+
+void Pager::prefetch(PageId page) const
+{
+#if defined(POSIX_FADV_WILLNEED)
+    ::posix_fadvise(
+            fd,
+            static_cast<off_t>(page) * static_cast<off_t>(PageSize),
+            static_cast<off_t>(PageSize),
+            POSIX_FADV_WILLNEED);
+#else
+    static_cast<void>(page);
+#endif
+}
+#else
+Pager::Pager(const std::string& path) : path{path}
+{
+    file = std::fopen(path.c_str(), "w+b");
+    if (file == nullptr) {
+        throw std::system_error(
+                std::make_error_code(std::errc::io_error), path);
+    }
+}
+
+Pager::~Pager()
+{
+    std::fclose(file);
+}
+
+void Pager::read(PageId page, char* data) const
+{
+    if (std::fseek(file, static_cast<long>(page * PageSize), SEEK_SET) != 0
+        || std::fread(data, 1, PageSize, file) != PageSize) {
+        throw std::system_error(
+                std::make_error_code(std::errc::io_error), path);
+    }
+}
+
+void Pager::write(PageId page, const char* data)
+{
+    if (std::fseek(file, static_cast<long>(page * PageSize), SEEK_SET) != 0
+        || std::fwrite(data, 1, PageSize, file) != PageSize) {
+        throw std::system_error(
+                std::make_error_code(std::errc::io_error), path);
+    }
+}
+
+void Pager::prefetch(PageId) const
+{
+}
+#endif
+
+PageId Pager::allocate()
+{
+    if (!free_pages.empty()) {
+        PageId page = free_pages.back();
+        free_pages.pop_back();
+        return page;
+    }
+    return end++;
+}
+
+void Pager::free(PageId page)
+{
+    free_pages.push_back(page);
+}
+
+size_t Pager::pages() const
+{
+    return end;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Platform.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace rdb {
+using PageId = uint32_t;
+
+// A file of fixed-size pages, read and written whole by number. The file is
+// scratch space for data that does not fit in memory: it is emptied when
+// opened, and pages freed are handed out again by later allocations. Throws
+// std::system_error whenever the file cannot be read or written.
+class Pager {
+public:
+    static constexpr size_t PageSize = 8192;
+
+    explicit Pager(const std::string& path);
+    Pager(const Pager&) = delete;
+    Pager& operator=(const Pager&) = delete;
+    ~Pager();
+
+    // A page not in use, its contents undefined until written.
+    PageId allocate();
+    void free(PageId page);
+    void read(PageId page, char* data) const;
+    void write(PageId page, const char* data);
+    // Asks the operating system to start reading page in the background, so
+    // that a read() soon after does not wait for the disk. Only a hint.
+    void prefetch(PageId page) const;
+
+    // Pages in the file, in use or free.
+    size_t pages() const;
+
+private:
+    const std::string path;
+#if defined(RDB_POSIX)
+    int fd = -1;
+#else
+    std::FILE* file = nullptr;
+#endif
+    PageId end = 0;
+    std::vector<PageId> free_pages;
+};
+} // namespace rdb
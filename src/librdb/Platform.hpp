@@ -0,0 +1,14 @@
+#pragma once
+
+// POSIX file descriptors, mmap and friends; elsewhere the library falls back
+// to standard streams.
+#if defined(__unix__) || defined(__APPLE__)
+#define RDB_POSIX 1
+#endif
+
+// Byte order, for the word-at-a-time (SWAR) decoders; others take a scalar
+// path.
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)    \
+        || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define RDB_LITTLE_ENDIAN 1
+#endif
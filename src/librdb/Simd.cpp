@@ -0,0 +1,47 @@
+#include "Simd.hpp"
+
+#include <atomic>
+
+using rdb::SimdLevel;
+
+namespace {
+SimdLevel detect()
+{
+#if defined(RDB_SIMD_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+#endif
+#if defined(RDB_SIMD_SSE2)
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::atomic<SimdLevel>& active_level()
+{
+    static std::atomic<SimdLevel> level{rdb::detected_simd_level()};
+    return level;
+}
+} // namespace
+
+SimdLevel rdb::detected_simd_level()
+{
+    static const SimdLevel level = detect();
+    return level;
+}
+
+SimdLevel rdb::simd_level()
+{
+    return active_level().load(std::memory_order_relaxed);
+}
+
+void rdb::set_simd_level(SimdLevel level)
+{
+    if (level > detected_simd_level()) {
+        level = detected_simd_level();
+    }
+    active_level().store(level, std::memory_order_relaxed);
+}
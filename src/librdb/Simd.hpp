@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)                                      \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RDB_SIMD_SSE2 1
+#endif
+
+// AVX2 kernels are compiled for their own target and only called after the
+// CPU has been checked, so the rest of the library keeps the baseline ISA.
+#if defined(RDB_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define RDB_SIMD_AVX2 1
+#define RDB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace rdb {
+enum class SimdLevel { Scalar, Sse2, Avx2 };
+
+// The widest instruction set both compiled in and supported by this CPU.
+SimdLevel detected_simd_level();
+// The level the dispatched kernels currently use; detected_simd_level() by
+// default.
+SimdLevel simd_level();
+// Lowers (or restores) the active level, e.g. to compare kernels in tests and
+// benchmarks. Levels above detected_simd_level() are clamped.
+void set_simd_level(SimdLevel level);
+
+// Bit helpers for movemask results; mask must be non-zero for the former.
+inline unsigned count_trailing_zeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline unsigned count_trailing_zeros(uint64_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+inline unsigned popcount(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    return __popcnt(mask);
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+inline unsigned popcount(uint64_t mask)
+{
+#if defined(_MSC_VER)
+    return static_cast<unsigned>(__popcnt64(mask));
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+} // namespace rdb
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <string_view>
 
@@ -18,10 +19,14 @@ enum class TokenType {
     KwWhere,
     KwFrom,
     KwInto,
+    KwIndex,
+    KwHash,
+    KwOn,
     VarInt,
     VarReal,
     VarText,
     VarId,
+    Placeholder,
     Operation,
     CurlyBracketOpening,
     CurlyBracketClosing,
@@ -33,15 +38,73 @@ enum class TokenType {
     Unknown
 };
 
+struct TokenTypeInfo {
+    TokenType type;
+    std::string_view name;
+    std::string_view keyword;
+};
+
+// One entry per TokenType, in declaration order. The name is what
+// operator<<(TokenType) prints; a non-empty keyword is the case-insensitive
+// spelling the lexer recognises, so a new keyword is just a new entry here.
+// clang-format off
+constexpr std::array<TokenTypeInfo, 30> TokenTypes{ {
+        {TokenType::KwCreate,            "KwCreate",            "CREATE"},
+        {TokenType::KwSelect,            "KwSelect",            "SELECT"},
+        {TokenType::KwInsert,            "KwInsert",            "INSERT"},
+        {TokenType::KwDelete,            "KwDelete",            "DELETE"},
+        {TokenType::KwDrop,              "KwDrop",              "DROP"},
+        {TokenType::KwValues,            "KwValues",            "VALUES"},
+        {TokenType::KwTable,             "KwTable",             "TABLE"},
+        {TokenType::KwInt,               "KwInt",               "INT"},
+        {TokenType::KwReal,              "KwReal",              "REAL"},
+        {TokenType::KwText,              "KwText",              "TEXT"},
+        {TokenType::KwWhere,             "KwWhere",             "WHERE"},
+        {TokenType::KwFrom,              "KwFrom",              "FROM"},
+        {TokenType::KwInto,              "KwInto",              "INTO"},
+        {TokenType::KwIndex,             "KwIndex",             "INDEX"},
+        {TokenType::KwHash,              "KwHash",              "HASH"},
+        {TokenType::KwOn,                "KwOn",                "ON"},
+        {TokenType::VarInt,              "VarInt",              ""},
+        {TokenType::VarReal,             "VarReal",             ""},
+        {TokenType::VarText,             "VarText",             ""},
+        {TokenType::VarId,               "VarId",               ""},
+        {TokenType::Placeholder,         "Placeholder",         ""},
+        {TokenType::Operation,           "Operation",           ""},
+        {TokenType::CurlyBracketOpening, "CurlyBracketOpening", ""},
+        {TokenType::CurlyBracketClosing, "CurlyBracketClosing", ""},
+        {TokenType::ParenthesisOpening,  "ParenthesisOpening",  ""},
+        {TokenType::ParenthesisClosing,  "ParenthesisClosing",  ""},
+        {TokenType::Comma,               "Comma",               ""},
+        {TokenType::Semicolon,           "Semicolon",           ""},
+        {TokenType::EndOfFile,           "EndOfFile",           ""},
+        {TokenType::Unknown,             "Unknown",             ""}
+} };
+// clang-format on
+
+constexpr bool token_types_in_order()
+{
+    for (size_t index = 0; index < TokenTypes.size(); index++) {
+        if (static_cast<size_t>(TokenTypes[index].type) != index) {
+            return false;
+        }
+    }
+    return TokenTypes.back().type == TokenType::Unknown;
+}
+
+static_assert(
+        token_types_in_order(),
+        "TokenTypes must list every TokenType in declaration order");
+
 struct Token {
     TokenType type;
     std::string_view lexeme;
-    size_t parsed_col;
-    size_t parsed_row;
+    // Byte offset of the lexeme in the lexed source. Rows and columns are only
+    // needed to report errors, so they are resolved from it by a LineIndex.
+    size_t offset;
     Token(TokenType type = TokenType::Unknown,
           std::string_view lexeme = "",
-          size_t parsed_col = 0,
-          size_t parsed_row = 0);
+          size_t offset = 0);
 };
 
 std::ostream& operator<<(std::ostream& os, const rdb::parser::Token& token);
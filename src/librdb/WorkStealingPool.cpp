@@ -0,0 +1,144 @@
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+using rdb::WorkStealingPool;
+
+WorkStealingPool::WorkStealingPool(unsigned threads)
+{
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    ranges = std::make_unique<Range[]>(threads);
+    // The caller of run() is thread 0.
+    workers.reserve(threads - 1);
+    for (unsigned self = 1; self < threads; self++) {
+        workers.emplace_back([this, self] { work_loop(self); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned WorkStealingPool::size() const
+{
+    return static_cast<unsigned>(workers.size() + 1);
+}
+
+void WorkStealingPool::run(
+        size_t count, const std::function<void(size_t)>& batch_task)
+{
+    const size_t threads = size();
+    for (size_t self = 0; self < threads; self++) {
+        std::lock_guard<std::mutex> lock(ranges[self].mutex);
+        ranges[self].begin = count * self / threads;
+        ranges[self].end = count * (self + 1) / threads;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &batch_task;
+        batch++;
+        busy_workers = workers.size();
+    }
+    wake.notify_all();
+
+    work(0);
+
+    std::exception_ptr first_failure;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busy_workers == 0; });
+        task = nullptr;
+        std::swap(first_failure, failure);
+    }
+    if (first_failure) {
+        std::rethrow_exception(first_failure);
+    }
+}
+
+void WorkStealingPool::work_loop(unsigned self)
+{
+    size_t last_batch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, last_batch] {
+                return stopping || batch != last_batch;
+            });
+            if (stopping) {
+                return;
+            }
+            last_batch = batch;
+        }
+
+        work(self);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy_workers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void WorkStealingPool::work(unsigned self)
+{
+    size_t index;
+    while (take(self, index) || steal(self, index)) {
+        try {
+            (*task)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+}
+
+bool WorkStealingPool::take(unsigned self, size_t& index)
+{
+    Range& own = ranges[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.begin == own.end) {
+        return false;
+    }
+    index = own.begin++;
+    return true;
+}
+
+// Ranges only ever shrink during a batch, so once a full pass finds them all
+// empty there is nothing left to steal.
+bool WorkStealingPool::steal(unsigned self, size_t& index)
+{
+    const unsigned threads = size();
+    for (unsigned offset = 1; offset < threads; offset++) {
+        Range& victim = ranges[(self + offset) % threads];
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin == victim.end) {
+                continue;
+            }
+            end = victim.end;
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            victim.end = begin;
+        }
+        // The victim keeps the lower half, or nothing if only one was left.
+        Range& own = ranges[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin + 1;
+        own.end = end;
+        index = begin;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rdb {
+// A fixed set of threads that run batches of indexed tasks. Each batch is
+// dealt out as one contiguous range of indexes per thread; a thread that
+// finishes its range steals the upper half of another's, so uneven tasks
+// still keep every thread busy until the batch is done.
+class WorkStealingPool {
+public:
+    // threads counts the thread calling run() as well; 0 means one per core.
+    explicit WorkStealingPool(unsigned threads = 0);
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool();
+
+    unsigned size() const;
+    // Calls task(index) for every index in [0, count) and returns once all
+    // calls have. If any of them throws, the first exception is rethrown
+    // after the remaining tasks have run. One batch runs at a time, so run()
+    // must neither be called concurrently nor from inside a task.
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    // The indexes [begin, end) still to be run by one thread; padded so that
+    // threads taking from their own range do not share a cache line.
+    struct alignas(64) Range {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::unique_ptr<Range[]> ranges;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* task = nullptr;
+    size_t batch = 0;
+    size_t busy_workers = 0;
+    bool stopping = false;
+    std::exception_ptr failure;
+
+    void work_loop(unsigned self);
+    void work(unsigned self);
+    bool take(unsigned self, size_t& index);
+    bool steal(unsigned self, size_t& index);
+};
+} // namespace rdb
@@ -0,0 +1,227 @@
+#include "WriteAheadLog.hpp"
+#include "InputSource.hpp"
+#include "librdb/lexer/Fingerprint.hpp"
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#if defined(RDB_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+using rdb::WriteAheadLog;
+
+namespace {
+// A record is preceded by its length and the 64-bit FNV-1a hash of its
+// bytes, both in the byte order of the machine that wrote them.
+constexpr size_t HeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+void frame(std::string& out, std::string_view record)
+{
+    auto length = static_cast<uint32_t>(record.size());
+    uint64_t checksum = rdb::parser::fnv1a_64(record);
+    char header[HeaderSize];
+    std::memcpy(header, &length, sizeof(length));
+    std::memcpy(header + sizeof(length), &checksum, sizeof(checksum));
+    out.append(header, HeaderSize);
+    out.append(record);
+}
+
+// Calls replay(record) for each whole record at the start of log and
+// returns how many bytes they take up.
+size_t read_records(
+        std::string_view log,
+        const std::function<void(std::string_view)>& replay,
+        size_t& records)
+{
+    size_t offset = 0;
+    while (log.size() - offset >= HeaderSize) {
+        uint32_t length = 0;
+        uint64_t checksum = 0;
+        std::memcpy(&length, log.data() + offset, sizeof(length));
+        std::memcpy(
+                &checksum,
+                log.data() + offset + sizeof(length),
+                sizeof(checksum));
+        if (log.size() - offset - HeaderSize < length) {
+            break;
+        }
+        std::string_view record = log.substr(offset + HeaderSize, length);
+        if (rdb::parser::fnv1a_64(record) != checksum) {
+            break;
+        }
+        replay(record);
+        records++;
+        offset += HeaderSize + length;
+    }
+    return offset;
+}
+} // namespace
+
+#if defined(RDB_POSIX)
+WriteAheadLog::WriteAheadLog(
+        const std::string& path,
+        const std::function<void(std::string_view)>& replay,
+        std::chrono::microseconds flush_interval)
+    : path{path}, flush_interval{flush_interval}
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+    try {
+        InputSource log(path);
+        size_t end = read_records(log.view(), replay, replayed_records);
+        // What follows the last whole record was torn by a crash, and would
+        // hide the records appended after it.
+        if (end < log.view().size() && ::ftruncate(fd, end) != 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    if (!pending.empty() && !failure) {
+        write_out(pending);
+    }
+    ::close(fd);
+}
+
+std::error_code WriteAheadLog::write_out(const std::string& bytes)
+{
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t count
+                = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return std::error_code(errno, std::generic_category());
+        }
+        written += static_cast<size_t>(count);
+    }
+#if defined(__APPLE__)
+    int synced = ::fsync(fd);
+#else
+    int synced = ::fdatasync(fd);
+#endif
+    if (synced != 0) {
+        return std::error_code(errno, std::generic_category());
+    }
+    return {};
+}
+#else
+WriteAheadLog::WriteAheadLog(
+        const std::string& path,
+        const std::function<void(std::string_view)>& replay,
+        std::chrono::microseconds flush_interval)
+    : path{path}, flush_interval{flush_interval}
+{
+    auto open = [&path] {
+        std::FILE* opened = std::fopen(path.c_str(), "ab");
+        if (opened == nullptr) {
+            throw std::system_error(
+                    std::make_error_code(std::errc::io_error), path);
+        }
+        return opened;
+    };
+    std::fclose(open());
+    size_t end = 0;
+    size_t size = 0;
+    {
+        InputSource log(path);
+        end = read_records(log.view(), replay, replayed_records);
+        size = log.view().size();
+    }
+    if (end < size) {
+        std::filesystem::resize_file(path, end);
+    }
+    file = open();
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    if (!pending.empty() && !failure) {
+        write_out(pending);
+    }
+    std::fclose(file);
+}
+
+// Without fdatasync the records are only handed to the operating system.
+std::error_code WriteAheadLog::write_out(const std::string& bytes)
+{
+    if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()
+        || std::fflush(file) != 0) {
+        return std::make_error_code(std::errc::io_error);
+    }
+    return {};
+}
+#endif
+
+uint64_t WriteAheadLog::append(std::string_view record)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    frame(pending, record);
+    return ++appended;
+}
+
+// The first committer to find no flush under way leads the next one, for
+// every record appended by then; the others wait for it to finish, and lead
+// the one after if theirs did not make it in.
+void WriteAheadLog::flush(uint64_t sequence)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (durable < sequence) {
+        if (failure) {
+            throw std::system_error(failure, path);
+        }
+        if (flushing) {
+            flushed.wait(lock);
+            continue;
+        }
+        flushing = true;
+        if (flush_interval.count() > 0) {
+            lock.unlock();
+            std::this_thread::sleep_for(flush_interval);
+            lock.lock();
+        }
+        writing.clear();
+        writing.swap(pending);
+        uint64_t last = appended;
+        lock.unlock();
+        std::error_code error = write_out(writing);
+        lock.lock();
+        flushing = false;
+        if (error) {
+            failure = error;
+        } else {
+            durable = last;
+            flush_count++;
+        }
+        flushed.notify_all();
+    }
+}
+
+void WriteAheadLog::commit(std::string_view record)
+{
+    flush(append(record));
+}
+
+size_t WriteAheadLog::replayed() const
+{
+    return replayed_records;
+}
+
+size_t WriteAheadLog::flushes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return flush_count;
+}
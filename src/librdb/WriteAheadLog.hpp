@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Platform.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace rdb {
+// An append-only file of records, each one on disk before commit() returns.
+// Every record is framed by its length and a checksum, so that one torn by a
+// crash mid-write is recognised when the log is next opened, and cut off.
+//
+// Commits are grouped: records appended while a flush is under way wait for
+// the next one, and all of them reach the disk with a single write and a
+// single fdatasync. The thread that starts a flush can hold it back for
+// flush_interval first, trading its own latency for larger groups when
+// commits are frequent. All members may be called from several threads at
+// once.
+class WriteAheadLog {
+public:
+    // Calls replay(record) for every record already in the log at path, in
+    // order, then opens it for appending after the last of them; the file is
+    // created if it does not exist. Throws std::system_error if it cannot be
+    // read or opened, and passes on whatever replay throws.
+    WriteAheadLog(
+            const std::string& path,
+            const std::function<void(std::string_view)>& replay,
+            std::chrono::microseconds flush_interval = {});
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+    // Writes out records appended but never flushed.
+    ~WriteAheadLog();
+
+    // Queues record and returns its sequence number, counting from 1 in the
+    // order records are appended.
+    uint64_t append(std::string_view record);
+    // Returns once the record numbered sequence and all before it are on
+    // disk. Throws std::system_error if writing or flushing them failed, as
+    // will every later call: what reached the disk is then unknown.
+    void flush(uint64_t sequence);
+    // append() and flush() in one.
+    void commit(std::string_view record);
+
+    // How many records were replayed when the log was opened.
+    size_t replayed() const;
+    // How many times records were written and flushed, for as many commits
+    // as were made since the log was opened.
+    size_t flushes() const;
+
+private:
+    const std::string path;
+    const std::chrono::microseconds flush_interval;
+#if defined(RDB_POSIX)
+    int fd = -1;
+#else
+    std::FILE* file = nullptr;
+#endif
+    size_t replayed_records = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable flushed;
+    // Framed records appended since the last flush began.
+    std::string pending;
+    // The records being written by the flush under way.
+    std::string writing;
+    uint64_t appended = 0;
+    uint64_t durable = 0;
+    bool flushing = false;
+    size_t flush_count = 0;
+    std::error_code failure;
+
+    // Writes bytes to the end of the file and flushes it, outside the lock;
+    // returns what went wrong, if anything.
+    std::error_code write_out(const std::string& bytes);
+};
+} // namespace rdb
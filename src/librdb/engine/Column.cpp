@@ -0,0 +1,181 @@
+#include "Column.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+using rdb::engine::Column;
+using rdb::engine::Selection;
+using rdb::engine::TextColumn;
+using rdb::parser::TokenType;
+
+namespace {
+// Calls keep(row, out) for each row not removed, out counting them from 0,
+// and returns how many there are. Rows before the first removed one are
+// already where they belong and are skipped a word at a time.
+template <typename Keep>
+size_t for_each_kept(size_t rows, const Selection& removed, Keep&& keep)
+{
+    const uint64_t* words = removed.words();
+    size_t out = 0;
+    for (size_t word = 0; word < removed.word_count(); word++) {
+        size_t base = word * 64;
+        size_t count = std::min<size_t>(64, rows - base);
+        if ((words[word] == 0) && (out == base)) {
+            out += count;
+            continue;
+        }
+        for (size_t bit = 0; bit < count; bit++) {
+            if (((words[word] >> bit) & 1) == 0) {
+                keep(base + bit, out++);
+            }
+        }
+    }
+    return out;
+}
+} // namespace
+
+size_t TextColumn::size() const
+{
+    return ends_.size();
+}
+
+std::string_view TextColumn::operator[](size_t row) const
+{
+    size_t begin = (row == 0) ? 0 : ends_[row - 1];
+    return std::string_view(bytes_).substr(begin, ends_[row] - begin);
+}
+
+void TextColumn::reserve(size_t rows, size_t bytes)
+{
+    ends_.reserve(rows);
+    bytes_.reserve(bytes);
+}
+
+void TextColumn::push_back(std::string_view text)
+{
+    bytes_.append(text);
+    ends_.push_back(bytes_.size());
+}
+
+void rdb::engine::retain(TextColumn& column, const Selection& removed)
+{
+    // Texts only ever move towards the front, so they are copied in place.
+    // The end a kept row is written to is never one still to be read: until
+    // the first removed row it is the same value, and after it at least two
+    // rows behind.
+    size_t kept = for_each_kept(
+            column.size(), removed, [&column](size_t row, size_t out) {
+                std::string_view text = column[row];
+                size_t begin = (out == 0) ? 0 : column.ends_[out - 1];
+                std::copy(
+                        text.begin(),
+                        text.end(),
+                        column.bytes_.begin() + begin);
+                column.ends_[out] = begin + text.size();
+            });
+    column.ends_.resize(kept);
+    column.bytes_.resize((kept == 0) ? 0 : column.ends_.back());
+}
+
+std::optional<TokenType> rdb::engine::alternative_type(size_t alternative)
+{
+    constexpr TokenType Types[] = {
+            TokenType::KwInt, TokenType::KwReal, TokenType::KwText};
+    static_assert(std::size(Types) == std::variant_size_v<Column>);
+    if (alternative >= std::size(Types)) {
+        return std::nullopt;
+    }
+    return Types[alternative];
+}
+
+size_t rdb::engine::column_rows(const Column& column)
+{
+    return std::visit([](auto&& values) { return values.size(); }, column);
+}
+
+namespace {
+// rows is a Selection or a list of rows.
+template <typename Rows>
+Column gather_rows(const Column& column, size_t count, const Rows& rows)
+{
+    return std::visit(
+            [count, &rows](auto&& values) -> Column {
+                using Values = std::decay_t<decltype(values)>;
+                Values gathered;
+                if constexpr (std::is_same_v<Values, TextColumn>) {
+                    gathered.reserve(count, 0);
+                } else {
+                    gathered.reserve(count);
+                }
+                auto push = [&gathered, &values](size_t row) {
+                    gathered.push_back(values[row]);
+                };
+                if constexpr (std::is_same_v<Rows, Selection>) {
+                    rows.for_each(push);
+                } else {
+                    std::for_each(rows.begin(), rows.end(), push);
+                }
+                return gathered;
+            },
+            column);
+}
+} // namespace
+
+Column rdb::engine::gather(const Column& column, const Selection& selected)
+{
+    return gather_rows(column, selected.count(), selected);
+}
+
+Column rdb::engine::gather(
+        const Column& column, const std::vector<size_t>& rows)
+{
+    return gather_rows(column, rows.size(), rows);
+}
+
+void rdb::engine::copy_rows(
+        Column& column, const Column& values, size_t first, size_t last)
+{
+    std::visit(
+            [first, last](auto&& to, auto&& from) {
+                using To = std::decay_t<decltype(to)>;
+                using From = std::decay_t<decltype(from)>;
+                if constexpr (!std::is_same_v<To, From>) {
+                    throw std::invalid_argument(
+                            "copy_rows: columns of different types");
+                } else if constexpr (std::is_same_v<To, TextColumn>) {
+                    for (size_t row = first; row < last; row++) {
+                        to.push_back(from[row]);
+                    }
+                } else {
+                    to.insert(
+                            to.end(),
+                            from.begin() + static_cast<std::ptrdiff_t>(first),
+                            from.begin() + static_cast<std::ptrdiff_t>(last));
+                }
+            },
+            column,
+            values);
+}
+
+void rdb::engine::retain(Column& column, const Selection& removed)
+{
+    std::visit(
+            [&removed](auto&& values) {
+                using Values = std::decay_t<decltype(values)>;
+                if constexpr (std::is_same_v<Values, TextColumn>) {
+                    retain(values, removed);
+                } else {
+                    size_t kept = for_each_kept(
+                            values.size(),
+                            removed,
+                            [&values](size_t row, size_t out) {
+                                values[out] = values[row];
+                            });
+                    values.resize(kept);
+                }
+            },
+            column);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Selection.hpp"
+#include "librdb/Token.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace rdb::engine {
+// The values of a TEXT column, one after another in a single buffer.
+class TextColumn {
+public:
+    size_t size() const;
+    std::string_view operator[](size_t row) const;
+
+    void reserve(size_t rows, size_t bytes);
+    void push_back(std::string_view text);
+
+private:
+    std::string bytes_;
+    // Where each row's text ends in bytes_.
+    std::vector<size_t> ends_;
+
+    friend void retain(TextColumn& column, const Selection& removed);
+};
+
+// The values of one column of a table, contiguous and of its declared type:
+// INT, REAL or TEXT in that order.
+using Column = std::variant<std::vector<long>, std::vector<double>, TextColumn>;
+
+// The declared type of the columns held as the alternative-th alternative of
+// Column: KwInt, KwReal or KwText, or nullopt past the last. A column's type
+// is thus logged as its index().
+std::optional<parser::TokenType> alternative_type(size_t alternative);
+size_t column_rows(const Column& column);
+// The selected rows of column, in order, as a new column of the same type.
+Column gather(const Column& column, const Selection& selected);
+// The given rows of column, ascending, as a new column of the same type.
+Column gather(const Column& column, const std::vector<size_t>& rows);
+// Appends rows [first, last) of values, a column of the same type.
+void copy_rows(Column& column, const Column& values, size_t first, size_t last);
+// Drops the removed rows of column, keeping the order of the others.
+void retain(Column& column, const Selection& removed);
+void retain(TextColumn& column, const Selection& removed);
+} // namespace rdb::engine
@@ -0,0 +1,829 @@
+#include "Database.hpp"
+#include "Filter.hpp"
+#include "LogRecord.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using rdb::BufferPool;
+using rdb::WriteAheadLog;
+using rdb::engine::Column;
+using rdb::engine::Database;
+using rdb::engine::ExecError;
+using rdb::engine::ExecErrorType;
+using rdb::engine::ExecResult;
+using rdb::engine::Expected;
+using rdb::engine::Index;
+using rdb::engine::PagedTable;
+using rdb::engine::RecordReader;
+using rdb::engine::RecordType;
+using rdb::engine::RecordWriter;
+using rdb::engine::Selection;
+using rdb::engine::Table;
+using rdb::engine::TextColumn;
+using rdb::parser::ArenaArray;
+using rdb::parser::BasicExpression;
+using rdb::parser::BasicValueColumn;
+using rdb::parser::ColumnColumnPredicate;
+using rdb::parser::ColumnConstantPredicate;
+using rdb::parser::CompareOp;
+using rdb::parser::ConstantPredicate;
+using rdb::parser::IndexKind;
+using rdb::parser::Placeholder;
+using rdb::parser::TokenType;
+using rdb::parser::ValueView;
+
+namespace {
+// Text is kept without the quotes of its literal.
+std::string_view unquote(std::string_view lexeme)
+{
+    return lexeme.substr(1, lexeme.size() - 2);
+}
+
+// A WHERE constant as columns hold it.
+template <typename T>
+T stored(T constant)
+{
+    return constant;
+}
+
+std::string_view stored(std::string_view lexeme)
+{
+    return unquote(lexeme);
+}
+
+// Why value cannot go in a column of type, if it cannot. Integers also go in
+// REAL columns.
+std::optional<ExecErrorType> check_value(TokenType type, const ValueView& value)
+{
+    if (std::holds_alternative<Placeholder>(value)) {
+        return ExecErrorType::UnboundPlaceholder;
+    }
+    bool fits = (type == TokenType::KwInt)
+            ? std::holds_alternative<long>(value)
+            : (type == TokenType::KwReal)
+                    ? !std::holds_alternative<std::string_view>(value)
+                    : std::holds_alternative<std::string_view>(value);
+    if (!fits) {
+        return ExecErrorType::TypeMismatch;
+    }
+    return std::nullopt;
+}
+
+template <typename Text>
+std::optional<ExecErrorType>
+check_values(TokenType type, const BasicValueColumn<Text>& values)
+{
+    size_t rows = rdb::parser::column_rows(values);
+    switch (values.index()) {
+    case 0:
+        return (type == TokenType::KwText)
+                ? std::optional(ExecErrorType::TypeMismatch)
+                : std::nullopt;
+    case 1:
+        return (type == TokenType::KwReal)
+                ? std::nullopt
+                : std::optional(ExecErrorType::TypeMismatch);
+    case 2:
+        return (type == TokenType::KwText)
+                ? std::nullopt
+                : std::optional(ExecErrorType::TypeMismatch);
+    default:
+        for (size_t row = 0; row < rows; row++) {
+            auto error = check_value(
+                    type, rdb::parser::column_value(values, row));
+            if (error) {
+                return error;
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+// Appends values, already checked to fit, to column.
+template <typename Text>
+void append(Column& column, const BasicValueColumn<Text>& values)
+{
+    size_t rows = rdb::parser::column_rows(values);
+    std::visit(
+            [&values, rows](auto&& target) {
+                using Target = std::decay_t<decltype(target)>;
+                if constexpr (std::is_same_v<Target, TextColumn>) {
+                    for (size_t row = 0; row < rows; row++) {
+                        target.push_back(unquote(std::get<std::string_view>(
+                                rdb::parser::column_value(values, row))));
+                    }
+                    return;
+                } else {
+                    using T = typename Target::value_type;
+                    if (auto* typed = std::get_if<ArenaArray<T>>(&values)) {
+                        target.insert(
+                                target.end(), typed->begin(), typed->end());
+                        return;
+                    }
+                    for (size_t row = 0; row < rows; row++) {
+                        std::visit(
+                                [&target](auto&& value) {
+                                    using Value
+                                            = std::decay_t<decltype(value)>;
+                                    if constexpr (std::is_arithmetic_v<Value>) {
+                                        target.push_back(static_cast<T>(value));
+                                    }
+                                },
+                                rdb::parser::column_value(values, row));
+                    }
+                }
+            },
+            column);
+}
+
+// Whether an operand pair of literals compares text with a number.
+template <typename Text>
+bool mixes_text_and_number(const BasicExpression<Text>& expression)
+{
+    return !expression.loperand.is_id && !expression.roperand.is_id
+            && (std::holds_alternative<Text>(expression.loperand.val)
+                != std::holds_alternative<Text>(expression.roperand.val));
+}
+
+template <typename Text>
+bool has_placeholder(const BasicExpression<Text>& expression)
+{
+    return std::holds_alternative<Placeholder>(expression.loperand.val)
+            || std::holds_alternative<Placeholder>(expression.roperand.val);
+}
+
+// The rows, in order, that an index on the column of a compiled predicate
+// finds, or nullopt if no index answers it.
+class IndexLookup {
+public:
+    explicit IndexLookup(const Table& table) : table{table}
+    {
+    }
+
+    template <CompareOp Op, typename T>
+    std::optional<std::vector<size_t>>
+    operator()(const ColumnConstantPredicate<Op, T>& predicate) const
+    {
+        auto index = table.column_index(predicate.column);
+        const Index* found = index ? table.find_index(*index, Op) : nullptr;
+        std::vector<size_t> rows;
+        if (found && found->select(Op, stored(predicate.constant), rows)) {
+            return rows;
+        }
+        return std::nullopt;
+    }
+
+    template <typename Predicate>
+    std::optional<std::vector<size_t>> operator()(const Predicate&) const
+    {
+        return std::nullopt;
+    }
+
+private:
+    const Table& table;
+};
+
+// The rows of table that expression selects. A column compared with a
+// constant is looked up in an index on it when there is one that answers
+// the comparison, and scanned otherwise.
+class Filter {
+public:
+    Filter(const Table& table, Selection& selection)
+        : table{table}, selection{selection}
+    {
+    }
+
+    std::optional<ExecError> operator()(const ConstantPredicate& predicate)
+    {
+        selection = Selection(table.rows(), predicate.result);
+        return std::nullopt;
+    }
+
+    template <CompareOp Op, typename T>
+    std::optional<ExecError>
+    operator()(const ColumnConstantPredicate<Op, T>& predicate)
+    {
+        auto index = table.column_index(predicate.column);
+        if (!index) {
+            return ExecError(
+                    ExecErrorType::NoSuchColumn, std::string(predicate.column));
+        }
+        if (auto rows = IndexLookup(table)(predicate)) {
+            for (size_t row : *rows) {
+                selection.set(row);
+            }
+            return std::nullopt;
+        }
+        bool filtered = std::visit(
+                [this, &predicate](auto&& values) {
+                    using Values = std::decay_t<decltype(values)>;
+                    constexpr bool text = std::is_same_v<Values, TextColumn>;
+                    if constexpr (text != std::is_same_v<T, std::string_view>) {
+                        return false;
+                    } else {
+                        rdb::engine::filter_constant<Op>(
+                                values, stored(predicate.constant), selection);
+                        return true;
+                    }
+                },
+                table.column(*index));
+        if (!filtered) {
+            return ExecError(
+                    ExecErrorType::TypeMismatch, std::string(predicate.column));
+        }
+        return std::nullopt;
+    }
+
+    template <CompareOp Op>
+    std::optional<ExecError>
+    operator()(const ColumnColumnPredicate<Op>& predicate)
+    {
+        auto left = table.column_index(predicate.left_column);
+        auto right = table.column_index(predicate.right_column);
+        if (!left || !right) {
+            return ExecError(
+                    ExecErrorType::NoSuchColumn,
+                    std::string(
+                            left ? predicate.right_column
+                                 : predicate.left_column));
+        }
+        bool filtered = std::visit(
+                [this](auto&& left_values, auto&& right_values) {
+                    constexpr bool left_text = std::is_same_v<
+                            std::decay_t<decltype(left_values)>,
+                            TextColumn>;
+                    constexpr bool right_text = std::is_same_v<
+                            std::decay_t<decltype(right_values)>,
+                            TextColumn>;
+                    if constexpr (left_text != right_text) {
+                        return false;
+                    } else {
+                        rdb::engine::filter_columns<Op>(
+                                left_values, right_values, selection);
+                        return true;
+                    }
+                },
+                table.column(*left),
+                table.column(*right));
+        if (!filtered) {
+            return ExecError(
+                    ExecErrorType::TypeMismatch,
+                    std::string(predicate.left_column));
+        }
+        return std::nullopt;
+    }
+
+private:
+    const Table& table;
+    Selection& selection;
+};
+
+// The rows selected by the WHERE clause of statement when an index answers
+// it, which spares building a Selection as long as the table; nullopt when
+// the clause is missing, invalid or has to be scanned.
+template <typename Statement>
+std::optional<std::vector<size_t>>
+index_rows(const Table& table, const Statement& statement)
+{
+    if ((table.indexes() == 0) || !statement.has_expression()) {
+        return std::nullopt;
+    }
+    const auto& expression = statement.expression();
+    if (has_placeholder(expression) || mixes_text_and_number(expression)) {
+        return std::nullopt;
+    }
+    return std::visit(
+            IndexLookup(table), rdb::parser::compile_predicate(expression));
+}
+
+// The rows selected by the WHERE clause of statement, or all of them.
+template <typename Statement>
+Expected<Selection> select_rows(const Table& table, const Statement& statement)
+{
+    if (!statement.has_expression()) {
+        return Selection(table.rows(), true);
+    }
+    const auto& expression = statement.expression();
+    if (has_placeholder(expression)) {
+        return ExecError(ExecErrorType::UnboundPlaceholder);
+    }
+    if (mixes_text_and_number(expression)) {
+        return ExecError(ExecErrorType::TypeMismatch);
+    }
+    Selection selection(table.rows());
+    auto error = std::visit(
+            Filter(table, selection),
+            rdb::parser::compile_predicate(expression));
+    if (error) {
+        return *error;
+    }
+    return selection;
+}
+
+[[noreturn]] void throw_bad_record()
+{
+    throw std::runtime_error("log record does not apply to the tables");
+}
+} // namespace
+
+struct Database::Log {
+    std::mutex mutex;
+    WriteAheadLog records;
+
+    Log(const std::string& path,
+        const std::function<void(std::string_view)>& replay,
+        std::chrono::microseconds flush_interval)
+        : records{path, replay, flush_interval}
+    {
+    }
+};
+
+// Runs each kind of statement and, when given a record, writes to it the
+// change the statement made, if any. Statements on a paged table work on
+// its schema, and then page by page on the rows read back from each.
+template <typename Text>
+class Database::Executor {
+public:
+    Executor(Database& database, std::string* record)
+        : tables{database.tables_},
+          record{record},
+          pool{database.pool_},
+          paged_tables{database.paged_tables_}
+    {
+    }
+
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicCreateTableStatement<Text>& statement)
+    {
+        std::string name(statement.table_name());
+        if (tables.count(name) != 0 || paged_tables.count(name) != 0) {
+            return ExecError(ExecErrorType::TableExists, name);
+        }
+        Table table;
+        for (size_t index = 0; index < statement.columns_defined(); index++) {
+            const auto& column_def = statement.column_def(index);
+            if (table.column_index(column_def.column_name)) {
+                return ExecError(
+                        ExecErrorType::DuplicateColumn,
+                        std::string(column_def.column_name));
+            }
+            table.add_column(
+                    std::string(column_def.column_name), column_def.type_name);
+        }
+        if (record) {
+            RecordWriter writer(*record, RecordType::CreateTable);
+            writer.put(name);
+            writer.put(table.columns());
+            for (size_t index = 0; index < table.columns(); index++) {
+                writer.put(table.column_name(index));
+                // Read back through alternative_type().
+                writer.put(table.column(index).index());
+            }
+        }
+        if (pool) {
+            paged_tables.emplace(
+                    std::move(name), PagedTable(std::move(table), *pool));
+        } else {
+            tables.emplace(std::move(name), std::move(table));
+        }
+        return ExecResult();
+    }
+
+    // Rows for a paged table are put together in memory first, in a table
+    // of its columns, and added once they all turn out valid.
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicInsertStatement<Text>& statement)
+    {
+        std::string_view table_name = statement.table_name();
+        auto found = tables.find(table_name);
+        auto paged = paged_tables.find(table_name);
+        if (found == tables.end() && paged == paged_tables.end()) {
+            return ExecError(
+                    ExecErrorType::NoSuchTable, std::string(table_name));
+        }
+        Table staged;
+        if (found == tables.end()) {
+            staged = paged->second.schema();
+        }
+        Table& table = (found == tables.end()) ? staged : found->second;
+
+        // Where each column of the table takes its values from.
+        constexpr size_t Unset = SIZE_MAX;
+        std::vector<size_t> sources(table.columns(), Unset);
+        for (size_t index = 0; index < statement.columns_defined(); index++) {
+            std::string_view name = statement.column_name(index);
+            auto column = table.column_index(name);
+            if (!column) {
+                return ExecError(
+                        ExecErrorType::NoSuchColumn, std::string(name));
+            }
+            if (sources[*column] != Unset) {
+                return ExecError(
+                        ExecErrorType::DuplicateColumn, std::string(name));
+            }
+            auto error = check_values(
+                    table.column_type(*column), statement.value_column(index));
+            if (error) {
+                return ExecError(*error, std::string(name));
+            }
+            sources[*column] = index;
+        }
+        for (size_t column = 0; column < table.columns(); column++) {
+            if (sources[column] == Unset) {
+                return ExecError(
+                        ExecErrorType::MissingColumn,
+                        table.column_name(column));
+            }
+        }
+
+        size_t first = table.rows();
+        table.append_rows(
+                statement.rows(),
+                [&statement, &sources](size_t index, Column& column) {
+                    append(column, statement.value_column(sources[index]));
+                });
+        if (found == tables.end()) {
+            if (!paged->second.fits(staged)) {
+                return ExecError(
+                        ExecErrorType::RowTooLarge, std::string(table_name));
+            }
+            paged->second.append(staged);
+        }
+        if (record) {
+            RecordWriter writer(*record, RecordType::Insert);
+            writer.put(table_name);
+            writer.put(statement.rows());
+            for (size_t index = 0; index < table.columns(); index++) {
+                writer.put(table.column(index), first);
+            }
+        }
+        ExecResult result;
+        result.affected = statement.rows();
+        return result;
+    }
+
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicSelectStatement<Text>& statement)
+    {
+        std::string_view table_name = statement.table_name();
+        auto found = tables.find(table_name);
+        auto paged = paged_tables.find(table_name);
+        if (found == tables.end() && paged == paged_tables.end()) {
+            return ExecError(
+                    ExecErrorType::NoSuchTable, std::string(table_name));
+        }
+        const Table& table = (found == tables.end()) ? paged->second.schema()
+                                                     : found->second;
+        std::vector<size_t> columns;
+        for (size_t index = 0; index < statement.columns_defined(); index++) {
+            std::string_view name = statement.column_name(index);
+            auto column = table.column_index(name);
+            if (!column) {
+                return ExecError(
+                        ExecErrorType::NoSuchColumn, std::string(name));
+            }
+            columns.push_back(*column);
+        }
+        ExecResult result;
+        auto project = [&](const auto& rows) {
+            for (size_t index = 0; index < columns.size(); index++) {
+                result.rows.add_column(
+                        std::string(statement.column_name(index)),
+                        rdb::engine::gather(
+                                table.column(columns[index]), rows));
+            }
+        };
+        if (auto rows = index_rows(table, statement)) {
+            project(*rows);
+            return result;
+        }
+        auto selection = select_rows(table, statement);
+        if (!selection) {
+            return selection.error();
+        }
+        if (found == tables.end()) {
+            return select_pages(paged->second, columns, statement);
+        }
+        project(*selection);
+        return result;
+    }
+
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicDeleteFromStatement<Text>& statement)
+    {
+        std::string_view table_name = statement.table_name();
+        auto paged = paged_tables.find(table_name);
+        if (paged != paged_tables.end()) {
+            return delete_pages(paged->second, statement);
+        }
+        auto found = tables.find(table_name);
+        if (found == tables.end()) {
+            return ExecError(
+                    ExecErrorType::NoSuchTable, std::string(table_name));
+        }
+        Table& table = found->second;
+        auto selection = select_rows(table, statement);
+        if (!selection) {
+            return selection.error();
+        }
+        ExecResult result;
+        result.affected = selection->count();
+        if (record && result.affected != 0) {
+            RecordWriter writer(*record, RecordType::Delete);
+            writer.put(found->first);
+            writer.put(result.affected);
+            selection->for_each([&writer](size_t row) { writer.put(row); });
+        }
+        table.remove_rows(*selection);
+        return result;
+    }
+
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicCreateIndexStatement<Text>& statement)
+    {
+        std::string_view table_name = statement.table_name();
+        if (paged_tables.count(table_name) != 0) {
+            return ExecError(
+                    ExecErrorType::NotIndexable, std::string(table_name));
+        }
+        auto found = tables.find(table_name);
+        if (found == tables.end()) {
+            return ExecError(
+                    ExecErrorType::NoSuchTable,
+                    std::string(statement.table_name()));
+        }
+        Table& table = found->second;
+        auto column = table.column_index(statement.column_name());
+        if (!column) {
+            return ExecError(
+                    ExecErrorType::NoSuchColumn,
+                    std::string(statement.column_name()));
+        }
+        // Index names are shared by all tables, as in SQL.
+        std::string name(statement.index_name());
+        for (auto&& other : tables) {
+            for (size_t index = 0; index < other.second.indexes(); index++) {
+                if (other.second.index(index).name() == name) {
+                    return ExecError(ExecErrorType::IndexExists, name);
+                }
+            }
+        }
+        if (record) {
+            RecordWriter writer(*record, RecordType::CreateIndex);
+            writer.put(found->first);
+            writer.put(name);
+            writer.put(*column);
+            writer.put(statement.kind() == IndexKind::Hash);
+        }
+        table.add_index(std::move(name), *column, statement.kind());
+        return ExecResult();
+    }
+
+    Expected<ExecResult>
+    operator()(const rdb::parser::BasicDropTableStatement<Text>& statement)
+    {
+        std::string_view table_name = statement.table_name();
+        auto paged = paged_tables.find(table_name);
+        if (paged != paged_tables.end()) {
+            paged_tables.erase(paged);
+            return ExecResult();
+        }
+        auto found = tables.find(table_name);
+        if (found == tables.end()) {
+            return ExecError(
+                    ExecErrorType::NoSuchTable,
+                    std::string(statement.table_name()));
+        }
+        if (record) {
+            RecordWriter(*record, RecordType::DropTable).put(found->first);
+        }
+        tables.erase(found);
+        return ExecResult();
+    }
+
+private:
+    std::map<std::string, Table, std::less<>>& tables;
+    std::string* record;
+    BufferPool* pool;
+    std::map<std::string, PagedTable, std::less<>>& paged_tables;
+
+    // The columns of a SELECT from table, scanned a page at a time; the
+    // statement has passed select_rows() on the schema, and so does on every
+    // page.
+    Expected<ExecResult> select_pages(
+            const PagedTable& table,
+            const std::vector<size_t>& columns,
+            const rdb::parser::BasicSelectStatement<Text>& statement)
+    {
+        std::vector<Column> selected;
+        for (size_t column : columns) {
+            selected.push_back(table.schema().column(column));
+        }
+        table.scan([&](const Table& page) {
+            auto selection = select_rows(page, statement);
+            for (size_t index = 0; index < columns.size(); index++) {
+                Column rows = rdb::engine::gather(
+                        page.column(columns[index]), *selection);
+                copy_rows(selected[index], rows, 0, column_rows(rows));
+            }
+        });
+        ExecResult result;
+        for (size_t index = 0; index < columns.size(); index++) {
+            result.rows.add_column(
+                    std::string(statement.column_name(index)),
+                    std::move(selected[index]));
+        }
+        return result;
+    }
+
+    // Rewrites each page that loses rows, and frees those left empty.
+    Expected<ExecResult> delete_pages(
+            PagedTable& table,
+            const rdb::parser::BasicDeleteFromStatement<Text>& statement)
+    {
+        auto checked = select_rows(table.schema(), statement);
+        if (!checked) {
+            return checked.error();
+        }
+        // select_rows() fails only on the statement, so no page can fail it
+        // now that the schema has passed.
+        ExecResult result;
+        for (size_t index = 0; index < table.pages();) {
+            Table page = table.page(index);
+            auto selection = select_rows(page, statement);
+            size_t removed = selection->count();
+            if (removed != 0) {
+                result.affected += removed;
+                page.remove_rows(*selection);
+                table.replace_page(index, page);
+            }
+            if (page.rows() != 0) {
+                index++;
+            }
+        }
+        return result;
+    }
+};
+
+Database::Database() = default;
+
+Database::Database(
+        const std::string& log_path, std::chrono::microseconds flush_interval)
+    : log_{std::make_unique<Log>(
+            log_path,
+            [this](std::string_view record) { replay(record); },
+            flush_interval)}
+{
+}
+
+Database::Database(BufferPool& pool) : pool_{&pool}
+{
+}
+
+Database::Database(Database&&) noexcept = default;
+Database& Database::operator=(Database&&) noexcept = default;
+Database::~Database() = default;
+
+// The tables are changed under the lock, so records are appended in the
+// order of the changes; their flush is waited for outside it, so that the
+// changes of other threads join the same one.
+template <typename Text>
+Expected<ExecResult>
+Database::execute(const rdb::parser::BasicSqlStatement<Text>& statement)
+{
+    if (!log_) {
+        return std::visit(Executor<Text>(*this, nullptr), statement);
+    }
+    std::unique_lock<std::mutex> lock(log_->mutex);
+    std::string record;
+    auto result = std::visit(Executor<Text>(*this, &record), statement);
+    if (record.empty()) {
+        return result;
+    }
+    uint64_t sequence = log_->records.append(record);
+    lock.unlock();
+    log_->records.flush(sequence);
+    return result;
+}
+
+template <typename Text>
+std::vector<Expected<ExecResult>>
+Database::execute(const rdb::parser::BasicSqlScript<Text>& script)
+{
+    std::vector<Expected<ExecResult>> results;
+    results.reserve(script.sql_statements.size());
+    for (auto&& statement : script.sql_statements) {
+        results.push_back(execute(statement));
+    }
+    return results;
+}
+
+size_t Database::tables() const
+{
+    return tables_.size() + paged_tables_.size();
+}
+
+const Table* Database::table(std::string_view name) const
+{
+    auto found = tables_.find(name);
+    return (found == tables_.end()) ? nullptr : &found->second;
+}
+
+const PagedTable* Database::paged_table(std::string_view name) const
+{
+    auto found = paged_tables_.find(name);
+    return (found == paged_tables_.end()) ? nullptr : &found->second;
+}
+
+const WriteAheadLog* Database::log() const
+{
+    return log_ ? &log_->records : nullptr;
+}
+
+void Database::replay(std::string_view record)
+{
+    RecordReader reader(record);
+    auto table = [this](std::string_view name) -> Table& {
+        auto found = tables_.find(name);
+        if (found == tables_.end()) {
+            throw_bad_record();
+        }
+        return found->second;
+    };
+    switch (reader.type()) {
+    case RecordType::CreateTable: {
+        std::string name(reader.text());
+        Table created;
+        for (uint64_t columns = reader.number(); columns > 0; columns--) {
+            std::string column(reader.text());
+            auto type = alternative_type(reader.number());
+            if (!type) {
+                throw_bad_record();
+            }
+            created.add_column(std::move(column), *type);
+        }
+        if (!tables_.emplace(std::move(name), std::move(created)).second) {
+            throw_bad_record();
+        }
+        break;
+    }
+    case RecordType::DropTable: {
+        auto found = tables_.find(reader.text());
+        if (found == tables_.end()) {
+            throw_bad_record();
+        }
+        tables_.erase(found);
+        break;
+    }
+    case RecordType::CreateIndex: {
+        Table& indexed = table(reader.text());
+        std::string name(reader.text());
+        uint64_t column = reader.number();
+        auto kind = (reader.number() != 0) ? IndexKind::Hash
+                                           : IndexKind::Ordered;
+        if (column >= indexed.columns()) {
+            throw_bad_record();
+        }
+        indexed.add_index(std::move(name), column, kind);
+        break;
+    }
+    case RecordType::Insert: {
+        Table& inserted = table(reader.text());
+        uint64_t rows = reader.number();
+        inserted.append_rows(rows, [&reader, rows](size_t, Column& column) {
+            reader.append_to(column, rows);
+        });
+        break;
+    }
+    case RecordType::Delete: {
+        Table& deleted = table(reader.text());
+        Selection removed(deleted.rows());
+        for (uint64_t rows = reader.number(); rows > 0; rows--) {
+            uint64_t row = reader.number();
+            if (row >= deleted.rows()) {
+                throw_bad_record();
+            }
+            removed.set(row);
+        }
+        deleted.remove_rows(removed);
+        break;
+    }
+    default:
+        throw_bad_record();
+    }
+}
+
+#define RDB_INSTANTIATE_DATABASE(Text)                                         \
+    template Expected<ExecResult> Database::execute(                           \
+            const rdb::parser::BasicSqlStatement<Text>&);                      \
+    template std::vector<Expected<ExecResult>> Database::execute(              \
+            const rdb::parser::BasicSqlScript<Text>&);
+
+RDB_INSTANTIATE_DATABASE(rdb::parser::String)
+RDB_INSTANTIATE_DATABASE(std::string_view)
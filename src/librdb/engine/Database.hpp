@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ExecError.hpp"
+#include "PagedTable.hpp"
+#include "Table.hpp"
+#include "librdb/BufferPool.hpp"
+#include "librdb/WriteAheadLog.hpp"
+#include "librdb/parser/Expected.hpp"
+#include "librdb/parser/Parser.hpp"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rdb::engine {
+// What a statement yields: the selected rows of a SELECT, and the number of
+// rows an INSERT added or a DELETE removed.
+struct ExecResult {
+    Table rows;
+    size_t affected = 0;
+};
+
+template <typename T>
+using Expected = parser::Expected<T, ExecError>;
+
+// An in-memory catalog of tables that runs parsed statements of either AST
+// flavour against them. Tables are stored by column (see Column), and WHERE
+// clauses are compiled once per statement into a loop over the columns they
+// name.
+//
+// A database opened on a log rebuilds its tables from it, and logs every
+// change a statement makes before execute() returns. Such a database may run
+// statements from several threads at once: they change the tables one at a
+// time, and those that did wait together for their records to reach the
+// disk.
+//
+// A database opened on a buffer pool keeps its tables in pages instead (see
+// PagedTable), so they may be larger than memory.
+class Database {
+public:
+    // Without a log: the tables live and die with the database.
+    Database();
+    // Replays the log at log_path, then appends to it; see WriteAheadLog for
+    // flush_interval. Throws std::system_error if the log cannot be read or
+    // opened, and std::runtime_error if one of its records does not apply to
+    // the tables the records before it left.
+    explicit Database(
+            const std::string& log_path,
+            std::chrono::microseconds flush_interval = {});
+    // Tables in pages of pool, which must outlive the database; they have
+    // no indexes, and no log.
+    explicit Database(BufferPool& pool);
+    Database(Database&&) noexcept;
+    Database& operator=(Database&&) noexcept;
+    ~Database();
+
+    // Runs statement, which must have no placeholders left. A statement that
+    // fails changes nothing, and is not logged. Throws std::system_error if
+    // the log could not be written, the change having been made in memory.
+    template <typename Text>
+    Expected<ExecResult>
+    execute(const parser::BasicSqlStatement<Text>& statement);
+    // Runs the statements in order, carrying on past those that fail.
+    template <typename Text>
+    std::vector<Expected<ExecResult>>
+    execute(const parser::BasicSqlScript<Text>& script);
+
+    size_t tables() const;
+    // The table called name, or null; not to be called while another thread
+    // runs a statement.
+    const Table* table(std::string_view name) const;
+    // The paged table called name, or null; as table().
+    const PagedTable* paged_table(std::string_view name) const;
+    // The log of the database, or null.
+    const WriteAheadLog* log() const;
+
+private:
+    struct Log;
+
+    std::map<std::string, Table, std::less<>> tables_;
+    std::unique_ptr<Log> log_;
+    BufferPool* pool_ = nullptr;
+    std::map<std::string, PagedTable, std::less<>> paged_tables_;
+
+    // Applies a record of the log to the tables.
+    void replay(std::string_view record);
+
+    // Runs each kind of statement.
+    template <typename Text>
+    class Executor;
+};
+} // namespace rdb::engine
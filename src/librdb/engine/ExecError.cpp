@@ -0,0 +1,57 @@
+#include "ExecError.hpp"
+#include <utility>
+
+using rdb::engine::ExecError;
+using rdb::engine::ExecErrorType;
+
+ExecError::ExecError(ExecErrorType type, std::string name)
+    : type_{type}, name_{std::move(name)}
+{
+}
+
+ExecErrorType ExecError::type() const
+{
+    return type_;
+}
+
+const std::string& ExecError::name() const
+{
+    return name_;
+}
+
+std::ostream& rdb::engine::operator<<(std::ostream& os, const ExecError& error)
+{
+    os << "! ExecError::" << error.type();
+    if (!error.name().empty()) {
+        os << " (" << error.name() << ")";
+    }
+    return os;
+}
+
+std::ostream&
+rdb::engine::operator<<(std::ostream& os, ExecErrorType error_type)
+{
+    switch (error_type) {
+    case ExecErrorType::NoSuchTable:
+        return os << "NoSuchTable";
+    case ExecErrorType::TableExists:
+        return os << "TableExists";
+    case ExecErrorType::NoSuchColumn:
+        return os << "NoSuchColumn";
+    case ExecErrorType::DuplicateColumn:
+        return os << "DuplicateColumn";
+    case ExecErrorType::MissingColumn:
+        return os << "MissingColumn";
+    case ExecErrorType::TypeMismatch:
+        return os << "TypeMismatch";
+    case ExecErrorType::UnboundPlaceholder:
+        return os << "UnboundPlaceholder";
+    case ExecErrorType::IndexExists:
+        return os << "IndexExists";
+    case ExecErrorType::RowTooLarge:
+        return os << "RowTooLarge";
+    case ExecErrorType::NotIndexable:
+        return os << "NotIndexable";
+    }
+    return os;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+namespace rdb::engine {
+enum class ExecErrorType {
+    NoSuchTable,
+    TableExists,
+    NoSuchColumn,
+    DuplicateColumn,
+    MissingColumn,
+    TypeMismatch,
+    UnboundPlaceholder,
+    IndexExists,
+    // A row of a paged table must fit in one page.
+    RowTooLarge,
+    // Paged tables have no indexes.
+    NotIndexable
+};
+
+// Why a statement could not be executed; it then has changed nothing. name
+// is the table, column or index at fault, if any.
+class ExecError {
+public:
+    ExecError(ExecErrorType type, std::string name = {});
+    ExecErrorType type() const;
+    const std::string& name() const;
+
+private:
+    ExecErrorType type_;
+    std::string name_;
+};
+
+std::ostream& operator<<(std::ostream& os, const ExecError& error);
+std::ostream& operator<<(std::ostream& os, ExecErrorType error_type);
+} // namespace rdb::engine
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "FilterKernels.hpp"
+#include "Selection.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace rdb::engine {
+// Column loops behind WHERE: each sets the bit of every row whose values
+// satisfy the comparison and clears the others. The operator is a template
+// argument, so the loop body is a single comparison; rows are done 64 at a
+// time, building each word of the selection in a register. Values of
+// different numeric types compare as the type common to both.
+
+// values[row] Op constant, for rows in [0, selection.rows()). A long column
+// against a long, and a real column against any number, go to the vector
+// kernels of FilterKernels.hpp.
+template <parser::CompareOp Op, typename Values, typename T>
+void filter_constant(
+        const Values& values, const T& constant, Selection& selection)
+{
+    using Value = std::decay_t<decltype(values[0])>;
+    using Common = std::common_type_t<Value, T>;
+    if constexpr (
+            std::is_same_v<Values, std::vector<Common>>
+            && (std::is_same_v<Common, long>
+                || std::is_same_v<Common, double>)) {
+        filter_constant(Op, values.data(), Common(constant), selection);
+    } else {
+        const Common bound = constant;
+        uint64_t* words = selection.words();
+        size_t rows = selection.rows();
+        for (size_t base = 0; base < rows; base += 64) {
+            size_t count = std::min<size_t>(64, rows - base);
+            uint64_t word = 0;
+            for (size_t bit = 0; bit < count; bit++) {
+                word |= uint64_t{parser::compare<Op, Common>(
+                                values[base + bit], bound)}
+                        << bit;
+            }
+            words[base / 64] = word;
+        }
+    }
+}
+
+// left[row] Op right[row].
+template <parser::CompareOp Op, typename Left, typename Right>
+void filter_columns(const Left& left, const Right& right, Selection& selection)
+{
+    using LeftValue = std::decay_t<decltype(left[0])>;
+    using RightValue = std::decay_t<decltype(right[0])>;
+    using Common = std::common_type_t<LeftValue, RightValue>;
+    uint64_t* words = selection.words();
+    size_t rows = selection.rows();
+    for (size_t base = 0; base < rows; base += 64) {
+        size_t count = std::min<size_t>(64, rows - base);
+        uint64_t word = 0;
+        for (size_t bit = 0; bit < count; bit++) {
+            word |= uint64_t{parser::compare<Op, Common>(
+                            left[base + bit], right[base + bit])}
+                    << bit;
+        }
+        words[base / 64] = word;
+    }
+}
+} // namespace rdb::engine
@@ -0,0 +1,227 @@
+#include "FilterKernels.hpp"
+#include "librdb/Simd.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(RDB_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+using rdb::SimdLevel;
+using rdb::engine::Selection;
+using rdb::parser::CompareOp;
+
+namespace {
+// Not-equal, at-most and at-least are computed as the complement of equal,
+// greater and less, which is all the integer comparisons there are.
+constexpr bool negated(CompareOp op)
+{
+    return op == CompareOp::NotEqual || op == CompareOp::LessEqual
+            || op == CompareOp::GreaterEqual;
+}
+
+// One vector of values compared with the constant, as a lane mask holding
+// one bit per value, the first in the lowest bit.
+template <CompareOp Op>
+struct Lanes {
+#if defined(RDB_SIMD_SSE2)
+    static unsigned sse2(__m128d values, __m128d constant)
+    {
+        return static_cast<unsigned>(
+                _mm_movemask_pd(compare(values, constant)));
+    }
+
+    static __m128d compare(__m128d values, __m128d constant)
+    {
+        if constexpr (Op == CompareOp::Equal) {
+            return _mm_cmpeq_pd(values, constant);
+        } else if constexpr (Op == CompareOp::NotEqual) {
+            return _mm_cmpneq_pd(values, constant);
+        } else if constexpr (Op == CompareOp::Less) {
+            return _mm_cmplt_pd(values, constant);
+        } else if constexpr (Op == CompareOp::LessEqual) {
+            return _mm_cmple_pd(values, constant);
+        } else if constexpr (Op == CompareOp::Greater) {
+            return _mm_cmpgt_pd(values, constant);
+        } else {
+            return _mm_cmpge_pd(values, constant);
+        }
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static unsigned avx2(__m256i values, __m256i constant)
+    {
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(
+                _mm256_castsi256_pd(compare(values, constant))));
+        return negated(Op) ? mask ^ 0xfU : mask;
+    }
+
+    RDB_TARGET_AVX2 static __m256i compare(__m256i values, __m256i constant)
+    {
+        if constexpr (Op == CompareOp::Equal || Op == CompareOp::NotEqual) {
+            return _mm256_cmpeq_epi64(values, constant);
+        } else if constexpr (
+                Op == CompareOp::Greater || Op == CompareOp::LessEqual) {
+            return _mm256_cmpgt_epi64(values, constant);
+        } else {
+            return _mm256_cmpgt_epi64(constant, values);
+        }
+    }
+
+    // Ordered predicates except for not-equal, so that a NaN satisfies
+    // nothing but != as in scalar code.
+    RDB_TARGET_AVX2 static unsigned avx2(__m256d values, __m256d constant)
+    {
+        constexpr int Predicate = Op == CompareOp::Equal ? _CMP_EQ_OQ
+                : Op == CompareOp::NotEqual              ? _CMP_NEQ_UQ
+                : Op == CompareOp::Less                  ? _CMP_LT_OQ
+                : Op == CompareOp::LessEqual             ? _CMP_LE_OQ
+                : Op == CompareOp::Greater               ? _CMP_GT_OQ
+                                                         : _CMP_GE_OQ;
+        return static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_cmp_pd(values, constant, Predicate)));
+    }
+#endif
+};
+
+// Rows [base, rows) a word at a time; base is a multiple of 64.
+template <CompareOp Op, typename T>
+void filter_scalar(
+        const T* values, T constant, uint64_t* words, size_t base, size_t rows)
+{
+    for (; base < rows; base += 64) {
+        size_t count = std::min<size_t>(64, rows - base);
+        uint64_t word = 0;
+        for (size_t bit = 0; bit < count; bit++) {
+            word |= uint64_t{rdb::parser::compare<Op>(
+                            values[base + bit], constant)}
+                    << bit;
+        }
+        words[base / 64] = word;
+    }
+}
+
+#if defined(RDB_SIMD_SSE2)
+template <CompareOp Op>
+void filter_sse2(
+        const double* values, double constant, uint64_t* words, size_t rows)
+{
+    __m128d bound = _mm_set1_pd(constant);
+    size_t base = 0;
+    for (; rows - base >= 64; base += 64) {
+        uint64_t word = 0;
+        for (unsigned lane = 0; lane < 64; lane += 2) {
+            __m128d chunk = _mm_loadu_pd(values + base + lane);
+            word |= uint64_t{Lanes<Op>::sse2(chunk, bound)} << lane;
+        }
+        words[base / 64] = word;
+    }
+    filter_scalar<Op>(values, constant, words, base, rows);
+}
+#endif
+
+#if defined(RDB_SIMD_AVX2)
+RDB_TARGET_AVX2 __m256i broadcast_avx2(long constant)
+{
+    return _mm256_set1_epi64x(constant);
+}
+
+RDB_TARGET_AVX2 __m256d broadcast_avx2(double constant)
+{
+    return _mm256_set1_pd(constant);
+}
+
+RDB_TARGET_AVX2 __m256i load_avx2(const long* values)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+}
+
+RDB_TARGET_AVX2 __m256d load_avx2(const double* values)
+{
+    return _mm256_loadu_pd(values);
+}
+
+template <CompareOp Op, typename T>
+RDB_TARGET_AVX2 void
+filter_avx2(const T* values, T constant, uint64_t* words, size_t rows)
+{
+    auto bound = broadcast_avx2(constant);
+    size_t base = 0;
+    for (; rows - base >= 64; base += 64) {
+        uint64_t word = 0;
+        for (unsigned lane = 0; lane < 64; lane += 4) {
+            auto chunk = load_avx2(values + base + lane);
+            word |= uint64_t{Lanes<Op>::avx2(chunk, bound)} << lane;
+        }
+        words[base / 64] = word;
+    }
+    filter_scalar<Op>(values, constant, words, base, rows);
+}
+#endif
+
+template <CompareOp Op, typename T>
+void filter(const T* values, T constant, Selection& selection)
+{
+    uint64_t* words = selection.words();
+    size_t rows = selection.rows();
+    switch (rdb::simd_level()) {
+#if defined(RDB_SIMD_AVX2)
+    case SimdLevel::Avx2:
+        // The integer lanes are 64 bits wide, which long is not everywhere.
+        if constexpr (sizeof(T) == sizeof(int64_t)) {
+            filter_avx2<Op>(values, constant, words, rows);
+            return;
+        }
+        break;
+#endif
+#if defined(RDB_SIMD_SSE2)
+    case SimdLevel::Sse2:
+        if constexpr (std::is_same_v<T, double>) {
+            filter_sse2<Op>(values, constant, words, rows);
+            return;
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+    filter_scalar<Op>(values, constant, words, 0, rows);
+}
+
+// The operator is only known at run time here; each one gets its own loop.
+template <typename T>
+void filter(CompareOp op, const T* values, T constant, Selection& selection)
+{
+    switch (op) {
+    case CompareOp::Equal:
+        return filter<CompareOp::Equal>(values, constant, selection);
+    case CompareOp::NotEqual:
+        return filter<CompareOp::NotEqual>(values, constant, selection);
+    case CompareOp::Less:
+        return filter<CompareOp::Less>(values, constant, selection);
+    case CompareOp::LessEqual:
+        return filter<CompareOp::LessEqual>(values, constant, selection);
+    case CompareOp::Greater:
+        return filter<CompareOp::Greater>(values, constant, selection);
+    case CompareOp::GreaterEqual:
+        return filter<CompareOp::GreaterEqual>(values, constant, selection);
+    }
+}
+} // namespace
+
+void rdb::engine::filter_constant(
+        CompareOp op, const long* values, long constant, Selection& selection)
+{
+    filter(op, values, constant, selection);
+}
+
+void rdb::engine::filter_constant(
+        CompareOp op,
+        const double* values,
+        double constant,
+        Selection& selection)
+{
+    filter(op, values, constant, selection);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Selection.hpp"
+#include "librdb/parser/SqlStatement.hpp"
+
+namespace rdb::engine {
+// values[row] op constant over a numeric column, for rows in
+// [0, selection.rows()), setting the bits of the rows that satisfy it and
+// clearing the others. Each kernel compares 4 (AVX2) or 2 (SSE2) values per
+// step according to rdb::simd_level() and packs the lane masks straight into
+// the selection's words; the last partial word and non-x86 builds take a
+// scalar loop, and all levels give the same bits. SSE2 has no 64-bit integer
+// comparison, so long columns go from AVX2 straight to the scalar loop.
+void filter_constant(
+        parser::CompareOp op,
+        const long* values,
+        long constant,
+        Selection& selection);
+void filter_constant(
+        parser::CompareOp op,
+        const double* values,
+        double constant,
+        Selection& selection);
+} // namespace rdb::engine
@@ -0,0 +1,166 @@
+#include "HashIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+using rdb::engine::HashIndex;
+using rdb::engine::KeyView;
+using rdb::engine::Renumbering;
+
+namespace {
+// The finaliser of MurmurHash3, so that keys differing in their high bits
+// still land in different slots of a power-of-two table.
+size_t mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+}
+
+size_t hash_key(long key)
+{
+    return mix(static_cast<uint64_t>(key));
+}
+
+// -0.0 equals 0.0, so both must hash alike.
+size_t hash_key(double key)
+{
+    if (key == 0) {
+        key = 0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return mix(bits);
+}
+
+size_t hash_key(std::string_view key)
+{
+    return mix(std::hash<std::string_view>{}(key));
+}
+} // namespace
+
+template <typename Key>
+void HashIndex<Key>::insert(KeyView<Key> key, size_t row)
+{
+    if ((keys_ + 1) * 2 > slots_.size()) {
+        grow();
+    }
+    size_t hash = hash_key(key);
+    Slot& slot = slots_[find(key, hash)];
+    if (slot.row == Empty) {
+        slot.key = Key(key);
+        slot.hash = hash;
+        slot.row = row;
+        keys_++;
+    } else if (slot.more == 0) {
+        more_.push_back({row});
+        slot.more = more_.size();
+    } else {
+        more_[slot.more - 1].push_back(row);
+    }
+    size_++;
+}
+
+template <typename Key>
+void HashIndex<Key>::select(
+        KeyView<Key> key, std::vector<size_t>& rows) const
+{
+    if (slots_.empty()) {
+        return;
+    }
+    const Slot& slot = slots_[find(key, hash_key(key))];
+    if (slot.row == Empty) {
+        return;
+    }
+    rows.push_back(slot.row);
+    if (slot.more != 0) {
+        const auto& more = more_[slot.more - 1];
+        rows.insert(rows.end(), more.begin(), more.end());
+    }
+}
+
+// Rebuilt from the rows that are left: removing rows costs as much as the
+// pass over the columns that drops them anyway.
+template <typename Key>
+void HashIndex<Key>::remove_rows(const Renumbering& renumbering)
+{
+    std::vector<Slot> slots(slots_.size());
+    slots.swap(slots_);
+    std::vector<std::vector<size_t>> more;
+    more.swap(more_);
+    keys_ = 0;
+    size_ = 0;
+
+    std::vector<size_t> rows;
+    for (auto& slot : slots) {
+        if (slot.row == Empty) {
+            continue;
+        }
+        rows.clear();
+        auto keep = [&rows, &renumbering](size_t row) {
+            size_t renumbered = renumbering(row);
+            if (renumbered != Renumbering::Removed) {
+                rows.push_back(renumbered);
+            }
+        };
+        keep(slot.row);
+        if (slot.more != 0) {
+            std::for_each(
+                    more[slot.more - 1].begin(),
+                    more[slot.more - 1].end(),
+                    keep);
+        }
+        if (rows.empty()) {
+            continue;
+        }
+
+        Slot& kept = slots_[find(slot.key, slot.hash)];
+        kept.key = std::move(slot.key);
+        kept.hash = slot.hash;
+        kept.row = rows.front();
+        if (rows.size() > 1) {
+            more_.emplace_back(rows.begin() + 1, rows.end());
+            kept.more = more_.size();
+        }
+        keys_++;
+        size_ += rows.size();
+    }
+}
+
+template <typename Key>
+size_t HashIndex<Key>::size() const
+{
+    return size_;
+}
+
+template <typename Key>
+size_t HashIndex<Key>::find(KeyView<Key> key, size_t hash) const
+{
+    size_t mask = slots_.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        const Slot& slot = slots_[index];
+        if ((slot.row == Empty) || ((slot.hash == hash) && (slot.key == key))) {
+            return index;
+        }
+    }
+}
+
+template <typename Key>
+void HashIndex<Key>::grow()
+{
+    std::vector<Slot> slots(std::max<size_t>(16, slots_.size() * 2));
+    slots.swap(slots_);
+    for (auto& slot : slots) {
+        if (slot.row != Empty) {
+            slots_[find(slot.key, slot.hash)] = std::move(slot);
+        }
+    }
+}
+
+template class rdb::engine::HashIndex<long>;
+template class rdb::engine::HashIndex<double>;
+template class rdb::engine::HashIndex<std::string>;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Selection.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace rdb::engine {
+// What an index over Key values is searched with; text is looked up by view.
+template <typename Key>
+using KeyView = std::conditional_t<
+        std::is_same_v<Key, std::string>,
+        std::string_view,
+        Key>;
+
+// The rows of a column by value, for equality lookups. Key is long, double
+// or std::string. Values go in one open-addressing table probed linearly,
+// at most half full; a slot holds a value with its hash and its first row,
+// so that looking up a value held by one row reads a single slot. The other
+// rows of a repeated value are listed apart.
+template <typename Key>
+class HashIndex {
+public:
+    using key_type = Key;
+
+    void insert(KeyView<Key> key, size_t row);
+    // Appends the rows holding key, in order.
+    void select(KeyView<Key> key, std::vector<size_t>& rows) const;
+    // Forgets the removed rows and renumbers the others.
+    void remove_rows(const Renumbering& renumbering);
+    // How many rows are indexed.
+    size_t size() const;
+
+private:
+    static constexpr size_t Empty = SIZE_MAX;
+
+    struct Slot {
+        Key key{};
+        size_t hash = 0;
+        // The first row holding key, or Empty for a free slot.
+        size_t row = Empty;
+        // 1 + the index in more_ of the other rows holding key, or 0.
+        size_t more = 0;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<std::vector<size_t>> more_;
+    size_t keys_ = 0;
+    size_t size_ = 0;
+
+    // The slot holding key, or the free one where it would go.
+    size_t find(KeyView<Key> key, size_t hash) const;
+    void grow();
+};
+} // namespace rdb::engine
@@ -0,0 +1,161 @@
+#include "Index.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+using rdb::engine::Column;
+using rdb::engine::HashIndex;
+using rdb::engine::Index;
+using rdb::engine::KeyView;
+using rdb::engine::OrderedIndex;
+using rdb::engine::Renumbering;
+using rdb::engine::Selection;
+using rdb::parser::CompareOp;
+using rdb::parser::IndexKind;
+
+namespace {
+template <typename Keys>
+using KeyViewOf = KeyView<typename Keys::key_type>;
+
+template <typename Key>
+void find_rows(
+        const HashIndex<Key>& keys,
+        CompareOp,
+        KeyView<Key> key,
+        std::vector<size_t>& rows)
+{
+    keys.select(key, rows);
+}
+
+template <typename Key>
+void find_rows(
+        const OrderedIndex<Key>& keys,
+        CompareOp op,
+        KeyView<Key> key,
+        std::vector<size_t>& rows)
+{
+    keys.select(op, key, rows);
+}
+} // namespace
+
+Index::Index(
+        std::string name, size_t column, IndexKind kind, const Column& values)
+    : name_{std::move(name)}, column_{column}, kind_{kind}
+{
+    switch (values.index() + (kind == IndexKind::Ordered ? 3 : 0)) {
+    case 0:
+        keys_.emplace<0>();
+        break;
+    case 1:
+        keys_.emplace<1>();
+        break;
+    case 2:
+        keys_.emplace<2>();
+        break;
+    case 3:
+        keys_.emplace<3>();
+        break;
+    case 4:
+        keys_.emplace<4>();
+        break;
+    default:
+        keys_.emplace<5>();
+        break;
+    }
+    append(values, 0);
+}
+
+const std::string& Index::name() const
+{
+    return name_;
+}
+
+size_t Index::column() const
+{
+    return column_;
+}
+
+IndexKind Index::kind() const
+{
+    return kind_;
+}
+
+bool Index::answers(CompareOp op) const
+{
+    return (op != CompareOp::NotEqual)
+            && ((kind_ == IndexKind::Ordered) || (op == CompareOp::Equal));
+}
+
+void Index::append(const Column& values, size_t first)
+{
+    std::visit(
+            [first](auto& keys, auto&& column) {
+                using Value = std::decay_t<decltype(column[0])>;
+                using Keys = std::decay_t<decltype(keys)>;
+                if constexpr (std::is_same_v<KeyViewOf<Keys>, Value>) {
+                    for (size_t row = first; row < column.size(); row++) {
+                        keys.insert(column[row], row);
+                    }
+                }
+            },
+            keys_,
+            values);
+}
+
+void Index::remove_rows(const Selection& removed)
+{
+    Renumbering renumbering(removed);
+    std::visit(
+            [&renumbering](auto& keys) { keys.remove_rows(renumbering); },
+            keys_);
+}
+
+bool Index::select(
+        CompareOp op, long constant, std::vector<size_t>& rows) const
+{
+    return lookup(op, constant, rows);
+}
+
+bool Index::select(
+        CompareOp op, double constant, std::vector<size_t>& rows) const
+{
+    return lookup(op, constant, rows);
+}
+
+bool Index::select(
+        CompareOp op,
+        std::string_view constant,
+        std::vector<size_t>& rows) const
+{
+    return lookup(op, constant, rows);
+}
+
+template <typename T>
+bool Index::lookup(CompareOp op, T constant, std::vector<size_t>& rows) const
+{
+    if (!answers(op)) {
+        return false;
+    }
+    size_t first = rows.size();
+    bool found = std::visit(
+            [op, constant, &rows](auto& keys) {
+                using View = KeyViewOf<std::decay_t<decltype(keys)>>;
+                constexpr bool widened = std::is_same_v<View, double>
+                        && std::is_same_v<T, long>;
+                if constexpr (std::is_same_v<View, T> || widened) {
+                    find_rows(keys, op, static_cast<View>(constant), rows);
+                    return true;
+                } else {
+                    return false;
+                }
+            },
+            keys_);
+    // A range comes in order of value; the rows of one value already come
+    // in order.
+    if (op != CompareOp::Equal) {
+        auto from = rows.begin() + static_cast<std::ptrdiff_t>(first);
+        std::sort(from, rows.end());
+    }
+    return found;
+}
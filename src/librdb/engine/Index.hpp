@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Column.hpp"
+#include "HashIndex.hpp"
+#include "OrderedIndex.hpp"
+#include "Selection.hpp"
+#include "librdb/parser/SqlStatement.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace rdb::engine {
+// A secondary index on one column of a table, built by CREATE [HASH] INDEX:
+// a HashIndex or an OrderedIndex of the column's type. The table keeps it up
+// to date as rows are added and removed.
+class Index {
+public:
+    // Indexes every row values already holds.
+    Index(std::string name,
+          size_t column,
+          parser::IndexKind kind,
+          const Column& values);
+
+    const std::string& name() const;
+    size_t column() const;
+    parser::IndexKind kind() const;
+    // Whether the index can find the rows of column op constant: a hash
+    // index only answers =, and no index answers !=.
+    bool answers(parser::CompareOp op) const;
+
+    // Indexes rows [first, column_rows(values)) of the column, just added.
+    void append(const Column& values, size_t first);
+    // Forgets the removed rows and renumbers the others, as the table does.
+    void remove_rows(const Selection& removed);
+
+    // Appends the rows where column op constant, in order, and returns true,
+    // or returns false if the index cannot tell: it does not answer op, or
+    // constant is not of the column's type. A long constant is looked up in
+    // a REAL column as a double, as the comparison would convert it.
+    bool select(
+            parser::CompareOp op, long constant, std::vector<size_t>& rows)
+            const;
+    bool select(
+            parser::CompareOp op, double constant, std::vector<size_t>& rows)
+            const;
+    bool select(
+            parser::CompareOp op,
+            std::string_view constant,
+            std::vector<size_t>& rows) const;
+
+private:
+    std::string name_;
+    size_t column_;
+    parser::IndexKind kind_;
+    // In the order of Column's alternatives, hashed then ordered.
+    std::variant<
+            HashIndex<long>,
+            HashIndex<double>,
+            HashIndex<std::string>,
+            OrderedIndex<long>,
+            OrderedIndex<double>,
+            OrderedIndex<std::string>>
+            keys_;
+
+    template <typename T>
+    bool lookup(parser::CompareOp op, T constant, std::vector<size_t>& rows)
+            const;
+};
+} // namespace rdb::engine
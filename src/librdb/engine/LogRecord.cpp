@@ -0,0 +1,113 @@
+#include "LogRecord.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using rdb::engine::Column;
+using rdb::engine::RecordReader;
+using rdb::engine::RecordType;
+using rdb::engine::RecordWriter;
+using rdb::engine::TextColumn;
+
+namespace {
+[[noreturn]] void throw_too_short()
+{
+    throw std::runtime_error("log record ends too soon");
+}
+} // namespace
+
+RecordWriter::RecordWriter(std::string& bytes, RecordType type)
+    : bytes_{bytes}
+{
+    bytes_.push_back(static_cast<char>(type));
+}
+
+void RecordWriter::put(uint64_t number)
+{
+    char buffer[sizeof(number)];
+    std::memcpy(buffer, &number, sizeof(number));
+    bytes_.append(buffer, sizeof(number));
+}
+
+void RecordWriter::put(std::string_view text)
+{
+    put(static_cast<uint64_t>(text.size()));
+    bytes_.append(text);
+}
+
+// Numbers go as one block; texts one after another, each with its length.
+void RecordWriter::put(const Column& column, size_t first)
+{
+    std::visit(
+            [this, first](auto&& values) {
+                using Values = std::decay_t<decltype(values)>;
+                if constexpr (std::is_same_v<Values, TextColumn>) {
+                    for (size_t row = first; row < values.size(); row++) {
+                        put(values[row]);
+                    }
+                } else {
+                    bytes_.append(
+                            reinterpret_cast<const char*>(
+                                    values.data() + first),
+                            (values.size() - first) * sizeof(values[0]));
+                }
+            },
+            column);
+}
+
+RecordReader::RecordReader(std::string_view bytes) : bytes_{bytes}
+{
+    type_ = static_cast<RecordType>(take(1)[0]);
+}
+
+RecordType RecordReader::type() const
+{
+    return type_;
+}
+
+uint64_t RecordReader::number()
+{
+    uint64_t number = 0;
+    std::memcpy(&number, take(sizeof(number)).data(), sizeof(number));
+    return number;
+}
+
+std::string_view RecordReader::text()
+{
+    return take(number());
+}
+
+void RecordReader::append_to(Column& column, size_t rows)
+{
+    std::visit(
+            [this, rows](auto&& values) {
+                using Values = std::decay_t<decltype(values)>;
+                if constexpr (std::is_same_v<Values, TextColumn>) {
+                    for (size_t row = 0; row < rows; row++) {
+                        values.push_back(text());
+                    }
+                } else {
+                    using Value = typename Values::value_type;
+                    if (rows > bytes_.size() / sizeof(Value)) {
+                        throw_too_short();
+                    }
+                    std::string_view block = take(rows * sizeof(Value));
+                    size_t size = values.size();
+                    values.resize(size + rows);
+                    std::memcpy(
+                            values.data() + size, block.data(), block.size());
+                }
+            },
+            column);
+}
+
+std::string_view RecordReader::take(size_t size)
+{
+    if (size > bytes_.size()) {
+        throw_too_short();
+    }
+    std::string_view taken = bytes_.substr(0, size);
+    bytes_.remove_prefix(size);
+    return taken;
+}
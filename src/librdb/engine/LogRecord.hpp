@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Column.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace rdb::engine {
+// What a record in the write-ahead log of a Database describes: one change
+// that a statement made to its tables. Records hold the change itself, not
+// the statement, so that replaying them neither parses nor evaluates WHERE
+// clauses: an INSERT is logged as the values it stored, and a DELETE as the
+// numbers of the rows it removed.
+enum class RecordType : uint8_t {
+    CreateTable = 1,
+    DropTable,
+    CreateIndex,
+    Insert,
+    Delete,
+};
+
+// Appends the fields of a record to bytes, in the order they are to be read
+// back. Numbers are written in the byte order of the machine.
+class RecordWriter {
+public:
+    RecordWriter(std::string& bytes, RecordType type);
+
+    void put(uint64_t number);
+    void put(std::string_view text);
+    // Rows [first, column_rows(column)) of column.
+    void put(const Column& column, size_t first);
+
+private:
+    std::string& bytes_;
+};
+
+// Reads back the fields of a record in the order RecordWriter put them.
+// Throws std::runtime_error on reading past the end of the record.
+class RecordReader {
+public:
+    explicit RecordReader(std::string_view bytes);
+
+    RecordType type() const;
+    uint64_t number();
+    // Valid as long as the record's bytes are.
+    std::string_view text();
+    // Appends to column the rows values written for a column of its type.
+    void append_to(Column& column, size_t rows);
+
+private:
+    std::string_view bytes_;
+    RecordType type_;
+
+    std::string_view take(size_t size);
+};
+} // namespace rdb::engine
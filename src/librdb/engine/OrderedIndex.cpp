@@ -0,0 +1,341 @@
+#include "OrderedIndex.hpp"
+#include <algorithm>
+#include <iterator>
+
+using rdb::engine::KeyView;
+using rdb::engine::OrderedIndex;
+using rdb::engine::Renumbering;
+using rdb::parser::CompareOp;
+
+namespace {
+// Entries, (value, row), in the order of the tree.
+template <typename Left, typename Right>
+bool entry_less(
+        const Left& left_key,
+        size_t left_row,
+        const Right& right_key,
+        size_t right_row)
+{
+    if (left_key < right_key) {
+        return true;
+    }
+    if (right_key < left_key) {
+        return false;
+    }
+    return left_row < right_row;
+}
+
+// Where (key, row) goes among the first count entries of node.
+template <typename Node, typename Key>
+size_t entry_position(const Node& node, const Key& key, size_t row)
+{
+    size_t low = 0;
+    size_t high = node.count;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (entry_less(key, row, node.keys[middle], node.rows[middle])) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+// How many of the first count values of node are below key, or not above it
+// if after is true.
+template <typename Node, typename Key>
+size_t value_position(const Node& node, const Key& key, bool after)
+{
+    auto end = node.keys.begin() + node.count;
+    return static_cast<size_t>(
+            (after ? std::upper_bound(node.keys.begin(), end, key)
+                   : std::lower_bound(node.keys.begin(), end, key))
+            - node.keys.begin());
+}
+
+// Nodes are filled to three quarters when built, leaving room for inserts.
+constexpr size_t BuildFill(size_t fanout)
+{
+    return fanout * 3 / 4;
+}
+} // namespace
+
+template <typename Key>
+OrderedIndex<Key>::OrderedIndex() : leaves_(1)
+{
+}
+
+template <typename Key>
+void OrderedIndex<Key>::insert(KeyView<Key> key, size_t row)
+{
+    auto split = insert_into(root_, height_, key, row);
+    if (split) {
+        Inner root{};
+        root.keys[0] = std::move(split->key);
+        root.rows[0] = split->row;
+        root.children[0] = root_;
+        root.children[1] = split->node;
+        root.count = 1;
+        inners_.push_back(std::move(root));
+        root_ = static_cast<uint32_t>(inners_.size() - 1);
+        height_++;
+    }
+    size_++;
+}
+
+template <typename Key>
+auto OrderedIndex<Key>::insert_into(
+        uint32_t node, size_t level, KeyView<Key> key, size_t row)
+        -> std::optional<Split>
+{
+    if (level == 0) {
+        return insert_into_leaf(node, key, row);
+    }
+    size_t child = entry_position(inners_[node], key, row);
+    auto split
+            = insert_into(inners_[node].children[child], level - 1, key, row);
+    if (!split) {
+        return std::nullopt;
+    }
+    return insert_into_inner(node, child, std::move(*split));
+}
+
+template <typename Key>
+auto OrderedIndex<Key>::insert_into_leaf(
+        uint32_t node, KeyView<Key> key, size_t row) -> std::optional<Split>
+{
+    size_t position = entry_position(leaves_[node], key, row);
+    std::optional<Split> split;
+    if (leaves_[node].count == Fanout) {
+        // Values inserted in order land at the end of the last leaf, which
+        // is then left full rather than split in half.
+        size_t keep = (position == Fanout) ? Fanout : Fanout / 2;
+        leaves_.emplace_back();
+        uint32_t right_node = static_cast<uint32_t>(leaves_.size() - 1);
+        Leaf& left = leaves_[node];
+        Leaf& right = leaves_[right_node];
+        std::move(
+                left.keys.begin() + keep,
+                left.keys.end(),
+                right.keys.begin());
+        std::copy(
+                left.rows.begin() + keep,
+                left.rows.end(),
+                right.rows.begin());
+        right.count = static_cast<uint32_t>(Fanout - keep);
+        left.count = static_cast<uint32_t>(keep);
+        right.next = left.next;
+        left.next = right_node;
+        if (position > keep || keep == Fanout) {
+            node = right_node;
+            position -= keep;
+        }
+        split = Split{Key{}, 0, right_node};
+    }
+
+    Leaf& leaf = leaves_[node];
+    std::move_backward(
+            leaf.keys.begin() + position,
+            leaf.keys.begin() + leaf.count,
+            leaf.keys.begin() + leaf.count + 1);
+    std::copy_backward(
+            leaf.rows.begin() + position,
+            leaf.rows.begin() + leaf.count,
+            leaf.rows.begin() + leaf.count + 1);
+    leaf.keys[position] = Key(key);
+    leaf.rows[position] = row;
+    leaf.count++;
+
+    if (split) {
+        const Leaf& right = leaves_[split->node];
+        split->key = right.keys[0];
+        split->row = right.rows[0];
+    }
+    return split;
+}
+
+template <typename Key>
+auto OrderedIndex<Key>::insert_into_inner(
+        uint32_t node, size_t position, Split&& split) -> std::optional<Split>
+{
+    Inner& inner = inners_[node];
+    if (inner.count < Fanout) {
+        std::move_backward(
+                inner.keys.begin() + position,
+                inner.keys.begin() + inner.count,
+                inner.keys.begin() + inner.count + 1);
+        std::copy_backward(
+                inner.rows.begin() + position,
+                inner.rows.begin() + inner.count,
+                inner.rows.begin() + inner.count + 1);
+        std::copy_backward(
+                inner.children.begin() + position + 1,
+                inner.children.begin() + inner.count + 1,
+                inner.children.begin() + inner.count + 2);
+        inner.keys[position] = std::move(split.key);
+        inner.rows[position] = split.row;
+        inner.children[position + 1] = split.node;
+        inner.count++;
+        return std::nullopt;
+    }
+
+    // Full: the Fanout + 1 separators are laid out in order, the middle one
+    // moves up and the right half goes to a new node.
+    std::vector<Key> keys(
+            std::make_move_iterator(inner.keys.begin()),
+            std::make_move_iterator(inner.keys.end()));
+    std::vector<size_t> rows(inner.rows.begin(), inner.rows.end());
+    std::vector<uint32_t> children(
+            inner.children.begin(), inner.children.end());
+    keys.insert(keys.begin() + position, std::move(split.key));
+    rows.insert(rows.begin() + position, split.row);
+    children.insert(children.begin() + position + 1, split.node);
+
+    size_t middle = keys.size() / 2;
+    inners_.emplace_back();
+    uint32_t right_node = static_cast<uint32_t>(inners_.size() - 1);
+    Inner& left = inners_[node];
+    Inner& right = inners_[right_node];
+    std::move(keys.begin(), keys.begin() + middle, left.keys.begin());
+    std::copy(rows.begin(), rows.begin() + middle, left.rows.begin());
+    std::copy(
+            children.begin(),
+            children.begin() + middle + 1,
+            left.children.begin());
+    left.count = static_cast<uint32_t>(middle);
+    std::move(keys.begin() + middle + 1, keys.end(), right.keys.begin());
+    std::copy(rows.begin() + middle + 1, rows.end(), right.rows.begin());
+    std::copy(
+            children.begin() + middle + 1,
+            children.end(),
+            right.children.begin());
+    right.count = static_cast<uint32_t>(keys.size() - middle - 1);
+    return Split{std::move(keys[middle]), rows[middle], right_node};
+}
+
+template <typename Key>
+std::pair<uint32_t, size_t>
+OrderedIndex<Key>::seek(KeyView<Key> key, bool after) const
+{
+    uint32_t node = root_;
+    for (size_t level = height_; level > 0; level--) {
+        const Inner& inner = inners_[node];
+        node = inner.children[value_position(inner, key, after)];
+    }
+    return {node, value_position(leaves_[node], key, after)};
+}
+
+template <typename Key>
+void OrderedIndex<Key>::select(
+        CompareOp op, KeyView<Key> key, std::vector<size_t>& rows) const
+{
+    uint32_t node = 0;
+    size_t position = 0;
+    if (op == CompareOp::Equal || op == CompareOp::GreaterEqual) {
+        std::tie(node, position) = seek(key, false);
+    } else if (op == CompareOp::Greater) {
+        std::tie(node, position) = seek(key, true);
+    }
+    for (; node != None; node = leaves_[node].next, position = 0) {
+        const Leaf& leaf = leaves_[node];
+        for (; position < leaf.count; position++) {
+            const Key& value = leaf.keys[position];
+            bool past = (op == CompareOp::Equal || op == CompareOp::LessEqual)
+                    ? key < value
+                    : (op == CompareOp::Less) && !(value < key);
+            if (past) {
+                return;
+            }
+            rows.push_back(leaf.rows[position]);
+        }
+    }
+}
+
+// Rebuilt from the entries that are left, which stay in order as rows keep
+// theirs: removing rows costs as much as the pass over the columns that
+// drops them anyway.
+template <typename Key>
+void OrderedIndex<Key>::remove_rows(const Renumbering& renumbering)
+{
+    std::vector<Key> keys;
+    std::vector<size_t> rows;
+    keys.reserve(size_);
+    rows.reserve(size_);
+    for (uint32_t node = 0; node != None; node = leaves_[node].next) {
+        Leaf& leaf = leaves_[node];
+        for (size_t position = 0; position < leaf.count; position++) {
+            size_t row = renumbering(leaf.rows[position]);
+            if (row != Renumbering::Removed) {
+                keys.push_back(std::move(leaf.keys[position]));
+                rows.push_back(row);
+            }
+        }
+    }
+    build(std::move(keys), std::move(rows));
+}
+
+template <typename Key>
+size_t OrderedIndex<Key>::size() const
+{
+    return size_;
+}
+
+template <typename Key>
+void OrderedIndex<Key>::build(
+        std::vector<Key>&& keys, std::vector<size_t>&& rows)
+{
+    constexpr size_t PerLeaf = BuildFill(Fanout);
+    constexpr size_t PerInner = BuildFill(Fanout) + 1;
+    size_ = keys.size();
+    leaves_.assign(std::max<size_t>(1, (size_ + PerLeaf - 1) / PerLeaf), {});
+    inners_.clear();
+
+    // The nodes of the level being built, and the index in keys of the
+    // first entry under each.
+    std::vector<uint32_t> nodes;
+    std::vector<size_t> firsts;
+    for (size_t node = 0; node < leaves_.size(); node++) {
+        Leaf& leaf = leaves_[node];
+        size_t first = node * PerLeaf;
+        size_t last = std::min(size_, first + PerLeaf);
+        for (size_t entry = first; entry < last; entry++) {
+            leaf.keys[entry - first] = keys[entry];
+            leaf.rows[entry - first] = rows[entry];
+        }
+        leaf.count = static_cast<uint32_t>(last - first);
+        leaf.next = (node + 1 < leaves_.size())
+                ? static_cast<uint32_t>(node + 1)
+                : None;
+        nodes.push_back(static_cast<uint32_t>(node));
+        firsts.push_back(first);
+    }
+
+    height_ = 0;
+    while (nodes.size() > 1) {
+        std::vector<uint32_t> parents;
+        std::vector<size_t> parent_firsts;
+        for (size_t child = 0; child < nodes.size(); child += PerInner) {
+            size_t last = std::min(nodes.size(), child + PerInner);
+            Inner inner{};
+            inner.children[0] = nodes[child];
+            for (size_t next = child + 1; next < last; next++) {
+                inner.keys[inner.count] = keys[firsts[next]];
+                inner.rows[inner.count] = rows[firsts[next]];
+                inner.children[inner.count + 1] = nodes[next];
+                inner.count++;
+            }
+            inners_.push_back(std::move(inner));
+            parents.push_back(static_cast<uint32_t>(inners_.size() - 1));
+            parent_firsts.push_back(firsts[child]);
+        }
+        nodes.swap(parents);
+        firsts.swap(parent_firsts);
+        height_++;
+    }
+    root_ = nodes.front();
+}
+
+template class rdb::engine::OrderedIndex<long>;
+template class rdb::engine::OrderedIndex<double>;
+template class rdb::engine::OrderedIndex<std::string>;
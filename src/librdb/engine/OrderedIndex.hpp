@@ -0,0 +1,87 @@
+#pragma once
+
+#include "HashIndex.hpp"
+#include "Selection.hpp"
+#include "librdb/parser/SqlStatement.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rdb::engine {
+// The rows of a column in order of value, for range and equality lookups:
+// a B+tree whose nodes hold up to Fanout entries side by side. Key is long,
+// double or std::string. Nodes live in two pools and refer to each other by
+// position; the leaves are chained in order, so a range is read leaf after
+// leaf once its first entry is found. Entries are ordered by value and then
+// by row, which makes every entry distinct even where values repeat.
+template <typename Key>
+class OrderedIndex {
+public:
+    using key_type = Key;
+
+    static constexpr size_t Fanout = 64;
+
+    OrderedIndex();
+
+    void insert(KeyView<Key> key, size_t row);
+    // Appends the rows whose value v satisfies v op key, in order of value
+    // and then of row; op must not be NotEqual.
+    void select(
+            parser::CompareOp op,
+            KeyView<Key> key,
+            std::vector<size_t>& rows) const;
+    // Forgets the removed rows and renumbers the others.
+    void remove_rows(const Renumbering& renumbering);
+    // How many rows are indexed.
+    size_t size() const;
+
+private:
+    static constexpr uint32_t None = UINT32_MAX;
+
+    struct Leaf {
+        std::array<Key, Fanout> keys;
+        std::array<size_t, Fanout> rows;
+        uint32_t count = 0;
+        uint32_t next = None;
+    };
+
+    // count separators and count + 1 children; each separator is the first
+    // entry under the child to its right.
+    struct Inner {
+        std::array<Key, Fanout> keys;
+        std::array<size_t, Fanout> rows;
+        std::array<uint32_t, Fanout + 1> children;
+        uint32_t count = 0;
+    };
+
+    // A node split in two: the new right one and its first entry.
+    struct Split {
+        Key key;
+        size_t row;
+        uint32_t node;
+    };
+
+    // The leftmost leaf is always the first in leaves_.
+    std::vector<Leaf> leaves_;
+    std::vector<Inner> inners_;
+    uint32_t root_ = 0;
+    // Levels of inner nodes above the leaves.
+    size_t height_ = 0;
+    size_t size_ = 0;
+
+    std::optional<Split>
+    insert_into(uint32_t node, size_t level, KeyView<Key> key, size_t row);
+    std::optional<Split>
+    insert_into_leaf(uint32_t node, KeyView<Key> key, size_t row);
+    std::optional<Split>
+    insert_into_inner(uint32_t node, size_t position, Split&& split);
+    // The leaf and position of the first entry whose value is above key, or
+    // not below it if after is false.
+    std::pair<uint32_t, size_t> seek(KeyView<Key> key, bool after) const;
+    // Rebuilds the tree from entries sorted as the tree keeps them.
+    void build(std::vector<Key>&& keys, std::vector<size_t>&& rows);
+};
+} // namespace rdb::engine
@@ -0,0 +1,256 @@
+#include "PagedTable.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+using rdb::PageId;
+using rdb::Pager;
+using rdb::PinnedPage;
+using rdb::engine::Column;
+using rdb::engine::PagedTable;
+using rdb::engine::Table;
+using rdb::engine::TextColumn;
+
+namespace {
+// The number of rows, padded so that the values after it stay aligned.
+constexpr size_t HeaderSize = 8;
+
+// What row takes up in a page.
+size_t row_bytes(const Table& rows, size_t row)
+{
+    size_t bytes = 0;
+    for (size_t index = 0; index < rows.columns(); index++) {
+        bytes += std::visit(
+                [row](auto&& values) {
+                    using Values = std::decay_t<decltype(values)>;
+                    if constexpr (std::is_same_v<Values, TextColumn>) {
+                        return sizeof(uint32_t) + values[row].size();
+                    } else {
+                        return sizeof(values[row]);
+                    }
+                },
+                rows.column(index));
+    }
+    return bytes;
+}
+
+// How many rows from first on fit in one page, at most.
+size_t rows_that_fit(const Table& rows, size_t first)
+{
+    size_t bytes = HeaderSize;
+    size_t last = first;
+    while (last < rows.rows()) {
+        bytes += row_bytes(rows, last);
+        if (bytes > Pager::PageSize) {
+            break;
+        }
+        last++;
+    }
+    return last - first;
+}
+
+void encode(const Table& rows, size_t first, size_t last, char* page)
+{
+    auto count = static_cast<uint32_t>(last - first);
+    std::memset(page, 0, HeaderSize);
+    std::memcpy(page, &count, sizeof(count));
+    char* out = page + HeaderSize;
+    for (size_t index = 0; index < rows.columns(); index++) {
+        std::visit(
+                [first, last, count, &out](auto&& values) {
+                    using Values = std::decay_t<decltype(values)>;
+                    if constexpr (std::is_same_v<Values, TextColumn>) {
+                        char* bytes = out + count * sizeof(uint32_t);
+                        uint32_t end = 0;
+                        for (size_t row = first; row < last; row++) {
+                            std::string_view text = values[row];
+                            std::memcpy(bytes + end, text.data(), text.size());
+                            end += static_cast<uint32_t>(text.size());
+                            std::memcpy(out, &end, sizeof(end));
+                            out += sizeof(end);
+                        }
+                        out = bytes + end;
+                    } else {
+                        size_t size = count * sizeof(values[0]);
+                        std::memcpy(out, values.data() + first, size);
+                        out += size;
+                    }
+                },
+                rows.column(index));
+    }
+}
+
+Table decode(const Table& schema, const char* page)
+{
+    uint32_t count = 0;
+    std::memcpy(&count, page, sizeof(count));
+    const char* in = page + HeaderSize;
+    Table rows = schema;
+    rows.append_rows(count, [count, &in](size_t, Column& column) {
+        std::visit(
+                [count, &in](auto&& values) {
+                    using Values = std::decay_t<decltype(values)>;
+                    if constexpr (std::is_same_v<Values, TextColumn>) {
+                        const char* bytes = in + count * sizeof(uint32_t);
+                        uint32_t begin = 0;
+                        for (uint32_t row = 0; row < count; row++) {
+                            uint32_t end = 0;
+                            std::memcpy(&end, in, sizeof(end));
+                            in += sizeof(end);
+                            values.push_back({bytes + begin, end - begin});
+                            begin = end;
+                        }
+                        in = bytes + begin;
+                    } else {
+                        size_t size = count * sizeof(values[0]);
+                        values.resize(count);
+                        std::memcpy(values.data(), in, size);
+                        in += size;
+                    }
+                },
+                column);
+    });
+    return rows;
+}
+} // namespace
+
+PagedTable::PagedTable(Table schema, BufferPool& pool)
+    : schema_{std::move(schema)}, pool_{&pool}
+{
+    if (schema_.rows() != 0) {
+        throw std::invalid_argument("PagedTable: schema has rows");
+    }
+}
+
+PagedTable::PagedTable(PagedTable&& other) noexcept
+    : schema_{std::move(other.schema_)},
+      pool_{other.pool_},
+      page_ids_{std::exchange(other.page_ids_, {})},
+      page_rows_{std::exchange(other.page_rows_, {})},
+      rows_{std::exchange(other.rows_, 0)}
+{
+}
+
+PagedTable& PagedTable::operator=(PagedTable&& other) noexcept
+{
+    if (this != &other) {
+        clear();
+        schema_ = std::move(other.schema_);
+        pool_ = other.pool_;
+        page_ids_ = std::exchange(other.page_ids_, {});
+        page_rows_ = std::exchange(other.page_rows_, {});
+        rows_ = std::exchange(other.rows_, 0);
+    }
+    return *this;
+}
+
+PagedTable::~PagedTable()
+{
+    clear();
+}
+
+const Table& PagedTable::schema() const
+{
+    return schema_;
+}
+
+size_t PagedTable::rows() const
+{
+    return rows_;
+}
+
+size_t PagedTable::pages() const
+{
+    return page_ids_.size();
+}
+
+bool PagedTable::fits(const Table& rows) const
+{
+    for (size_t row = 0; row < rows.rows(); row++) {
+        if (HeaderSize + row_bytes(rows, row) > Pager::PageSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The last page is filled up first: its rows are read back and written
+// again followed by as many new ones as fit, and the rest go to new pages.
+void PagedTable::append(const Table& rows)
+{
+    if (!fits(rows)) {
+        throw std::length_error("PagedTable: row larger than a page");
+    }
+    size_t index = page_ids_.size();
+    Table staged = schema_;
+    if (index != 0) {
+        index--;
+        staged = page(index);
+    }
+    staged.append_rows(rows.rows(), [&rows](size_t column, Column& values) {
+        copy_rows(values, rows.column(column), 0, rows.rows());
+    });
+    for (size_t first = 0; first < staged.rows(); index++) {
+        size_t count = rows_that_fit(staged, first);
+        PinnedPage page = (index < page_ids_.size())
+                ? pool_->pin(page_ids_[index])
+                : pool_->pin_new();
+        encode(staged, first, first + count, page.data());
+        page.mark_dirty();
+        if (index == page_ids_.size()) {
+            page_ids_.push_back(page.id());
+            page_rows_.push_back(0);
+        }
+        page_rows_[index] = static_cast<uint32_t>(count);
+        first += count;
+    }
+    rows_ += rows.rows();
+}
+
+Table PagedTable::page(size_t index) const
+{
+    PinnedPage page = pool_->pin(page_ids_.at(index));
+    return decode(schema_, page.data());
+}
+
+void PagedTable::replace_page(size_t index, const Table& rows)
+{
+    if (rows.rows() > page_rows_.at(index)) {
+        throw std::invalid_argument("PagedTable: page would overflow");
+    }
+    rows_ = rows_ - page_rows_[index] + rows.rows();
+    if (rows.rows() == 0) {
+        pool_->free(page_ids_[index]);
+        page_ids_.erase(page_ids_.begin() + static_cast<std::ptrdiff_t>(index));
+        page_rows_.erase(
+                page_rows_.begin() + static_cast<std::ptrdiff_t>(index));
+        return;
+    }
+    PinnedPage page = pool_->pin(page_ids_[index]);
+    encode(rows, 0, rows.rows(), page.data());
+    page.mark_dirty();
+    page_rows_[index] = static_cast<uint32_t>(rows.rows());
+}
+
+void PagedTable::clear()
+{
+    for (PageId page : page_ids_) {
+        pool_->free(page);
+    }
+    page_ids_.clear();
+    page_rows_.clear();
+    rows_ = 0;
+}
+
+// The first call asks for two windows, and each later one for the window
+// after the one just entered, so reads stay a window ahead of the scan.
+void PagedTable::prefetch(size_t index) const
+{
+    size_t first = (index == 0) ? 0 : index + PrefetchPages;
+    size_t last = std::min(page_ids_.size(), index + 2 * PrefetchPages);
+    if (first < last) {
+        pool_->prefetch(page_ids_.data() + first, last - first);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Table.hpp"
+#include "librdb/BufferPool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rdb::engine {
+// A table kept in pages of a BufferPool rather than in memory, so that it
+// may be larger than memory. Each page holds a run of consecutive rows of
+// every column (PAX): a header with the number of rows, then the values of
+// each column in turn, INT and REAL as arrays of numbers and TEXT as the
+// offsets where each text ends followed by the texts. A page is read back
+// as a Table of its rows, which the rest of the engine then works on as it
+// would on a table in memory.
+//
+// Only the numbers of the pages and of their rows are held in memory. The
+// table frees its pages when it is destroyed; the pool must outlive it.
+class PagedTable {
+public:
+    // Pages are prefetched this many at a time ahead of a scan.
+    static constexpr size_t PrefetchPages = 16;
+
+    // The columns of schema, which must have no rows.
+    PagedTable(Table schema, BufferPool& pool);
+    PagedTable(PagedTable&& other) noexcept;
+    PagedTable& operator=(PagedTable&& other) noexcept;
+    PagedTable(const PagedTable&) = delete;
+    PagedTable& operator=(const PagedTable&) = delete;
+    ~PagedTable();
+
+    // The columns, without rows.
+    const Table& schema() const;
+    size_t rows() const;
+    size_t pages() const;
+
+    // Whether every row of rows, which has the columns of the schema, fits
+    // in a page by itself, as append() requires.
+    bool fits(const Table& rows) const;
+    // Adds rows after the last; throws std::length_error, changing nothing,
+    // unless they fit.
+    void append(const Table& rows);
+    // The rows of page index.
+    Table page(size_t index) const;
+    // Replaces the rows of page index with rows, which must be fewer; a page
+    // left without rows is freed.
+    void replace_page(size_t index, const Table& rows);
+    // Frees every page.
+    void clear();
+
+    // Calls visit(page(index)) for each page in order, having the pool read
+    // the next pages ahead of it.
+    template <typename Visit>
+    void scan(Visit&& visit) const
+    {
+        for (size_t index = 0; index < page_ids_.size(); index++) {
+            if (index % PrefetchPages == 0) {
+                prefetch(index);
+            }
+            visit(page(index));
+        }
+    }
+
+private:
+    Table schema_;
+    BufferPool* pool_;
+    std::vector<PageId> page_ids_;
+    std::vector<uint32_t> page_rows_;
+    size_t rows_ = 0;
+
+    // Prefetches the pages the scan reaching page index is about to need.
+    void prefetch(size_t index) const;
+};
+} // namespace rdb::engine
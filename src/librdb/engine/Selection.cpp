@@ -0,0 +1,71 @@
+#include "Selection.hpp"
+
+using rdb::engine::Renumbering;
+using rdb::engine::Selection;
+
+Selection::Selection(size_t rows, bool selected)
+    : rows_{rows}, words_((rows + 63) / 64, selected ? ~uint64_t{0} : 0)
+{
+    if (selected && (rows % 64 != 0)) {
+        words_.back() = (uint64_t{1} << (rows % 64)) - 1;
+    }
+}
+
+size_t Selection::rows() const
+{
+    return rows_;
+}
+
+bool Selection::test(size_t row) const
+{
+    return (words_[row / 64] >> (row % 64)) & 1;
+}
+
+void Selection::set(size_t row)
+{
+    words_[row / 64] |= uint64_t{1} << (row % 64);
+}
+
+size_t Selection::count() const
+{
+    size_t count = 0;
+    for (uint64_t word : words_) {
+        count += rdb::popcount(word);
+    }
+    return count;
+}
+
+size_t Selection::word_count() const
+{
+    return words_.size();
+}
+
+uint64_t* Selection::words()
+{
+    return words_.data();
+}
+
+const uint64_t* Selection::words() const
+{
+    return words_.data();
+}
+
+Renumbering::Renumbering(const Selection& removed)
+    : removed_{removed}, kept_before_(removed.word_count())
+{
+    size_t kept = 0;
+    for (size_t word = 0; word < removed.word_count(); word++) {
+        kept_before_[word] = kept;
+        kept += 64 - rdb::popcount(removed.words()[word]);
+    }
+}
+
+size_t Renumbering::operator()(size_t row) const
+{
+    uint64_t word = removed_.words()[row / 64];
+    uint64_t bit = uint64_t{1} << (row % 64);
+    if ((word & bit) != 0) {
+        return Removed;
+    }
+    return kept_before_[row / 64] + rdb::popcount(~word & (bit - 1));
+}
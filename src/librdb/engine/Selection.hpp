@@ -0,0 +1,58 @@
+#pragma once
+
+#include "librdb/Simd.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rdb::engine {
+// One bit per row of a table, set for the rows a WHERE clause selects. Rows
+// are packed 64 to a word, the first in its lowest bit; the bits past the
+// last row stay clear.
+class Selection {
+public:
+    explicit Selection(size_t rows, bool selected = false);
+
+    size_t rows() const;
+    bool test(size_t row) const;
+    void set(size_t row);
+    // How many rows are selected.
+    size_t count() const;
+
+    size_t word_count() const;
+    uint64_t* words();
+    const uint64_t* words() const;
+
+    // Calls visit(row) for each selected row, in order.
+    template <typename Visit>
+    void for_each(Visit&& visit) const
+    {
+        for (size_t word = 0; word < words_.size(); word++) {
+            for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+                visit(word * 64 + rdb::count_trailing_zeros(bits));
+            }
+        }
+    }
+
+private:
+    size_t rows_;
+    std::vector<uint64_t> words_;
+};
+
+// Where each row ends up once the removed ones are dropped and the others
+// close up in order, as Table::remove_rows() does.
+class Renumbering {
+public:
+    static constexpr size_t Removed = SIZE_MAX;
+
+    explicit Renumbering(const Selection& removed);
+
+    // The new number of row, or Removed.
+    size_t operator()(size_t row) const;
+
+private:
+    const Selection& removed_;
+    // Rows kept before each word of removed_.
+    std::vector<size_t> kept_before_;
+};
+} // namespace rdb::engine
@@ -0,0 +1,143 @@
+#include "Table.hpp"
+#include <stdexcept>
+#include <utility>
+
+using rdb::parser::CompareOp;
+using rdb::parser::IndexKind;
+using rdb::parser::TokenType;
+using rdb::engine::Column;
+using rdb::engine::Index;
+using rdb::engine::Selection;
+using rdb::engine::Table;
+using rdb::engine::TextColumn;
+
+void Table::add_column(std::string name, TokenType type)
+{
+    switch (type) {
+    case TokenType::KwInt:
+        add_column(std::move(name), std::vector<long>(rows_));
+        return;
+    case TokenType::KwReal:
+        add_column(std::move(name), std::vector<double>(rows_));
+        return;
+    case TokenType::KwText: {
+        TextColumn texts;
+        for (size_t row = 0; row < rows_; row++) {
+            texts.push_back({});
+        }
+        add_column(std::move(name), std::move(texts));
+        return;
+    }
+    default:
+        throw std::invalid_argument("Table: no such column type");
+    }
+}
+
+void Table::add_column(std::string name, Column values)
+{
+    size_t rows = column_rows(values);
+    if (!columns_.empty() && (rows != rows_)) {
+        throw std::invalid_argument("Table: column has the wrong row count");
+    }
+    names_.push_back(std::move(name));
+    columns_.push_back(std::move(values));
+    rows_ = rows;
+}
+
+size_t Table::columns() const
+{
+    return columns_.size();
+}
+
+size_t Table::rows() const
+{
+    return rows_;
+}
+
+const std::string& Table::column_name(size_t index) const
+{
+    return names_.at(index);
+}
+
+TokenType Table::column_type(size_t index) const
+{
+    return *alternative_type(columns_.at(index).index());
+}
+
+std::optional<size_t> Table::column_index(std::string_view name) const
+{
+    for (size_t index = 0; index < names_.size(); index++) {
+        if (names_[index] == name) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+const Column& Table::column(size_t index) const
+{
+    return columns_.at(index);
+}
+
+void Table::add_index(std::string name, size_t column, IndexKind kind)
+{
+    indexes_.emplace_back(std::move(name), column, kind, columns_.at(column));
+}
+
+size_t Table::indexes() const
+{
+    return indexes_.size();
+}
+
+const Index& Table::index(size_t index) const
+{
+    return indexes_.at(index);
+}
+
+const Index* Table::find_index(size_t column, CompareOp op) const
+{
+    const Index* found = nullptr;
+    for (auto& index : indexes_) {
+        if ((index.column() == column) && index.answers(op)
+            && ((found == nullptr) || (index.kind() == IndexKind::Hash))) {
+            found = &index;
+        }
+    }
+    return found;
+}
+
+void Table::remove_rows(const Selection& removed)
+{
+    for (auto& column : columns_) {
+        retain(column, removed);
+    }
+    for (auto& index : indexes_) {
+        index.remove_rows(removed);
+    }
+    rows_ -= removed.count();
+}
+
+std::ostream& rdb::engine::operator<<(std::ostream& os, const Table& table)
+{
+    for (size_t index = 0; index < table.columns(); index++) {
+        os << (index == 0 ? "" : ", ") << table.column_name(index);
+    }
+    os << "\n";
+    for (size_t row = 0; row < table.rows(); row++) {
+        for (size_t index = 0; index < table.columns(); index++) {
+            os << (index == 0 ? "" : ", ");
+            std::visit(
+                    [&os, row](auto&& values) {
+                        using Values = std::decay_t<decltype(values)>;
+                        if constexpr (std::is_same_v<Values, TextColumn>) {
+                            os << '"' << values[row] << '"';
+                        } else {
+                            os << values[row];
+                        }
+                    },
+                    table.column(index));
+        }
+        os << "\n";
+    }
+    return os;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Column.hpp"
+#include "Index.hpp"
+#include "librdb/Token.hpp"
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rdb::engine {
+// Named columns of one type each, all with the same number of rows, and the
+// indexes on them.
+class Table {
+public:
+    // type is TokenType::KwInt, KwReal or KwText; throws
+    // std::invalid_argument for any other. Rows the table already has get 0,
+    // 0.0 or empty text in the new column.
+    void add_column(std::string name, parser::TokenType type);
+    // Adds a column of rows values, which must be as many as the table's
+    // rows unless it has no columns yet.
+    void add_column(std::string name, Column values);
+
+    size_t columns() const;
+    size_t rows() const;
+    const std::string& column_name(size_t index) const;
+    // KwInt, KwReal or KwText.
+    parser::TokenType column_type(size_t index) const;
+    std::optional<size_t> column_index(std::string_view name) const;
+    const Column& column(size_t index) const;
+
+    // Indexes column under name; the index then follows every change to
+    // the rows.
+    void add_index(std::string name, size_t column, parser::IndexKind kind);
+    size_t indexes() const;
+    const Index& index(size_t index) const;
+    // An index on column that answers op, preferring a hash index for =;
+    // null if there is none.
+    const Index* find_index(size_t column, parser::CompareOp op) const;
+
+    // Calls append(index, column) for each column, which must add rows
+    // values to every one of them.
+    template <typename Append>
+    void append_rows(size_t rows, Append&& append)
+    {
+        for (size_t index = 0; index < columns_.size(); index++) {
+            append(index, columns_[index]);
+        }
+        for (auto& index : indexes_) {
+            index.append(columns_[index.column()], rows_);
+        }
+        rows_ += rows;
+    }
+    void remove_rows(const Selection& removed);
+
+private:
+    std::vector<std::string> names_;
+    std::vector<Column> columns_;
+    std::vector<Index> indexes_;
+    size_t rows_ = 0;
+};
+
+// The column names on the first line, then a line per row; values are
+// separated by ", " and text is quoted, as in SQL.
+std::ostream& operator<<(std::ostream& os, const Table& table);
+} // namespace rdb::engine
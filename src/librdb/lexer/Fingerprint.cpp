@@ -0,0 +1,67 @@
+#include "Fingerprint.hpp"
+#include "Lexer.hpp"
+
+using rdb::parser::Fingerprint;
+using rdb::parser::Lexer;
+using rdb::parser::Token;
+using rdb::parser::TokenType;
+
+namespace {
+std::string_view normalized_lexeme(const Token& token)
+{
+    switch (token.type) {
+    case TokenType::VarInt:
+    case TokenType::VarReal:
+    case TokenType::VarText:
+        return "?";
+    default: {
+        std::string_view keyword
+                = rdb::parser::TokenTypes[static_cast<size_t>(token.type)]
+                          .keyword;
+        return keyword.empty() ? token.lexeme : keyword;
+    }
+    }
+}
+
+bool space_before(TokenType previous, TokenType type)
+{
+    return (previous != TokenType::ParenthesisOpening)
+            && (type != TokenType::Comma)
+            && (type != TokenType::ParenthesisClosing)
+            && (type != TokenType::Semicolon);
+}
+} // namespace
+
+Fingerprint rdb::parser::fingerprint(std::string_view sql)
+{
+    Fingerprint result;
+    rdb::parser::fingerprint(sql, result);
+    return result;
+}
+
+void rdb::parser::fingerprint(std::string_view sql, Fingerprint& result)
+{
+    result.normalized.clear();
+    Lexer lexer(sql);
+    TokenType previous = TokenType::EndOfFile;
+    for (Token token = lexer.get(); token.type != TokenType::EndOfFile;
+         token = lexer.get()) {
+        if (space_before(previous, token.type)
+            && !result.normalized.empty()) {
+            result.normalized += ' ';
+        }
+        result.normalized += normalized_lexeme(token);
+        previous = token.type;
+    }
+    result.digest = rdb::parser::fnv1a_64(result.normalized);
+}
+
+uint64_t rdb::parser::fnv1a_64(std::string_view bytes)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char byte : bytes) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace rdb::parser {
+// The shape of a script, shared by every script that differs from it only in
+// its literals, the case of its keywords or its whitespace.
+struct Fingerprint {
+    // Tokens separated by single spaces, except after '(' and before ',',
+    // ')' and ';'. Numbers and text literals become '?', and keywords are
+    // spelled in upper case; everything else is kept as it was lexed.
+    std::string normalized;
+    // 64-bit FNV-1a of normalized, the same on every platform and build.
+    uint64_t digest = 0;
+};
+
+// Lexes sql once, without parsing it, so malformed scripts have a
+// fingerprint as well.
+Fingerprint fingerprint(std::string_view sql);
+// As above, reusing the memory result already holds; for callers that take
+// the fingerprint of one statement after another.
+void fingerprint(std::string_view sql, Fingerprint& result);
+
+// The 64-bit FNV-1a hash of bytes.
+uint64_t fnv1a_64(std::string_view bytes);
+} // namespace rdb::parser
@@ -1,110 +1,96 @@
 #include "Lexer.hpp"
-#include <algorithm>
-#include <array>
-#include <cctype>
-#include <regex>
+#include "ScanKernels.hpp"
+#include "Scanner.hpp"
+#include <stdexcept>
 
 using rdb::parser::Lexer;
 using rdb::parser::Token;
 using rdb::parser::TokenType;
 
-namespace {
-struct TokenRule {
-    TokenType tokentype;
-    std::regex regex;
-};
-
-// clang-format off
-const std::array<TokenRule, 24> TokenRules{ {
-        {TokenType::KwCreate,            std::regex(R"(CREATE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwInsert,            std::regex(R"(INSERT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwDelete,            std::regex(R"(DELETE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwDrop,              std::regex(R"(DROP(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwFrom,              std::regex(R"(FROM(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwInto,              std::regex(R"(INTO(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwInt,               std::regex(R"(INT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwReal,              std::regex(R"(REAL(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwSelect,            std::regex(R"(SELECT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwTable,             std::regex(R"(TABLE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwText,              std::regex(R"(TEXT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwValues,            std::regex(R"(VALUES(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::KwWhere,             std::regex(R"(WHERE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
-        {TokenType::VarText,             std::regex("\".*?\"", std::regex_constants::icase)},
-        {TokenType::VarReal,             std::regex("[-+]?0\\.[0-9]+|[1-9][0-9]*\\.[0-9]+", std::regex_constants::icase)},
-        {TokenType::VarInt,              std::regex("[-+]?0|[-+]?[1-9][0-9]*", std::regex_constants::icase)},
-        {TokenType::VarId,               std::regex("[a-z][a-z0-9]*", std::regex_constants::icase)},
-        {TokenType::Operation,           std::regex(">=|<=|!=|=|<|>", std::regex_constants::icase)},
-        {TokenType::ParenthesisOpening,  std::regex("\\(", std::regex_constants::icase)},
-        {TokenType::ParenthesisClosing,  std::regex("\\)", std::regex_constants::icase)},
-        {TokenType::CurlyBracketOpening, std::regex("\\{", std::regex_constants::icase)},
-        {TokenType::CurlyBracketClosing, std::regex("\\}", std::regex_constants::icase)},
-        {TokenType::Semicolon,           std::regex(";", std::regex_constants::icase)},
-        {TokenType::Comma,               std::regex(",", std::regex_constants::icase)}
-} };
-// clang-format on
-} // namespace
+static_assert(
+        (Lexer::MaxLookahead & (Lexer::MaxLookahead - 1)) == 0,
+        "The lookahead ring buffer is indexed with a mask");
 
 Lexer::Lexer(std::string_view parse_string_view)
-    : parse_string{parse_string_view}, string_pos{0}, col{1}, row{1}
+    : parse_string{parse_string_view},
+      string_pos{0},
+      lookahead_begin{0},
+      lookahead_size{0}
 {
 }
 
-Token Lexer::peek()
+Token Lexer::peek(size_t n)
 {
-    if (string_pos == parse_string.length()) {
-        return Token(TokenType::EndOfFile, "", col, row);
+    if (n >= MaxLookahead) {
+        throw std::out_of_range("Lexer: lookahead is limited to MaxLookahead");
+    }
+    while (lookahead_size <= n) {
+        lookahead[(lookahead_begin + lookahead_size) & (MaxLookahead - 1)]
+                = scan();
+        lookahead_size++;
     }
+    return lookahead[(lookahead_begin + n) & (MaxLookahead - 1)];
+}
 
-    while (std::end(Lexer::skipsym)
-           != std::find(
-                   std::begin(Lexer::skipsym),
-                   std::end(Lexer::skipsym),
-                   parse_string.at(string_pos))) {
-        col++;
-        if (parse_string.at(string_pos) == '\n') {
-            col = 1;
-            row++;
-        }
-        if (++string_pos == parse_string.length()) {
-            return Token(TokenType::EndOfFile, "", col, row);
-        }
+Token Lexer::get()
+{
+    if (lookahead_size == 0) {
+        return scan();
     }
+    Token token = lookahead[lookahead_begin];
+    lookahead_begin = (lookahead_begin + 1) & (MaxLookahead - 1);
+    lookahead_size--;
+    return token;
+}
 
-    for (auto&& rule : TokenRules) {
-        std::cmatch match;
-        if (std::regex_search(
-                    parse_string.data() + string_pos,
-                    match,
-                    rule.regex,
-                    std::regex_constants::match_continuous)) {
-            Token token_to_return(
-                    rule.tokentype,
-                    std::string_view(
-                            parse_string.data() + string_pos,
-                            match.begin()->length()),
-                    col,
-                    row);
-            return token_to_return;
+Token Lexer::skip_past_semicolon()
+{
+    while (lookahead_size != 0) {
+        Token token = get();
+        if ((token.type == TokenType::Semicolon)
+            || (token.type == TokenType::EndOfFile)) {
+            return token;
         }
     }
 
+    const char* begin = parse_string.data();
+    const char* end = begin + parse_string.length();
+    const char* semicolon
+            = rdb::parser::find_statement_end(begin + string_pos, end);
+    string_pos = semicolon - begin;
+    if (semicolon == end) {
+        return Token(TokenType::EndOfFile, "", string_pos);
+    }
+    string_pos++;
     return Token(
-            TokenType::Unknown,
-            std::string_view(parse_string.data() + string_pos++, 1),
-            col,
-            row);
+            TokenType::Semicolon,
+            std::string_view(semicolon, 1),
+            semicolon - begin);
 }
 
-Token Lexer::get()
+size_t Lexer::bytes_scanned() const
 {
-    auto res_token = peek();
-    for (char sym : res_token.lexeme) {
-        col++;
-        if (sym == '\n') {
-            col = 1;
-            row++;
-        }
+    return string_pos;
+}
+
+std::string_view Lexer::source() const
+{
+    return parse_string;
+}
+
+Token Lexer::scan()
+{
+    const char* begin = parse_string.data();
+    const char* end = begin + parse_string.length();
+    const char* token_begin
+            = rdb::parser::skip_whitespace(begin + string_pos, end);
+    string_pos = token_begin - begin;
+    if (token_begin == end) {
+        return Token(TokenType::EndOfFile, "", string_pos);
     }
-    string_pos += res_token.lexeme.length();
-    return res_token;
-}
\ No newline at end of file
+
+    auto [type, length] = rdb::parser::scan_token(token_begin, end);
+    Token token(type, std::string_view(token_begin, length), string_pos);
+    string_pos += length;
+    return token;
+}
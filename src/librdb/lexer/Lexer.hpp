@@ -1,24 +1,36 @@
 #pragma once
 
 #include "librdb/Token.hpp"
+#include <array>
 #include <string_view>
-#include <unordered_map>
 
 using rdb::parser::Token;
 namespace rdb::parser {
+// Tokens are scanned once into a small ring buffer, so peeking ahead and then
+// consuming the same tokens never lexes any byte twice.
 class Lexer {
 public:
+    static constexpr size_t MaxLookahead = 4;
+
     explicit Lexer(std::string_view parse_string_view);
     Token get();
-    Token peek();
+    // The n-th upcoming token, peek(0) being the one get() returns next.
+    // Throws std::out_of_range if n >= MaxLookahead.
+    Token peek(size_t n = 0);
+    // Consumes tokens up to the next Semicolon and returns it, or returns
+    // EndOfFile if there is none, like calling get() until either. Bytes
+    // that were not peeked yet are not lexed, only searched for the ';'.
+    Token skip_past_semicolon();
+    // Bytes of input (whitespace included) consumed by the scanner so far.
+    size_t bytes_scanned() const;
+    std::string_view source() const;
 
 private:
     std::string_view parse_string;
     size_t string_pos;
-    size_t col;
-    size_t row;
-    int string_pos_increment();
-    Token token_extract_begin();
-    static constexpr char skipsym[] = {' ', '\n', '\r', '\t'};
+    std::array<Token, MaxLookahead> lookahead;
+    size_t lookahead_begin;
+    size_t lookahead_size;
+    Token scan();
 };
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "LineIndex.hpp"
+#include "ScanKernels.hpp"
+#include <algorithm>
+
+using rdb::parser::LineIndex;
+using rdb::parser::Position;
+
+LineIndex::LineIndex(std::string_view source, Position origin)
+    : line_begins{0}, origin{origin}
+{
+    const char* begin = source.data();
+    const char* end = begin + source.size();
+    for (const char* pos = rdb::parser::skip_line(begin, end); pos != end;
+         pos = rdb::parser::skip_line(pos + 1, end)) {
+        line_begins.push_back(pos + 1 - begin);
+    }
+}
+
+Position LineIndex::locate(size_t offset) const
+{
+    auto line = std::upper_bound(line_begins.begin(), line_begins.end(), offset)
+            - 1;
+    auto row = static_cast<size_t>(line - line_begins.begin());
+    size_t col = offset - *line + 1;
+    if (row == 0) {
+        col += origin.col - 1;
+    }
+    return Position{row + origin.row, col};
+}
+
+size_t LineIndex::lines() const
+{
+    return line_begins.size();
+}
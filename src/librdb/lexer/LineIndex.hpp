@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace rdb::parser {
+// 1-based, the column counting bytes from the start of the line.
+struct Position {
+    size_t row;
+    size_t col;
+};
+
+// The offsets at which the lines of a source begin, found with the vectorised
+// skip_line() kernel. Tokens only carry byte offsets; the index turns them
+// into positions when an error has to be reported.
+class LineIndex {
+public:
+    // origin is where source starts, for text cut out of a larger script.
+    explicit LineIndex(std::string_view source, Position origin = {1, 1});
+    // Accepts offsets up to and including source.size(), where EndOfFile is.
+    Position locate(size_t offset) const;
+    size_t lines() const;
+
+private:
+    std::vector<size_t> line_begins;
+    Position origin;
+};
+} // namespace rdb::parser
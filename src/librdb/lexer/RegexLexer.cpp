@@ -0,0 +1,102 @@
+#include "RegexLexer.hpp"
+#include <algorithm>
+#include <array>
+#include <regex>
+
+using rdb::parser::RegexLexer;
+using rdb::parser::Token;
+using rdb::parser::TokenType;
+
+namespace {
+struct TokenRule {
+    TokenType tokentype;
+    std::regex regex;
+};
+
+// Built on first use so that linking the reference lexer in does not cost
+// every program 28 regex compilations during static initialisation.
+const std::array<TokenRule, 28>& token_rules()
+{
+    // clang-format off
+    static const std::array<TokenRule, 28> TokenRules{ {
+            {TokenType::KwCreate,            std::regex(R"(CREATE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwInsert,            std::regex(R"(INSERT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwDelete,            std::regex(R"(DELETE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwDrop,              std::regex(R"(DROP(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwFrom,              std::regex(R"(FROM(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwInto,              std::regex(R"(INTO(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwInt,               std::regex(R"(INT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwReal,              std::regex(R"(REAL(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwSelect,            std::regex(R"(SELECT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwTable,             std::regex(R"(TABLE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwText,              std::regex(R"(TEXT(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwValues,            std::regex(R"(VALUES(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwIndex,             std::regex(R"(INDEX(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwHash,              std::regex(R"(HASH(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwOn,                std::regex(R"(ON(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::KwWhere,             std::regex(R"(WHERE(?=\s|$|\(|\)|;|,))", std::regex_constants::icase)},
+            {TokenType::VarText,             std::regex("\".*?\"", std::regex_constants::icase)},
+            {TokenType::VarReal,             std::regex("[-+]?0\\.[0-9]+|[1-9][0-9]*\\.[0-9]+", std::regex_constants::icase)},
+            {TokenType::VarInt,              std::regex("[-+]?0|[-+]?[1-9][0-9]*", std::regex_constants::icase)},
+            {TokenType::VarId,               std::regex("[a-z][a-z0-9]*", std::regex_constants::icase)},
+            {TokenType::Operation,           std::regex(">=|<=|!=|=|<|>", std::regex_constants::icase)},
+            {TokenType::ParenthesisOpening,  std::regex("\\(", std::regex_constants::icase)},
+            {TokenType::ParenthesisClosing,  std::regex("\\)", std::regex_constants::icase)},
+            {TokenType::CurlyBracketOpening, std::regex("\\{", std::regex_constants::icase)},
+            {TokenType::CurlyBracketClosing, std::regex("\\}", std::regex_constants::icase)},
+            {TokenType::Semicolon,           std::regex(";", std::regex_constants::icase)},
+            {TokenType::Comma,               std::regex(",", std::regex_constants::icase)},
+            {TokenType::Placeholder,         std::regex("\\?", std::regex_constants::icase)}
+    } };
+    // clang-format on
+    return TokenRules;
+}
+} // namespace
+
+RegexLexer::RegexLexer(std::string_view parse_string_view)
+    : parse_string{parse_string_view}, string_pos{0}
+{
+}
+
+Token RegexLexer::peek()
+{
+    if (string_pos == parse_string.length()) {
+        return Token(TokenType::EndOfFile, "", string_pos);
+    }
+
+    while (std::end(RegexLexer::skipsym)
+           != std::find(
+                   std::begin(RegexLexer::skipsym),
+                   std::end(RegexLexer::skipsym),
+                   parse_string.at(string_pos))) {
+        if (++string_pos == parse_string.length()) {
+            return Token(TokenType::EndOfFile, "", string_pos);
+        }
+    }
+
+    const char* begin = parse_string.data() + string_pos;
+    const char* end = parse_string.data() + parse_string.length();
+    for (auto&& rule : token_rules()) {
+        std::cmatch match;
+        if (std::regex_search(
+                    begin,
+                    end,
+                    match,
+                    rule.regex,
+                    std::regex_constants::match_continuous)) {
+            return Token(
+                    rule.tokentype,
+                    std::string_view(begin, match.begin()->length()),
+                    string_pos);
+        }
+    }
+
+    return Token(TokenType::Unknown, std::string_view(begin, 1), string_pos);
+}
+
+Token RegexLexer::get()
+{
+    auto res_token = peek();
+    string_pos += res_token.lexeme.length();
+    return res_token;
+}
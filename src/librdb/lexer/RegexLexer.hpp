@@ -0,0 +1,21 @@
+#pragma once
+
+#include "librdb/Token.hpp"
+#include <string_view>
+
+namespace rdb::parser {
+// The original std::regex based lexer. It is no longer used by the parser and
+// is kept only as a reference implementation: the differential tests and the
+// lexer benchmark compare the DFA-driven Lexer against it.
+class RegexLexer {
+public:
+    explicit RegexLexer(std::string_view parse_string_view);
+    Token get();
+    Token peek();
+
+private:
+    std::string_view parse_string;
+    size_t string_pos;
+    static constexpr char skipsym[] = {' ', '\n', '\r', '\t'};
+};
+} // namespace rdb::parser
@@ -0,0 +1,348 @@
+#include "ScanKernels.hpp"
+#include "librdb/Simd.hpp"
+#include <cstdint>
+
+#if defined(RDB_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+using rdb::SimdLevel;
+
+namespace {
+// Each run matcher classifies one byte (scalar) and, where available, a whole
+// vector, yielding 0xff in the lanes that continue the run.
+#if defined(RDB_SIMD_SSE2)
+__m128i in_range_sse2(__m128i chunk, char low, char high)
+{
+    // Unsigned low <= c <= high as one signed comparison: shift the range so
+    // that it starts at INT8_MIN.
+    __m128i shifted = _mm_add_epi8(
+            chunk, _mm_set1_epi8(static_cast<char>(0x80 - low)));
+    return _mm_cmplt_epi8(
+            shifted, _mm_set1_epi8(static_cast<char>(0x80 + high - low + 1)));
+}
+#endif
+
+#if defined(RDB_SIMD_AVX2)
+RDB_TARGET_AVX2 __m256i in_range_avx2(__m256i chunk, char low, char high)
+{
+    __m256i shifted = _mm256_add_epi8(
+            chunk, _mm256_set1_epi8(static_cast<char>(0x80 - low)));
+    return _mm256_cmpgt_epi8(
+            _mm256_set1_epi8(static_cast<char>(0x80 + high - low + 1)),
+            shifted);
+}
+#endif
+
+struct Whitespace {
+    static bool scalar(char sym)
+    {
+        return sym == ' ' || sym == '\t' || sym == '\n' || sym == '\r';
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        return _mm_or_si128(
+                _mm_or_si128(
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+                _mm_or_si128(
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')),
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))));
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        return _mm256_or_si256(
+                _mm256_or_si256(
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))));
+    }
+#endif
+};
+
+struct Alnum {
+    static bool scalar(char sym)
+    {
+        char upper = static_cast<char>(sym & ~0x20);
+        return (upper >= 'A' && upper <= 'Z') || (sym >= '0' && sym <= '9');
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        __m128i upper = _mm_andnot_si128(_mm_set1_epi8(0x20), chunk);
+        return _mm_or_si128(
+                in_range_sse2(upper, 'A', 'Z'), in_range_sse2(chunk, '0', '9'));
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        __m256i upper = _mm256_andnot_si256(_mm256_set1_epi8(0x20), chunk);
+        return _mm256_or_si256(
+                in_range_avx2(upper, 'A', 'Z'),
+                in_range_avx2(chunk, '0', '9'));
+    }
+#endif
+};
+
+struct Digits {
+    static bool scalar(char sym)
+    {
+        return sym >= '0' && sym <= '9';
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        return in_range_sse2(chunk, '0', '9');
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        return in_range_avx2(chunk, '0', '9');
+    }
+#endif
+};
+
+struct TextBody {
+    static bool scalar(char sym)
+    {
+        return sym != '"' && sym != '\n' && sym != '\r';
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        __m128i stop = _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                _mm_or_si128(
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')),
+                        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))));
+        return _mm_andnot_si128(stop, _mm_set1_epi8(-1));
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        __m256i stop = _mm256_or_si256(
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+                _mm256_or_si256(
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')),
+                        _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))));
+        return _mm256_andnot_si256(stop, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+struct LineBody {
+    static bool scalar(char sym)
+    {
+        return sym != '\n';
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        return _mm_andnot_si128(
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_set1_epi8(-1));
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        return _mm256_andnot_si256(
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')),
+                _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+struct StatementBody {
+    static bool scalar(char sym)
+    {
+        return sym != ';' && sym != '"';
+    }
+#if defined(RDB_SIMD_SSE2)
+    static __m128i sse2(__m128i chunk)
+    {
+        __m128i stop = _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8(';')),
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')));
+        return _mm_andnot_si128(stop, _mm_set1_epi8(-1));
+    }
+#endif
+#if defined(RDB_SIMD_AVX2)
+    RDB_TARGET_AVX2 static __m256i avx2(__m256i chunk)
+    {
+        __m256i stop = _mm256_or_si256(
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(';')),
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')));
+        return _mm256_andnot_si256(stop, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+template <typename Run>
+const char* skip_scalar(const char* pos, const char* end)
+{
+    while (pos != end && Run::scalar(*pos)) {
+        pos++;
+    }
+    return pos;
+}
+
+#if defined(RDB_SIMD_SSE2)
+template <typename Run>
+const char* skip_sse2(const char* pos, const char* end)
+{
+    while (end - pos >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        uint32_t stop
+                = ~static_cast<uint32_t>(_mm_movemask_epi8(Run::sse2(chunk)))
+                & 0xffffU;
+        if (stop != 0) {
+            return pos + rdb::count_trailing_zeros(stop);
+        }
+        pos += 16;
+    }
+    return skip_scalar<Run>(pos, end);
+}
+#endif
+
+#if defined(RDB_SIMD_AVX2)
+template <typename Run>
+RDB_TARGET_AVX2 const char* skip_avx2(const char* pos, const char* end)
+{
+    while (end - pos >= 32) {
+        __m256i chunk
+                = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        uint32_t stop = ~static_cast<uint32_t>(
+                _mm256_movemask_epi8(Run::avx2(chunk)));
+        if (stop != 0) {
+            return pos + rdb::count_trailing_zeros(stop);
+        }
+        pos += 32;
+    }
+    return skip_sse2<Run>(pos, end);
+}
+#endif
+
+template <typename Run>
+const char* skip(const char* begin, const char* end)
+{
+    // Most runs are a few bytes long, so a run that ends right away does not
+    // pay for the dispatch.
+    if (begin == end || !Run::scalar(*begin)) {
+        return begin;
+    }
+    switch (rdb::simd_level()) {
+#if defined(RDB_SIMD_AVX2)
+    case SimdLevel::Avx2:
+        return skip_avx2<Run>(begin, end);
+#endif
+#if defined(RDB_SIMD_SSE2)
+    case SimdLevel::Sse2:
+        return skip_sse2<Run>(begin, end);
+#endif
+    default:
+        return skip_scalar<Run>(begin, end);
+    }
+}
+
+size_t count_newlines_scalar(const char* pos, const char* end)
+{
+    size_t newlines = 0;
+    for (; pos != end; pos++) {
+        newlines += *pos == '\n' ? 1 : 0;
+    }
+    return newlines;
+}
+
+#if defined(RDB_SIMD_SSE2)
+size_t count_newlines_sse2(const char* pos, const char* end)
+{
+    size_t newlines = 0;
+    __m128i newline = _mm_set1_epi8('\n');
+    for (; end - pos >= 16; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        newlines += rdb::popcount(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline))));
+    }
+    return newlines + count_newlines_scalar(pos, end);
+}
+#endif
+
+#if defined(RDB_SIMD_AVX2)
+RDB_TARGET_AVX2 size_t count_newlines_avx2(const char* pos, const char* end)
+{
+    size_t newlines = 0;
+    __m256i newline = _mm256_set1_epi8('\n');
+    for (; end - pos >= 32; pos += 32) {
+        __m256i chunk
+                = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        newlines += rdb::popcount(static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline))));
+    }
+    return newlines + count_newlines_sse2(pos, end);
+}
+#endif
+} // namespace
+
+const char* rdb::parser::skip_whitespace(const char* begin, const char* end)
+{
+    return skip<Whitespace>(begin, end);
+}
+
+const char* rdb::parser::skip_alnum(const char* begin, const char* end)
+{
+    return skip<Alnum>(begin, end);
+}
+
+const char* rdb::parser::skip_digits(const char* begin, const char* end)
+{
+    return skip<Digits>(begin, end);
+}
+
+const char* rdb::parser::skip_text(const char* begin, const char* end)
+{
+    return skip<TextBody>(begin, end);
+}
+
+const char* rdb::parser::skip_line(const char* begin, const char* end)
+{
+    return skip<LineBody>(begin, end);
+}
+
+const char* rdb::parser::skip_statement(const char* begin, const char* end)
+{
+    return skip<StatementBody>(begin, end);
+}
+
+size_t rdb::parser::count_newlines(const char* begin, const char* end)
+{
+    switch (rdb::simd_level()) {
+#if defined(RDB_SIMD_AVX2)
+    case SimdLevel::Avx2:
+        return count_newlines_avx2(begin, end);
+#endif
+#if defined(RDB_SIMD_SSE2)
+    case SimdLevel::Sse2:
+        return count_newlines_sse2(begin, end);
+#endif
+    default:
+        return count_newlines_scalar(begin, end);
+    }
+}
+
+const char* rdb::parser::find_statement_end(const char* begin, const char* end)
+{
+    const char* pos = begin;
+    while ((pos = skip_statement(pos, end)) != end && *pos == '"') {
+        const char* text_end = skip_text(pos + 1, end);
+        pos = (text_end != end && *text_end == '"') ? text_end + 1 : pos + 1;
+    }
+    return pos;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace rdb::parser {
+// Byte-run kernels used by the lexer's hot loops. Each one processes 32 (AVX2)
+// or 16 (SSE2) bytes per step according to rdb::simd_level(), finishing the
+// tail and non-x86 builds with a scalar loop; all levels return the same
+// result. The skip_* kernels return the first byte in [begin, end) that does
+// not belong to the run, or end.
+
+// ' ', '\t', '\n' and '\r', i.e. what the lexer skips between tokens.
+const char* skip_whitespace(const char* begin, const char* end);
+// [A-Za-z0-9], the tail of an identifier or keyword.
+const char* skip_alnum(const char* begin, const char* end);
+// [0-9], the digits of a number.
+const char* skip_digits(const char* begin, const char* end);
+// Everything but '"', '\n' and '\r': the body of a string literal, whose end
+// is either a closing quote or a line break that invalidates it.
+const char* skip_text(const char* begin, const char* end);
+// Everything but '\n', i.e. the rest of a line.
+const char* skip_line(const char* begin, const char* end);
+// Everything but ';' and '"': what lies between the quotes and semicolons
+// that decide where a statement ends.
+const char* skip_statement(const char* begin, const char* end);
+
+size_t count_newlines(const char* begin, const char* end);
+
+// The first ';' in [begin, end) outside a string literal, or end. A literal
+// runs from a quote to the next one on the same line, exactly as the lexer
+// reads it; a quote that its line ends first is a lone Unknown token, and
+// the text after it is not quoted. begin must not be inside a literal.
+const char* find_statement_end(const char* begin, const char* end);
+} // namespace rdb::parser
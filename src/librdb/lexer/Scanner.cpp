@@ -0,0 +1,350 @@
+#include "Scanner.hpp"
+#include "ScanKernels.hpp"
+#include <array>
+#include <cstdint>
+
+using rdb::parser::ScannedToken;
+using rdb::parser::TokenType;
+
+namespace {
+// Every input byte is first mapped to one of these classes, so the transition
+// table stays small (states x classes) instead of states x 256.
+enum CharClass : uint8_t {
+    Blank,     // ' ', '\t'
+    LineBreak, // '\n', '\r'
+    Space,     // '\v', '\f': not skipped, but still end a keyword
+    Letter,
+    Zero,
+    Digit,
+    Sign,
+    Dot,
+    Quote,
+    Less,
+    Greater,
+    Equals,
+    Bang,
+    ParenOpen,
+    ParenClose,
+    CurlyOpen,
+    CurlyClose,
+    SemicolonSym,
+    CommaSym,
+    Question,
+    Other,
+    CharClassCount
+};
+
+enum State : uint8_t {
+    Start,
+    Identifier,
+    SignSeen,
+    ZeroSeen,
+    Integer,
+    SignedInteger,
+    Fraction,
+    Real,
+    Text,
+    TextEnd,
+    LessSeen,
+    GreaterSeen,
+    BangSeen,
+    OperationEnd,
+    ParenOpenSeen,
+    ParenCloseSeen,
+    CurlyOpenSeen,
+    CurlyCloseSeen,
+    SemicolonSeen,
+    CommaSeen,
+    QuestionSeen,
+    Dead,
+    StateCount
+};
+
+constexpr std::array<CharClass, 256> make_char_classes()
+{
+    std::array<CharClass, 256> classes{};
+    for (auto& char_class : classes) {
+        char_class = Other;
+    }
+    for (unsigned char c = 'a'; c <= 'z'; c++) {
+        classes[c] = Letter;
+        classes[c - 'a' + 'A'] = Letter;
+    }
+    for (unsigned char c = '1'; c <= '9'; c++) {
+        classes[c] = Digit;
+    }
+    classes['0'] = Zero;
+    classes[' '] = Blank;
+    classes['\t'] = Blank;
+    classes['\n'] = LineBreak;
+    classes['\r'] = LineBreak;
+    classes['\v'] = Space;
+    classes['\f'] = Space;
+    classes['+'] = Sign;
+    classes['-'] = Sign;
+    classes['.'] = Dot;
+    classes['"'] = Quote;
+    classes['<'] = Less;
+    classes['>'] = Greater;
+    classes['='] = Equals;
+    classes['!'] = Bang;
+    classes['('] = ParenOpen;
+    classes[')'] = ParenClose;
+    classes['{'] = CurlyOpen;
+    classes['}'] = CurlyClose;
+    classes[';'] = SemicolonSym;
+    classes[','] = CommaSym;
+    classes['?'] = Question;
+    return classes;
+}
+
+using TransitionTable
+        = std::array<std::array<State, CharClassCount>, StateCount>;
+
+constexpr TransitionTable make_transitions()
+{
+    TransitionTable table{};
+    for (auto& row : table) {
+        for (auto& next : row) {
+            next = Dead;
+        }
+    }
+
+    table[Start][Letter] = Identifier;
+    table[Start][Sign] = SignSeen;
+    table[Start][Zero] = ZeroSeen;
+    table[Start][Digit] = Integer;
+    table[Start][Quote] = Text;
+    table[Start][Less] = LessSeen;
+    table[Start][Greater] = GreaterSeen;
+    table[Start][Equals] = OperationEnd;
+    table[Start][Bang] = BangSeen;
+    table[Start][ParenOpen] = ParenOpenSeen;
+    table[Start][ParenClose] = ParenCloseSeen;
+    table[Start][CurlyOpen] = CurlyOpenSeen;
+    table[Start][CurlyClose] = CurlyCloseSeen;
+    table[Start][SemicolonSym] = SemicolonSeen;
+    table[Start][CommaSym] = CommaSeen;
+    table[Start][Question] = QuestionSeen;
+
+    table[Identifier][Letter] = Identifier;
+    table[Identifier][Zero] = Identifier;
+    table[Identifier][Digit] = Identifier;
+
+    // A sign is only part of a real number in front of "0.", e.g. "-0.5";
+    // "-1.5" lexes as the integer "-1" followed by an unknown '.'.
+    table[SignSeen][Zero] = ZeroSeen;
+    table[SignSeen][Digit] = SignedInteger;
+
+    table[ZeroSeen][Dot] = Fraction;
+    table[Integer][Zero] = Integer;
+    table[Integer][Digit] = Integer;
+    table[Integer][Dot] = Fraction;
+    table[SignedInteger][Zero] = SignedInteger;
+    table[SignedInteger][Digit] = SignedInteger;
+
+    table[Fraction][Zero] = Real;
+    table[Fraction][Digit] = Real;
+    table[Real][Zero] = Real;
+    table[Real][Digit] = Real;
+
+    // A string literal ends at the first closing quote and may not span lines.
+    for (size_t char_class = 0; char_class < CharClassCount; char_class++) {
+        table[Text][char_class] = Text;
+    }
+    table[Text][LineBreak] = Dead;
+    table[Text][Quote] = TextEnd;
+
+    table[LessSeen][Equals] = OperationEnd;
+    table[GreaterSeen][Equals] = OperationEnd;
+    table[BangSeen][Equals] = OperationEnd;
+
+    return table;
+}
+
+// TokenType::Unknown marks the states that do not end a token.
+constexpr std::array<TokenType, StateCount> make_accepting()
+{
+    std::array<TokenType, StateCount> accepting{};
+    for (auto& type : accepting) {
+        type = TokenType::Unknown;
+    }
+    accepting[Identifier] = TokenType::VarId;
+    accepting[ZeroSeen] = TokenType::VarInt;
+    accepting[Integer] = TokenType::VarInt;
+    accepting[SignedInteger] = TokenType::VarInt;
+    accepting[Real] = TokenType::VarReal;
+    accepting[TextEnd] = TokenType::VarText;
+    accepting[LessSeen] = TokenType::Operation;
+    accepting[GreaterSeen] = TokenType::Operation;
+    accepting[OperationEnd] = TokenType::Operation;
+    accepting[ParenOpenSeen] = TokenType::ParenthesisOpening;
+    accepting[ParenCloseSeen] = TokenType::ParenthesisClosing;
+    accepting[CurlyOpenSeen] = TokenType::CurlyBracketOpening;
+    accepting[CurlyCloseSeen] = TokenType::CurlyBracketClosing;
+    accepting[SemicolonSeen] = TokenType::Semicolon;
+    accepting[CommaSeen] = TokenType::Comma;
+    accepting[QuestionSeen] = TokenType::Placeholder;
+    return accepting;
+}
+
+constexpr std::array<CharClass, 256> CharClasses = make_char_classes();
+constexpr TransitionTable Transitions = make_transitions();
+constexpr std::array<TokenType, StateCount> Accepting = make_accepting();
+
+CharClass char_class(char sym)
+{
+    return CharClasses[static_cast<unsigned char>(sym)];
+}
+
+// States that loop over a whole run of bytes hand the rest of the run to a
+// vectorised kernel instead of taking one transition per byte.
+const char* skip_run(State state, const char* pos, const char* end)
+{
+    switch (state) {
+    case Identifier:
+        return rdb::parser::skip_alnum(pos, end);
+    case Integer:
+    case SignedInteger:
+    case Real:
+        return rdb::parser::skip_digits(pos, end);
+    case Text:
+        return rdb::parser::skip_text(pos, end);
+    default:
+        return pos;
+    }
+}
+
+// Keywords are found with a perfect hash of the case-folded length, first and
+// last letter. The seed is searched for at compile time so that no two
+// keywords of TokenTypes share a slot; a hit is then confirmed by one
+// case-insensitive comparison.
+constexpr uint32_t KeywordSlotBits = 6;
+constexpr uint32_t NoKeywordSeed = UINT32_MAX;
+
+constexpr uint32_t keyword_hash_mix(uint32_t hash, uint32_t value)
+{
+    hash = (hash ^ value) * 0x9e3779b1U;
+    return hash ^ (hash >> 15);
+}
+
+constexpr size_t keyword_hash(std::string_view word, uint32_t seed)
+{
+    uint32_t hash = keyword_hash_mix(seed, word.length());
+    hash = keyword_hash_mix(
+            hash, static_cast<unsigned char>(word.front()) | 0x20U);
+    hash = keyword_hash_mix(
+            hash, static_cast<unsigned char>(word.back()) | 0x20U);
+    return (hash * 0x9e3779b1U) >> (32 - KeywordSlotBits);
+}
+
+constexpr uint32_t find_keyword_seed()
+{
+    for (uint32_t seed = 0; seed < 4096; seed++) {
+        std::array<bool, 1U << KeywordSlotBits> used{};
+        bool collision = false;
+        for (auto&& info : rdb::parser::TokenTypes) {
+            if (info.keyword.empty()) {
+                continue;
+            }
+            size_t slot = keyword_hash(info.keyword, seed);
+            collision = collision || used[slot];
+            used[slot] = true;
+        }
+        if (!collision) {
+            return seed;
+        }
+    }
+    return NoKeywordSeed;
+}
+
+constexpr uint32_t KeywordSeed = find_keyword_seed();
+static_assert(
+        KeywordSeed != NoKeywordSeed,
+        "Keywords must differ in length, first or last letter");
+
+// TokenType::Unknown marks an empty slot.
+constexpr std::array<TokenType, 1U << KeywordSlotBits> make_keyword_slots()
+{
+    std::array<TokenType, 1U << KeywordSlotBits> slots{};
+    for (auto& slot : slots) {
+        slot = TokenType::Unknown;
+    }
+    for (auto&& info : rdb::parser::TokenTypes) {
+        if (!info.keyword.empty()) {
+            slots[keyword_hash(info.keyword, KeywordSeed)] = info.type;
+        }
+    }
+    return slots;
+}
+
+constexpr std::array<TokenType, 1U << KeywordSlotBits> KeywordSlots
+        = make_keyword_slots();
+
+// Keywords are only recognised when followed by whitespace, a bracket, ';',
+// ',' or the end of input; "FROM=" is an identifier followed by '='.
+bool ends_keyword(const char* pos, const char* end)
+{
+    if (pos == end) {
+        return true;
+    }
+    switch (char_class(*pos)) {
+    case Blank:
+    case LineBreak:
+    case Space:
+    case ParenOpen:
+    case ParenClose:
+    case SemicolonSym:
+    case CommaSym:
+        return true;
+    default:
+        return false;
+    }
+}
+
+TokenType classify_identifier(std::string_view lexeme)
+{
+    TokenType type = KeywordSlots[keyword_hash(lexeme, KeywordSeed)];
+    if (type == TokenType::Unknown) {
+        return TokenType::VarId;
+    }
+    std::string_view keyword
+            = rdb::parser::TokenTypes[static_cast<size_t>(type)].keyword;
+    if (keyword.length() != lexeme.length()) {
+        return TokenType::VarId;
+    }
+    // Identifiers only hold letters and digits, and clearing bit 5 upcases a
+    // letter while never turning a digit into one.
+    for (size_t pos = 0; pos < lexeme.length(); pos++) {
+        if ((lexeme[pos] & ~0x20) != keyword[pos]) {
+            return TokenType::VarId;
+        }
+    }
+    return type;
+}
+} // namespace
+
+ScannedToken rdb::parser::scan_token(const char* begin, const char* end)
+{
+    // Maximal munch: run the DFA until it dies and keep the last accepting
+    // prefix, which falls back e.g. from "12." to the integer "12".
+    State state = Start;
+    TokenType type = TokenType::Unknown;
+    size_t length = 1;
+    for (const char* pos = begin; pos != end; pos++) {
+        state = Transitions[state][char_class(*pos)];
+        if (state == Dead) {
+            break;
+        }
+        pos = skip_run(state, pos + 1, end) - 1;
+        if (Accepting[state] != TokenType::Unknown) {
+            type = Accepting[state];
+            length = pos - begin + 1;
+        }
+    }
+
+    if (type == TokenType::VarId && ends_keyword(begin + length, end)) {
+        type = classify_identifier(std::string_view(begin, length));
+    }
+    return {type, length};
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "librdb/Token.hpp"
+#include <cstddef>
+
+namespace rdb::parser {
+struct ScannedToken {
+    TokenType type;
+    size_t length;
+};
+
+// Recognises the token starting at begin, which must be before end and not
+// whitespace. A byte that starts no token is a one-byte TokenType::Unknown.
+ScannedToken scan_token(const char* begin, const char* end);
+} // namespace rdb::parser
@@ -0,0 +1,98 @@
+#include "TokenStream.hpp"
+#include "ScanKernels.hpp"
+#include "Scanner.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using rdb::parser::Token;
+using rdb::parser::TokenCursor;
+using rdb::parser::TokenStream;
+using rdb::parser::TokenType;
+
+size_t TokenStream::size() const
+{
+    return types.size();
+}
+
+TokenType TokenStream::type(size_t index) const
+{
+    return static_cast<TokenType>(types[index]);
+}
+
+std::string_view TokenStream::lexeme(size_t index) const
+{
+    return source.substr(offsets[index], lengths[index]);
+}
+
+TokenStream rdb::parser::tokenize_all(std::string_view source)
+{
+    if (source.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("tokenize_all: source exceeds 4 GiB");
+    }
+
+    TokenStream stream;
+    stream.source = source;
+    // Scripts average well over four bytes per token.
+    size_t expected_tokens = source.size() / 4 + 1;
+    stream.types.reserve(expected_tokens);
+    stream.offsets.reserve(expected_tokens);
+    stream.lengths.reserve(expected_tokens);
+
+    const char* begin = source.data();
+    const char* end = begin + source.size();
+    const char* pos = rdb::parser::skip_whitespace(begin, end);
+    while (pos != end) {
+        auto [type, length] = rdb::parser::scan_token(pos, end);
+        stream.types.push_back(static_cast<uint8_t>(type));
+        stream.offsets.push_back(static_cast<uint32_t>(pos - begin));
+        stream.lengths.push_back(static_cast<uint32_t>(length));
+        pos = rdb::parser::skip_whitespace(pos + length, end);
+    }
+    stream.types.push_back(static_cast<uint8_t>(TokenType::EndOfFile));
+    stream.offsets.push_back(static_cast<uint32_t>(source.size()));
+    stream.lengths.push_back(0);
+    return stream;
+}
+
+TokenCursor::TokenCursor(const TokenStream& stream) : stream{stream}, next{0}
+{
+}
+
+Token TokenCursor::get()
+{
+    Token token = make_token(next);
+    next = std::min(next + 1, stream.size() - 1);
+    return token;
+}
+
+Token TokenCursor::peek(size_t n)
+{
+    return make_token(std::min(next + n, stream.size() - 1));
+}
+
+Token TokenCursor::skip_past_semicolon()
+{
+    const auto semicolon = static_cast<uint8_t>(TokenType::Semicolon);
+    const size_t last = stream.size() - 1;
+    while (next != last && stream.types[next] != semicolon) {
+        next++;
+    }
+    return get();
+}
+
+size_t TokenCursor::index() const
+{
+    return next;
+}
+
+std::string_view TokenCursor::source() const
+{
+    return stream.source;
+}
+
+Token TokenCursor::make_token(size_t index) const
+{
+    return Token(
+            stream.type(index), stream.lexeme(index), stream.offsets[index]);
+}
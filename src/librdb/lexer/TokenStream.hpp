@@ -0,0 +1,45 @@
+#pragma once
+
+#include "librdb/Token.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace rdb::parser {
+// A whole script lexed in one pass, stored as parallel arrays indexed by
+// token number instead of as Token objects. The last token is always
+// EndOfFile, at offset source.size().
+struct TokenStream {
+    std::string_view source;
+    std::vector<uint8_t> types;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+
+    size_t size() const;
+    TokenType type(size_t index) const;
+    std::string_view lexeme(size_t index) const;
+};
+
+// Throws std::length_error for sources of 4 GiB or more, whose offsets do not
+// fit the stream; such scripts can still be lexed incrementally by Lexer.
+TokenStream tokenize_all(std::string_view source);
+
+// Walks a TokenStream through the same get()/peek() interface as Lexer, so the
+// parser can consume either.
+class TokenCursor {
+public:
+    explicit TokenCursor(const TokenStream& stream);
+    Token get();
+    // Peeking past the end yields the final EndOfFile token.
+    Token peek(size_t n = 0);
+    // As Lexer::skip_past_semicolon().
+    Token skip_past_semicolon();
+    size_t index() const;
+    std::string_view source() const;
+
+private:
+    const TokenStream& stream;
+    size_t next;
+    Token make_token(size_t index) const;
+};
+} // namespace rdb::parser
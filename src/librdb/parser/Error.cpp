@@ -2,10 +2,12 @@
 
 using rdb::parser::Error;
 using rdb::parser::ErrorType;
+using rdb::parser::LineIndex;
+using rdb::parser::Position;
 using rdb::parser::TokenType;
 
 Error::Error(Token token, ErrorType type, TokenType expected)
-    : token_{token}, type_{type}, expected_{expected}
+    : token_{token}, type_{type}, expected_{expected}, position_{0, 0}
 {
 }
 
@@ -19,9 +21,21 @@ TokenType Error::token_type() const
     return token_.type;
 }
 
+Position Error::position() const
+{
+    return position_;
+}
+
+void Error::locate(const LineIndex& line_index)
+{
+    position_ = line_index.locate(token_.offset);
+}
+
 std::ostream& rdb::parser::operator<<(std::ostream& os, const Error& error)
 {
-    os << "! " << error.token_ << ":\n";
+    os << "! (" << error.token_.type << ", " << error.token_.lexeme
+       << ") at row " << error.position_.row << ", col "
+       << error.position_.col << ":\n";
     os << "  Error::" << error.type_;
     if (error.expected_ != TokenType::Unknown) {
         os << " (expected " << error.expected_ << ")";
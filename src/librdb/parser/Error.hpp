@@ -1,6 +1,7 @@
 #pragma once
 
 #include "librdb/Token.hpp"
+#include "librdb/lexer/LineIndex.hpp"
 
 namespace rdb::parser {
 enum class ErrorType {
@@ -21,11 +22,15 @@ public:
     Error(Token token, ErrorType type, TokenType expected = TokenType::Unknown);
     ErrorType type() const;
     TokenType token_type() const;
+    // Where the offending token is; row and col stay 0 until located.
+    Position position() const;
+    void locate(const LineIndex& line_index);
 
 private:
     Token token_;
     ErrorType type_;
     TokenType expected_;
+    Position position_;
 
     friend std::ostream&
     operator<<(std::ostream& os, const rdb::parser::Error& error);
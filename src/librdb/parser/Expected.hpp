@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Error.hpp"
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace rdb::parser {
+// The result of a step that may fail on malformed input: either a value or
+// the Error describing why there is none. The parser returns these instead
+// of throwing, as a script may well have more bad statements than good ones.
+// An Error converts to an Expected of any type, so a failure is passed on
+// with `return result.error();`. Other layers, such as the engine, put
+// their own error type in E.
+//
+// value(), operator* and operator-> require has_value(), and error() the
+// opposite; debug builds assert it.
+template <typename T, typename E = Error>
+class Expected {
+public:
+    Expected(T value) : state_{std::in_place_index<0>, std::move(value)}
+    {
+    }
+    Expected(E error) : state_{std::in_place_index<1>, std::move(error)}
+    {
+    }
+
+    bool has_value() const
+    {
+        return state_.index() == 0;
+    }
+    explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    T& value()
+    {
+        assert(has_value());
+        return *std::get_if<0>(&state_);
+    }
+    const T& value() const
+    {
+        assert(has_value());
+        return *std::get_if<0>(&state_);
+    }
+    T& operator*()
+    {
+        return value();
+    }
+    const T& operator*() const
+    {
+        return value();
+    }
+    T* operator->()
+    {
+        return &value();
+    }
+    const T* operator->() const
+    {
+        return &value();
+    }
+
+    const E& error() const
+    {
+        assert(!has_value());
+        return *std::get_if<1>(&state_);
+    }
+
+private:
+    std::variant<T, E> state_;
+};
+
+// For steps that only produce side effects.
+template <typename E>
+class Expected<void, E> {
+public:
+    Expected() = default;
+    Expected(E error) : error_{std::move(error)}
+    {
+    }
+
+    bool has_value() const
+    {
+        return !error_.has_value();
+    }
+    explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    const E& error() const
+    {
+        assert(!has_value());
+        return *error_;
+    }
+
+private:
+    std::optional<E> error_;
+};
+} // namespace rdb::parser
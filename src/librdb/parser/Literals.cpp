@@ -0,0 +1,142 @@
+#include "Literals.hpp"
+#include "librdb/Platform.hpp"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+// Longest runs of digits that the fast paths take: two words' worth for an
+// integer, provided long can hold any such number, and for a real what a
+// double holds exactly.
+constexpr size_t MaxFastIntDigits
+        = (std::numeric_limits<long>::digits10 < 16)
+        ? std::numeric_limits<long>::digits10
+        : 16;
+constexpr size_t MaxFastRealDigits = 15;
+
+constexpr double Powers10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+#if defined(RDB_LITTLE_ENDIAN)
+constexpr uint64_t Bytes = 0x0101010101010101ULL;
+
+// Whether all eight bytes of word are digits: neither adding 0x46 nor
+// subtracting 0x30 may carry into the top bit of any byte.
+bool all_digits(uint64_t word)
+{
+    return (((word + 0x46 * Bytes) | (word - 0x30 * Bytes)) & (0x80 * Bytes))
+            == 0;
+}
+
+// Eight digits, the first one in the lowest byte, combined pairwise: bytes
+// into two-digit, then four-digit and finally one eight-digit number.
+uint64_t decode_word(uint64_t word)
+{
+    word -= '0' * Bytes;
+    word = (word * 10) + (word >> 8);
+    return (((word & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32)))
+            + (((word >> 16) & 0x000000ff000000ffULL)
+               * (1 + (10000ULL << 32))))
+            >> 32;
+}
+#endif
+
+// Appends the digits in [pos, end) to number, eight at a time while there
+// are as many left, or returns false if any of the bytes is not a digit. The
+// caller bounds their count so that number cannot overflow.
+bool accumulate_digits(const char* pos, const char* end, uint64_t& number)
+{
+#if defined(RDB_LITTLE_ENDIAN)
+    for (; end - pos >= 8; pos += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, pos, 8);
+        if (!all_digits(word)) {
+            return false;
+        }
+        number = number * 100000000 + decode_word(word);
+    }
+#endif
+    // The few digits left are checked together, without a branch each.
+    bool digits = true;
+    for (; pos != end; pos++) {
+        auto digit = static_cast<unsigned char>(*pos - '0');
+        digits &= (digit <= 9);
+        number = number * 10 + digit;
+    }
+    return digits;
+}
+
+size_t sign_length(std::string_view lexeme)
+{
+    return (!lexeme.empty()
+            && ((lexeme.front() == '-') || (lexeme.front() == '+')))
+            ? 1
+            : 0;
+}
+
+// from_chars takes a '-' but no '+', and may stop before the lexeme ends.
+template <typename T>
+std::errc decode_slow(std::string_view lexeme, T& value)
+{
+    size_t sign = (!lexeme.empty() && (lexeme.front() == '+')) ? 1 : 0;
+    if ((sign == 1) && ((lexeme.size() == 1) || (lexeme[1] == '-'))) {
+        return std::errc::invalid_argument;
+    }
+    const char* end = lexeme.data() + lexeme.size();
+    T result{};
+    auto [ptr, ec]{std::from_chars(lexeme.data() + sign, end, result)};
+    if (ec != std::errc()) {
+        return ec;
+    }
+    if (ptr != end) {
+        return std::errc::invalid_argument;
+    }
+    value = result;
+    return std::errc();
+}
+} // namespace
+
+std::errc rdb::parser::decode_int(std::string_view lexeme, long& value)
+{
+    // Below a word's worth of digits, from_chars is already as fast.
+    size_t sign = sign_length(lexeme);
+    size_t digits = lexeme.size() - sign;
+    if ((digits < 8) || (digits > MaxFastIntDigits)) {
+        return decode_slow(lexeme, value);
+    }
+    const char* begin = lexeme.data() + sign;
+    const char* end = lexeme.data() + lexeme.size();
+    uint64_t number = 0;
+    if (!accumulate_digits(begin, end, number)) {
+        return decode_slow(lexeme, value);
+    }
+    value = (lexeme.front() == '-') ? -static_cast<long>(number)
+                                    : static_cast<long>(number);
+    return std::errc();
+}
+
+std::errc rdb::parser::decode_real(std::string_view lexeme, double& value)
+{
+    // Less the sign and the '.', the digits must fit in MaxFastRealDigits.
+    size_t sign = sign_length(lexeme);
+    if (lexeme.size() - sign > MaxFastRealDigits + 1) {
+        return decode_slow(lexeme, value);
+    }
+    const char* begin = lexeme.data() + sign;
+    const char* end = lexeme.data() + lexeme.size();
+    auto* dot = static_cast<const char*>(std::memchr(begin, '.', end - begin));
+    uint64_t mantissa = 0;
+    if ((dot == nullptr) || (dot == begin) || (dot + 1 == end)
+        || !accumulate_digits(begin, dot, mantissa)
+        || !accumulate_digits(dot + 1, end, mantissa)) {
+        return decode_slow(lexeme, value);
+    }
+    // Both the digits as an integer and the power of ten are exact doubles,
+    // so their quotient is the correctly rounded value.
+    double number
+            = static_cast<double>(mantissa) / Powers10[end - (dot + 1)];
+    value = (lexeme.front() == '-') ? -number : number;
+    return std::errc();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+#include <system_error>
+
+namespace rdb::parser {
+// Decoding of numeric literals as the lexer reads them: an optional sign,
+// then digits, with a '.' and more digits for a real. Like std::from_chars,
+// neither allocates, throws nor depends on the locale, and failure is
+// reported through the returned code: std::errc::result_out_of_range when
+// the number does not fit, std::errc::invalid_argument when the lexeme is
+// not entirely a number. value is only written on success.
+//
+// Integers of 8 to 16 digits, and reals of up to 15 digits in all, are
+// decoded eight digits at a time within a 64-bit word; everything else,
+// other shapes of number included, is handed to std::from_chars, which is
+// as fast on the shorter integers.
+std::errc decode_int(std::string_view lexeme, long& value);
+std::errc decode_real(std::string_view lexeme, double& value);
+} // namespace rdb::parser
@@ -0,0 +1,121 @@
+#include "ParallelParser.hpp"
+#include "librdb/lexer/ScanKernels.hpp"
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using rdb::WorkStealingPool;
+using rdb::parser::ParseResult;
+using rdb::parser::Position;
+
+namespace {
+constexpr size_t MinChunkSize = 64 * 1024;
+// Chunks per thread when the size is picked automatically.
+constexpr size_t ChunksPerThread = 8;
+
+// Cuts script just past semicolons that end a statement, about chunk_size
+// bytes apart. Literals never span a line, so the byte after a line break is
+// outside any of them and the search for the next semicolon can start there.
+std::vector<std::string_view>
+split_statements(std::string_view script, size_t chunk_size)
+{
+    std::vector<std::string_view> chunks;
+    const char* begin = script.data();
+    const char* end = begin + script.size();
+    while (static_cast<size_t>(end - begin) > chunk_size) {
+        const char* cut = rdb::parser::skip_line(begin + chunk_size, end);
+        if (cut != end) {
+            cut = rdb::parser::find_statement_end(cut + 1, end);
+        }
+        if (cut == end) {
+            break;
+        }
+        cut++;
+        chunks.emplace_back(begin, cut - begin);
+        begin = cut;
+    }
+    chunks.emplace_back(begin, end - begin);
+    return chunks;
+}
+
+// Where the text following chunk starts, if chunk itself starts at origin.
+Position advance(Position origin, std::string_view chunk)
+{
+    size_t newlines = rdb::parser::count_newlines(
+            chunk.data(), chunk.data() + chunk.size());
+    if (newlines == 0) {
+        origin.col += chunk.size();
+    } else {
+        origin.row += newlines;
+        origin.col = chunk.size() - chunk.rfind('\n');
+    }
+    return origin;
+}
+} // namespace
+
+ParseResult rdb::parser::parse_sql_parallel(
+        std::string_view sql_inquiry, WorkStealingPool& pool, size_t chunk_size)
+{
+    if (chunk_size == 0) {
+        chunk_size = std::max(
+                MinChunkSize,
+                sql_inquiry.size() / (pool.size() * ChunksPerThread));
+    }
+    const auto chunks = split_statements(sql_inquiry, chunk_size);
+    if (chunks.size() == 1) {
+        return rdb::parser::parse_sql(sql_inquiry);
+    }
+
+    // Each chunk's errors are located from the position it starts at, which
+    // takes the line breaks of all chunks before it.
+    std::vector<Position> origins(chunks.size());
+    pool.run(chunks.size(), [&chunks, &origins](size_t index) {
+        origins[index] = advance({1, 1}, chunks[index]);
+    });
+    Position origin{1, 1};
+    for (size_t index = 0; index < chunks.size(); index++) {
+        Position end = origins[index];
+        origins[index] = origin;
+        origin.col = (end.row == 1) ? origin.col + end.col - 1 : end.col;
+        origin.row += end.row - 1;
+    }
+
+    std::vector<std::optional<ParseResult>> parts(chunks.size());
+    pool.run(chunks.size(), [&chunks, &origins, &parts](size_t index) {
+        parts[index].emplace(
+                rdb::parser::parse_sql(chunks[index], origins[index]));
+    });
+
+    ParseResult sql;
+    auto& statements = sql.sql_script.sql_statements;
+    size_t statement_count = 0;
+    size_t error_count = 0;
+    for (auto&& part : parts) {
+        statement_count += part->sql_script.sql_statements.size();
+        error_count += part->errors.size();
+    }
+    statements.reserve(statement_count);
+    sql.errors.reserve(error_count);
+    sql.merged_arenas.reserve(parts.size());
+    for (auto&& part : parts) {
+        auto& part_statements = part->sql_script.sql_statements;
+        std::move(
+                part_statements.begin(),
+                part_statements.end(),
+                std::back_inserter(statements));
+        part_statements.clear();
+        sql.errors.insert(
+                sql.errors.end(), part->errors.begin(), part->errors.end());
+        sql.merged_arenas.push_back(std::move(part->arena));
+    }
+    return sql;
+}
+
+ParseResult rdb::parser::parse_sql_parallel(
+        std::string_view sql_inquiry, unsigned threads, size_t chunk_size)
+{
+    WorkStealingPool pool(threads);
+    return rdb::parser::parse_sql_parallel(sql_inquiry, pool, chunk_size);
+}
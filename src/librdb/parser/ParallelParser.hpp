@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Parser.hpp"
+#include "librdb/WorkStealingPool.hpp"
+#include <cstddef>
+#include <string_view>
+
+namespace rdb::parser {
+// Parses a script on several threads: it is cut into chunks at semicolons
+// that end a statement, the chunks are parsed independently on the pool, and
+// their results are merged in script order. As with StreamParser, cutting
+// there leaves the statements and errors exactly those of parse_sql(), the
+// latter at the same rows and columns.
+//
+// chunk_size is roughly how many bytes each chunk holds; 0 picks enough
+// chunks per thread for stealing to even out their differences. Scripts that
+// make a single chunk are parsed on the calling thread alone.
+ParseResult parse_sql_parallel(
+        std::string_view, rdb::WorkStealingPool& pool, size_t chunk_size = 0);
+// As above on a pool of its own; threads == 0 means one per core.
+ParseResult parse_sql_parallel(
+        std::string_view, unsigned threads = 0, size_t chunk_size = 0);
+} // namespace rdb::parser
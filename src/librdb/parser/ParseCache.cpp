@@ -0,0 +1,132 @@
+#include "ParseCache.hpp"
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+using rdb::parser::ParseCache;
+using rdb::parser::ParseResult;
+
+namespace {
+// Passes allocations on to the default resource, counting the bytes held.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocated() const
+    {
+        return bytes;
+    }
+
+private:
+    std::pmr::memory_resource* upstream = std::pmr::get_default_resource();
+    size_t bytes = 0;
+
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        void* memory = upstream->allocate(size, alignment);
+        bytes += size;
+        return memory;
+    }
+    void do_deallocate(void* memory, size_t size, size_t alignment) override
+    {
+        upstream->deallocate(memory, size, alignment);
+        bytes -= size;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other)
+            const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+// Members are declared in the order they depend on each other: the arena of
+// result allocates from upstream, and its statements and errors view script.
+struct ParseCache::Entry {
+    CountingResource upstream;
+    const std::string script;
+    const ParseResult result;
+    const size_t memory_used;
+
+    explicit Entry(std::string_view text)
+        : script{text},
+          result{rdb::parser::parse_sql(script, &upstream)},
+          memory_used{
+                  sizeof(Entry) + script.capacity() + upstream.allocated()
+                  + result.sql_script.sql_statements.capacity()
+                          * sizeof(rdb::parser::SqlStatement)
+                  + result.errors.capacity() * sizeof(rdb::parser::Error)}
+    {
+    }
+};
+
+ParseCache::ParseCache(size_t memory_budget) : budget{memory_budget}
+{
+}
+
+ParseCache::~ParseCache() = default;
+
+std::shared_ptr<const ParseResult> ParseCache::parse(std::string_view script)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(script);
+        if (found != index.end()) {
+            counters.hits++;
+            entries.splice(entries.begin(), entries, found->second);
+            const auto& entry = *found->second;
+            return {entry, &entry->result};
+        }
+        counters.misses++;
+    }
+
+    auto entry = std::make_shared<const Entry>(script);
+    std::shared_ptr<const ParseResult> result(entry, &entry->result);
+    if (entry->memory_used > budget) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have parsed the same script in the meantime.
+    if (index.count(entry->script) != 0) {
+        return result;
+    }
+    evict_to(budget - entry->memory_used);
+    entries.push_front(entry);
+    index.emplace(entry->script, entries.begin());
+    counters.entries++;
+    counters.memory_used += entry->memory_used;
+    return result;
+}
+
+ParseCache::Stats ParseCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+size_t ParseCache::memory_budget() const
+{
+    return budget;
+}
+
+void ParseCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    counters.entries = 0;
+    counters.memory_used = 0;
+}
+
+// Evicts the least recently used entries until at most memory_used bytes are
+// held. The caller holds the lock.
+void ParseCache::evict_to(size_t memory_used)
+{
+    while (counters.memory_used > memory_used) {
+        const auto& entry = entries.back();
+        index.erase(entry->script);
+        counters.memory_used -= entry->memory_used;
+        counters.entries--;
+        counters.evictions++;
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Parser.hpp"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace rdb::parser {
+// Remembers the results of parse_sql() for the scripts parsed most recently,
+// so a script that is parsed again costs one hash of its text and a lookup.
+// Every entry keeps its own copy of the script, which its statements and
+// errors point into, so results stay valid after the caller's text is gone.
+//
+// The cache holds at most memory_budget bytes: each entry is charged for its
+// copy of the script, its arena and its statement and error vectors. When
+// that is exceeded, the least recently used entries are evicted; a result
+// handed out before stays valid as long as it is held. Scripts whose entry
+// alone would exceed the budget are parsed but not cached.
+//
+// All members may be called from several threads at once. Scripts are
+// parsed outside the lock, so misses do not hold up other threads.
+class ParseCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t entries = 0;
+        size_t memory_used = 0;
+    };
+
+    explicit ParseCache(size_t memory_budget);
+    ParseCache(const ParseCache&) = delete;
+    ParseCache& operator=(const ParseCache&) = delete;
+    ~ParseCache();
+
+    std::shared_ptr<const ParseResult> parse(std::string_view script);
+    Stats stats() const;
+    size_t memory_budget() const;
+    // Drops every entry; the counters are kept.
+    void clear();
+
+private:
+    struct Entry;
+    using EntryList = std::list<std::shared_ptr<const Entry>>;
+
+    const size_t budget;
+    mutable std::mutex mutex;
+    // Most recently used first. The keys view the scripts of the entries.
+    EntryList entries;
+    std::unordered_map<std::string_view, EntryList::iterator> index;
+    Stats counters;
+
+    void evict_to(size_t memory_used);
+};
+} // namespace rdb::parser
@@ -1,415 +1,895 @@
 #include "Parser.hpp"
-#include <charconv>
-#include <stdexcept>
+#include "Expected.hpp"
+#include "Literals.hpp"
+#include <array>
 
+using rdb::parser::Arena;
+using rdb::parser::ArenaArray;
 using rdb::parser::Error;
 using rdb::parser::ErrorType;
+using rdb::parser::Expected;
 using rdb::parser::Lexer;
+using rdb::parser::LineIndex;
+using rdb::parser::BasicParseResult;
 using rdb::parser::ParseResult;
-using rdb::parser::SqlStatementPtr;
+using rdb::parser::ParseResultView;
+using rdb::parser::Position;
+using rdb::parser::Sequence;
+using rdb::parser::String;
 using rdb::parser::Token;
+using rdb::parser::TokenCursor;
+using rdb::parser::TokenStream;
 using rdb::parser::TokenType;
 
-std::ostream&
-rdb::parser::operator<<(std::ostream& os, const rdb::parser::SqlScript& sql)
+template <typename Text>
+rdb::parser::BasicParseResult<Text>::BasicParseResult()
+    : arena{std::make_unique<Arena>()}
 {
-    for (auto&& statement_ptr : sql.sql_statements) {
-        auto* statement = statement_ptr.get();
-        os << *statement << "\n";
+}
+
+template <typename Text>
+rdb::parser::BasicParseResult<Text>::BasicParseResult(
+        std::pmr::memory_resource* upstream)
+    : arena{std::make_unique<Arena>(upstream)}
+{
+}
+
+template <typename Text>
+std::ostream& rdb::parser::operator<<(
+        std::ostream& os, const rdb::parser::BasicSqlScript<Text>& sql)
+{
+    for (auto&& statement : sql.sql_statements) {
+        os << statement << "\n";
     }
     return os;
 }
 
 namespace {
-std::string parse_token(Lexer& lexer, const TokenType& expected_token)
+// Collects the values of one column of an INSERT, keeping them unboxed as
+// long as they are all of one type. Text is kept as the lexemes until the
+// column is built, so it is copied once, at its final size.
+template <typename Text>
+class ColumnBuilder {
+public:
+    void clear()
+    {
+        kind = Kind::Empty;
+        ints.clear();
+        reals.clear();
+        texts.clear();
+        boxed.clear();
+    }
+
+    void add(long value)
+    {
+        if (settle(Kind::Ints)) {
+            ints.push_back(value);
+        } else {
+            boxed.emplace_back(value);
+        }
+    }
+    void add(double value)
+    {
+        if (settle(Kind::Reals)) {
+            reals.push_back(value);
+        } else {
+            boxed.emplace_back(value);
+        }
+    }
+    void add(std::string_view lexeme)
+    {
+        if (settle(Kind::Texts)) {
+            texts.push_back(lexeme);
+        } else {
+            boxed.emplace_back(lexeme);
+        }
+    }
+    void add(rdb::parser::Placeholder placeholder)
+    {
+        settle(Kind::Boxed);
+        boxed.emplace_back(placeholder);
+    }
+
+    rdb::parser::BasicValueColumn<Text> build(Arena& arena) const
+    {
+        switch (kind) {
+        case Kind::Ints:
+            return ArenaArray<long>(arena, ints.begin(), ints.end());
+        case Kind::Reals:
+            return ArenaArray<double>(arena, reals.begin(), reals.end());
+        case Kind::Texts:
+            return rdb::parser::BasicTextColumn<Text>(arena, texts);
+        default: {
+            using Value = rdb::parser::BasicValue<Text>;
+            std::pmr::polymorphic_allocator<Value> allocator(&arena);
+            Value* column = allocator.allocate(boxed.size());
+            for (size_t row = 0; row < boxed.size(); row++) {
+                new (column + row) Value(std::visit(
+                        [&arena](auto&& v) -> Value {
+                            using Alternative = std::decay_t<decltype(v)>;
+                            if constexpr (std::is_same_v<
+                                                  Alternative,
+                                                  std::string_view>) {
+                                return rdb::parser::make_text<Text>(v, arena);
+                            } else {
+                                return v;
+                            }
+                        },
+                        boxed[row]));
+            }
+            return ArenaArray<Value>(column, boxed.size());
+        }
+        }
+    }
+
+private:
+    enum class Kind { Empty, Ints, Reals, Texts, Boxed };
+
+    Kind kind = Kind::Empty;
+    std::vector<long> ints;
+    std::vector<double> reals;
+    std::vector<std::string_view> texts;
+    std::vector<rdb::parser::ValueView> boxed;
+
+    // Whether a value of the given kind can stay unboxed; if not, boxes the
+    // values so far.
+    bool settle(Kind value_kind)
+    {
+        if (kind == Kind::Empty) {
+            kind = value_kind;
+        }
+        if (kind == value_kind) {
+            return value_kind != Kind::Boxed;
+        }
+        if (kind != Kind::Boxed) {
+            boxed.assign(ints.begin(), ints.end());
+            boxed.insert(boxed.end(), reals.begin(), reals.end());
+            boxed.insert(boxed.end(), texts.begin(), texts.end());
+            kind = Kind::Boxed;
+        }
+        return false;
+    }
+};
+
+// The arena that statement text and lists are allocated from, plus scratch
+// lists reused from one statement to the next. A sequence grown element by
+// element in the arena would leave each outgrown buffer behind, so lists are
+// collected here first and then moved into the arena at their final size.
+// Text is String or std::string_view, picking the flavour of AST to build.
+template <typename Text>
+struct ParseContext {
+    Arena& arena;
+    std::vector<rdb::parser::BasicColumnDef<Text>> column_defs;
+    std::vector<Text> names;
+    // One per column of the INSERT being parsed; only the first ones are in
+    // use when it has fewer columns than one before.
+    std::vector<ColumnBuilder<Text>> columns;
+    // Placeholders met so far in the statement being parsed.
+    size_t placeholders;
+
+    Text text(std::string_view lexeme)
+    {
+        return rdb::parser::make_text<Text>(lexeme, arena);
+    }
+
+    rdb::parser::Placeholder placeholder()
+    {
+        return {placeholders++};
+    }
+};
+
+template <typename T>
+void move_to_arena(std::vector<T>& scratch, Sequence<T>& sequence)
+{
+    sequence.assign(
+            std::make_move_iterator(scratch.begin()),
+            std::make_move_iterator(scratch.end()));
+    scratch.clear();
+}
+
+template <typename TokenSource>
+Expected<std::string_view>
+parse_token(TokenSource& lexer, const TokenType& expected_token)
 {
     Token token = lexer.get();
     if (token.type != expected_token) {
         if (token.type == TokenType::EndOfFile) {
-            throw Error(token, ErrorType::UnexpectedEOF, expected_token);
+            return Error(token, ErrorType::UnexpectedEOF, expected_token);
         }
-        throw Error(token, ErrorType::SyntaxError, expected_token);
+        return Error(token, ErrorType::SyntaxError, expected_token);
     }
 
-    return std::string(token.lexeme);
+    return token.lexeme;
 }
 
+// Decodes a number with rdb::parser::decode_int() or decode_real().
 template <typename T>
-rdb::parser::Value
-convert_lexeme_to_var(Token& token, const TokenType& token_type)
+Expected<T> convert_lexeme_to_var(Token& token, const TokenType& token_type)
 {
     T result{};
-    auto [ptr, ec]{std::from_chars(
-            token.lexeme.data(),
-            token.lexeme.data() + token.lexeme.size(),
-            result)};
+    std::errc ec;
+    if constexpr (std::is_same_v<T, long>) {
+        ec = rdb::parser::decode_int(token.lexeme, result);
+    } else {
+        ec = rdb::parser::decode_real(token.lexeme, result);
+    }
     if (ec == std::errc::result_out_of_range) {
-        throw Error(token, ErrorType::VarOutOfRange, token_type);
+        return Error(token, ErrorType::VarOutOfRange, token_type);
     }
     if (ec == std::errc::invalid_argument) {
-        throw Error(token, ErrorType::IncorrectVarType, token_type);
+        return Error(token, ErrorType::IncorrectVarType, token_type);
     }
 
     return result;
 }
 
-rdb::parser::Value convert_lexeme_to_double(Token& token)
+// A lexeme for either kind of number, as the type its token says.
+template <typename Text>
+Expected<rdb::parser::BasicValue<Text>> convert_number(Token& token)
 {
-    try {
-        std::string str(token.lexeme);
-        return std::stod(str);
-    } catch (const std::invalid_argument&) {
-        throw Error(token, ErrorType::IncorrectVarType, TokenType::KwReal);
-    } catch (const std::out_of_range&) {
-        throw Error(token, ErrorType::VarOutOfRange, TokenType::KwReal);
+    if (token.type == TokenType::VarInt) {
+        auto number = convert_lexeme_to_var<long>(token, TokenType::VarInt);
+        if (!number) {
+            return number.error();
+        }
+        return rdb::parser::BasicValue<Text>(*number);
+    }
+    auto number = convert_lexeme_to_var<double>(token, TokenType::KwReal);
+    if (!number) {
+        return number.error();
     }
+    return rdb::parser::BasicValue<Text>(*number);
 }
 
-void parse_operand(Lexer& lexer, rdb::parser::Operand& operand)
+template <typename TokenSource, typename Text>
+Expected<void> parse_operand(
+        TokenSource& lexer,
+        rdb::parser::BasicOperand<Text>& operand,
+        ParseContext<Text>& context)
 {
     Token token = lexer.get();
     operand.is_id = false;
 
     switch (token.type) {
     case TokenType::VarInt:
-        operand.val = convert_lexeme_to_var<long>(token, TokenType::VarInt);
-        break;
-
-    case TokenType::VarReal:
-        operand.val = convert_lexeme_to_double(token);
+    case TokenType::VarReal: {
+        auto number = convert_number<Text>(token);
+        if (!number) {
+            return number.error();
+        }
+        operand.val = std::move(*number);
         break;
+    }
 
     case TokenType::VarId:
         operand.is_id = true;
-        operand.val = std::string(token.lexeme);
+        operand.val = context.text(token.lexeme);
         break;
 
     case TokenType::VarText:
-        operand.val = std::string(token.lexeme);
+        operand.val = context.text(token.lexeme);
+        break;
+
+    case TokenType::Placeholder:
+        operand.val = context.placeholder();
         break;
 
     case TokenType::EndOfFile:
-        throw Error(token, ErrorType::UnexpectedEOF);
+        return Error(token, ErrorType::UnexpectedEOF);
 
     default:
-        throw Error(token, ErrorType::VarSyntaxError);
+        return Error(token, ErrorType::VarSyntaxError);
     }
+    return {};
 }
 
-void parse_column_def(
-        Lexer& lexer, std::vector<rdb::parser::ColumnDef>& column_def_seq)
+template <typename TokenSource, typename Text>
+Expected<void> parse_column_def(TokenSource& lexer, ParseContext<Text>& context)
 {
-    parse_token(lexer, TokenType::ParenthesisOpening);
-    rdb::parser::ColumnDef column_def;
-    std::vector<Token> token_seq;
+    if (auto opening = parse_token(lexer, TokenType::ParenthesisOpening);
+        !opening) {
+        return opening.error();
+    }
+    context.column_defs.clear();
+    std::array<Token, 3> token_seq;
+    size_t token_count;
     Token token;
 
     do {
+        token_count = 0;
         do {
             token = lexer.get();
-            token_seq.push_back(token);
+            if (token_count < token_seq.size()) {
+                token_seq[token_count] = token;
+            }
+            token_count++;
         } while ((token.type != TokenType::ParenthesisClosing)
                  && (token.type != TokenType::Comma)
+                 && (token.type != TokenType::Semicolon)
                  && (token.type != TokenType::EndOfFile));
 
-        if (token_seq.size() == 3) {
-            if (token_seq[0].type == TokenType::VarId) {
-                if ((token_seq[1].type == TokenType::KwInt)
-                    || (token_seq[1].type == TokenType::KwReal)
-                    || (token_seq[1].type == TokenType::KwText)) {
-                    column_def.column_name = token_seq[0].lexeme;
-                    column_def.type_name = token_seq[1].type;
-                    column_def_seq.push_back(column_def);
-                } else {
-                    throw Error(token_seq[1], ErrorType::TypeSyntaxError);
-                }
-            } else {
-                throw Error(
-                        token_seq[0], ErrorType::SyntaxError, TokenType::VarId);
-            }
-        } else {
-            throw Error(token, ErrorType::WrongListDefinition);
+        // A list never runs on past the end of its statement.
+        if ((token.type == TokenType::Semicolon) || (token_count != 3)) {
+            return Error(token, ErrorType::WrongListDefinition);
         }
-
-        token_seq.clear();
+        if (token_seq[0].type != TokenType::VarId) {
+            return Error(
+                    token_seq[0], ErrorType::SyntaxError, TokenType::VarId);
+        }
+        if ((token_seq[1].type != TokenType::KwInt)
+            && (token_seq[1].type != TokenType::KwReal)
+            && (token_seq[1].type != TokenType::KwText)) {
+            return Error(token_seq[1], ErrorType::TypeSyntaxError);
+        }
+        context.column_defs.push_back(rdb::parser::BasicColumnDef<Text>{
+                context.text(token_seq[0].lexeme), token_seq[1].type});
     } while ((token.type != TokenType::ParenthesisClosing)
              && (token.type != TokenType::EndOfFile));
     if (token.type == TokenType::EndOfFile) {
-        throw Error(token, ErrorType::UnexpectedEOF);
+        return Error(token, ErrorType::UnexpectedEOF);
     }
+    return {};
 }
 
-void parse_column_list(Lexer& lexer, std::vector<std::string>& column_name_seq)
+template <typename TokenSource, typename Text>
+Expected<void>
+parse_column_list(TokenSource& lexer, ParseContext<Text>& context)
 {
+    context.names.clear();
     do {
-        std::string column_name;
-        column_name = parse_token(lexer, TokenType::VarId);
-        column_name_seq.push_back(column_name);
+        auto name = parse_token(lexer, TokenType::VarId);
+        if (!name) {
+            return name.error();
+        }
+        context.names.push_back(context.text(*name));
     } while (lexer.peek().type == TokenType::VarId);
+    return {};
 }
 
-void parse_argument_table(Lexer& lexer, std::string& table_name)
+// Expects keyword followed by a table name, which it stores in table_name.
+template <typename TokenSource, typename Text>
+Expected<void>
+parse_table_name(TokenSource& lexer, TokenType keyword, Text& table_name)
 {
-    parse_token(lexer, TokenType::KwTable);
-    table_name = parse_token(lexer, TokenType::VarId);
+    if (auto expected = parse_token(lexer, keyword); !expected) {
+        return expected.error();
+    }
+    auto name = parse_token(lexer, TokenType::VarId);
+    if (!name) {
+        return name.error();
+    }
+    table_name = *name;
+    return {};
 }
 
-void parse_argument_into(
-        Lexer& lexer,
-        std::string& table_name,
-        std::vector<std::string>& column_name_seq)
+template <typename TokenSource, typename Text>
+Expected<void> parse_argument_into(
+        TokenSource& lexer, Text& table_name, ParseContext<Text>& context)
 {
-    parse_token(lexer, TokenType::KwInto);
-    table_name = parse_token(lexer, TokenType::VarId);
-
-    parse_token(lexer, TokenType::ParenthesisOpening);
-    std::vector<Token> token_seq;
+    if (auto into = parse_table_name(lexer, TokenType::KwInto, table_name);
+        !into) {
+        return into;
+    }
+    if (auto opening = parse_token(lexer, TokenType::ParenthesisOpening);
+        !opening) {
+        return opening.error();
+    }
+    context.names.clear();
+    std::array<Token, 2> token_seq;
+    size_t token_count;
     Token token;
 
     do {
+        token_count = 0;
         do {
             token = lexer.get();
-            token_seq.push_back(token);
+            if (token_count < token_seq.size()) {
+                token_seq[token_count] = token;
+            }
+            token_count++;
         } while ((token.type != TokenType::ParenthesisClosing)
                  && (token.type != TokenType::Comma)
+                 && (token.type != TokenType::Semicolon)
                  && (token.type != TokenType::EndOfFile));
 
-        if (token_seq.size() == 2) {
-            if (token_seq[0].type == TokenType::VarId) {
-                column_name_seq.emplace_back(std::string(token_seq[0].lexeme));
-            } else {
-                throw Error(token, ErrorType::SyntaxError, TokenType::VarId);
-            }
-        } else {
-            throw Error(token, ErrorType::WrongListDefinition);
+        // A list never runs on past the end of its statement.
+        if ((token.type == TokenType::Semicolon) || (token_count != 2)) {
+            return Error(token, ErrorType::WrongListDefinition);
         }
-
-        token_seq.clear();
+        if (token_seq[0].type != TokenType::VarId) {
+            return Error(token, ErrorType::SyntaxError, TokenType::VarId);
+        }
+        context.names.push_back(context.text(token_seq[0].lexeme));
     } while ((token.type != TokenType::ParenthesisClosing)
              && (token.type != TokenType::EndOfFile));
     if (token.type == TokenType::EndOfFile) {
-        throw Error(token, ErrorType::UnexpectedEOF);
+        return Error(token, ErrorType::UnexpectedEOF);
     }
+    return {};
 }
 
-void parse_argument_values(
-        Lexer& lexer, std::vector<rdb::parser::Value>& value_seq)
+// One parenthesised row of VALUES, holding a value for each of the columns.
+template <typename TokenSource, typename Text>
+Expected<void> parse_value_row(
+        TokenSource& lexer, size_t column_count, ParseContext<Text>& context)
 {
-    parse_token(lexer, TokenType::KwValues);
-    parse_token(lexer, TokenType::ParenthesisOpening);
-    std::vector<Token> token_seq;
+    if (auto opening = parse_token(lexer, TokenType::ParenthesisOpening);
+        !opening) {
+        return opening.error();
+    }
+    std::array<Token, 2> token_seq;
+    size_t token_count;
+    size_t column = 0;
     Token token;
 
     do {
+        token_count = 0;
         do {
             token = lexer.get();
-            token_seq.push_back(token);
+            if (token_count < token_seq.size()) {
+                token_seq[token_count] = token;
+            }
+            token_count++;
         } while ((token.type != TokenType::ParenthesisClosing)
                  && (token.type != TokenType::Comma)
+                 && (token.type != TokenType::Semicolon)
                  && (token.type != TokenType::EndOfFile));
 
-        if (token_seq.size() == 2) {
-            rdb::parser::Value value;
-            switch (token_seq[0].type) {
-            case TokenType::VarInt:
-                value = convert_lexeme_to_var<long>(
-                        token_seq[0], TokenType::VarInt);
-                value_seq.push_back(value);
-                break;
-
-            case TokenType::VarReal:
-                value = convert_lexeme_to_double(token_seq[0]);
-                value_seq.push_back(value);
-                break;
-
-            case TokenType::VarText:
-                value = std::string(token_seq[0].lexeme);
-                value_seq.push_back(value);
-                break;
+        // A list never runs on past the end of its statement.
+        if ((token.type == TokenType::Semicolon) || (token_count != 2)
+            || (column == column_count)) {
+            return Error(token, ErrorType::WrongListDefinition);
+        }
+        auto& builder = context.columns[column++];
+        switch (token_seq[0].type) {
+        case TokenType::VarInt: {
+            auto number = convert_lexeme_to_var<long>(
+                    token_seq[0], TokenType::VarInt);
+            if (!number) {
+                return number.error();
+            }
+            builder.add(*number);
+            break;
+        }
 
-            default:
-                throw Error(token, ErrorType::VarSyntaxError);
+        case TokenType::VarReal: {
+            auto number = convert_lexeme_to_var<double>(
+                    token_seq[0], TokenType::KwReal);
+            if (!number) {
+                return number.error();
             }
-        } else {
-            throw Error(token, ErrorType::WrongListDefinition);
+            builder.add(*number);
+            break;
         }
 
-        token_seq.clear();
+        case TokenType::VarText:
+            builder.add(token_seq[0].lexeme);
+            break;
+
+        case TokenType::Placeholder:
+            builder.add(context.placeholder());
+            break;
+
+        default:
+            return Error(token, ErrorType::VarSyntaxError);
+        }
     } while ((token.type != TokenType::ParenthesisClosing)
              && (token.type != TokenType::EndOfFile));
     if (token.type == TokenType::EndOfFile) {
-        throw Error(token, ErrorType::UnexpectedEOF);
+        return Error(token, ErrorType::UnexpectedEOF);
+    }
+    if (column != column_count) {
+        return Error(token, ErrorType::WrongListDefinition);
+    }
+    return {};
+}
+
+// Rows are decoded straight into the builders of their columns, so a bulk
+// INSERT is not held value by value on the way.
+template <typename TokenSource, typename Text>
+Expected<size_t> parse_argument_values(
+        TokenSource& lexer, size_t column_count, ParseContext<Text>& context)
+{
+    if (auto values = parse_token(lexer, TokenType::KwValues); !values) {
+        return values.error();
     }
+    if (context.columns.size() < column_count) {
+        context.columns.resize(column_count);
+    }
+    for (size_t column = 0; column < column_count; column++) {
+        context.columns[column].clear();
+    }
+
+    size_t rows = 0;
+    do {
+        if (rows != 0) {
+            lexer.get();
+        }
+        if (auto row = parse_value_row(lexer, column_count, context); !row) {
+            return row.error();
+        }
+        rows++;
+    } while (lexer.peek().type == TokenType::Comma);
+    return rows;
 }
 
-void parse_argument_where(Lexer& lexer, rdb::parser::Expression& expression)
+template <typename TokenSource, typename Text>
+Expected<const rdb::parser::BasicExpression<Text>*>
+parse_argument_where(TokenSource& lexer, ParseContext<Text>& context)
 {
-    parse_token(lexer, TokenType::KwWhere);
-    parse_operand(lexer, expression.loperand);
-    expression.operation = parse_token(lexer, TokenType::Operation);
-    parse_operand(lexer, expression.roperand);
+    if (auto where = parse_token(lexer, TokenType::KwWhere); !where) {
+        return where.error();
+    }
+    auto* expression = rdb::parser::make_in_arena<
+            rdb::parser::BasicExpression<Text>>(
+            context.arena,
+            rdb::parser::BasicExpression<Text>{
+                    0, rdb::parser::CompareOp::Equal, 0});
+    if (auto loperand = parse_operand(lexer, expression->loperand, context);
+        !loperand) {
+        return loperand.error();
+    }
+    auto operation = parse_token(lexer, TokenType::Operation);
+    if (!operation) {
+        return operation.error();
+    }
+    expression->operation = rdb::parser::to_compare_op(*operation);
+    if (auto roperand = parse_operand(lexer, expression->roperand, context);
+        !roperand) {
+        return roperand.error();
+    }
+    return expression;
 }
 
-void parse_argument_from(
-        Lexer& lexer,
-        std::string& table_name,
-        rdb::parser::Expression& expression)
+template <typename TokenSource, typename Text>
+Expected<void> parse_argument_from(
+        TokenSource& lexer,
+        Text& table_name,
+        const rdb::parser::BasicExpression<Text>*& expression,
+        ParseContext<Text>& context)
 {
-    parse_token(lexer, TokenType::KwFrom);
-    table_name = parse_token(lexer, TokenType::VarId);
+    if (auto from = parse_table_name(lexer, TokenType::KwFrom, table_name);
+        !from) {
+        return from;
+    }
 
     if (lexer.peek().type == TokenType::KwWhere) {
-        parse_argument_where(lexer, expression);
+        auto where = parse_argument_where(lexer, context);
+        if (!where) {
+            return where.error();
+        }
+        expression = *where;
     }
+    return {};
 }
 
-SqlStatementPtr parse_statement_create(Lexer& lexer)
+// The rest of CREATE TABLE, after CREATE.
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicCreateTableStatement<Text>>
+parse_statement_create_table(TokenSource& lexer, ParseContext<Text>& context)
 {
-    std::string table_name;
-    std::vector<rdb::parser::ColumnDef> column_def_seq;
-
-    parse_token(lexer, TokenType::KwCreate);
-    parse_argument_table(lexer, table_name);
-    parse_column_def(lexer, column_def_seq);
-    parse_token(lexer, TokenType::Semicolon);
-
-    std::unique_ptr<rdb::parser::CreateTableStatement> create_table_statement
-            = std::make_unique<rdb::parser::CreateTableStatement>(
-                    std::move(table_name), std::move(column_def_seq));
-    return SqlStatementPtr(create_table_statement.release());
+    Text table_name = context.text({});
+    Sequence<rdb::parser::BasicColumnDef<Text>> column_def_seq(&context.arena);
+
+    if (auto table = parse_table_name(lexer, TokenType::KwTable, table_name);
+        !table) {
+        return table.error();
+    }
+    if (auto columns = parse_column_def(lexer, context); !columns) {
+        return columns.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
+
+    move_to_arena(context.column_defs, column_def_seq);
+    return rdb::parser::BasicCreateTableStatement<Text>(
+            std::move(table_name), std::move(column_def_seq));
 }
 
-SqlStatementPtr parse_statement_insert(Lexer& lexer)
+// The rest of CREATE [HASH] INDEX, after CREATE.
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicCreateIndexStatement<Text>>
+parse_statement_create_index(TokenSource& lexer, ParseContext<Text>& context)
 {
-    std::string table_name;
-    std::vector<std::string> column_name_seq;
-    std::vector<rdb::parser::Value> value_seq;
-
-    parse_token(lexer, TokenType::KwInsert);
-    parse_argument_into(lexer, table_name, column_name_seq);
-    parse_argument_values(lexer, value_seq);
-    parse_token(lexer, TokenType::Semicolon);
-
-    std::unique_ptr<rdb::parser::InsertStatement> insert_statement
-            = std::make_unique<rdb::parser::InsertStatement>(
-                    std::move(table_name),
-                    std::move(column_name_seq),
-                    std::move(value_seq));
-    return SqlStatementPtr(insert_statement.release());
+    Text index_name = context.text({});
+    Text table_name = context.text({});
+    Text column_name = context.text({});
+    auto kind = rdb::parser::IndexKind::Ordered;
+
+    if (lexer.peek().type == TokenType::KwHash) {
+        lexer.get();
+        kind = rdb::parser::IndexKind::Hash;
+    }
+    if (auto index = parse_table_name(lexer, TokenType::KwIndex, index_name);
+        !index) {
+        return index.error();
+    }
+    if (auto on = parse_table_name(lexer, TokenType::KwOn, table_name); !on) {
+        return on.error();
+    }
+    if (auto opening = parse_token(lexer, TokenType::ParenthesisOpening);
+        !opening) {
+        return opening.error();
+    }
+    auto column = parse_token(lexer, TokenType::VarId);
+    if (!column) {
+        return column.error();
+    }
+    column_name = *column;
+    if (auto closing = parse_token(lexer, TokenType::ParenthesisClosing);
+        !closing) {
+        return closing.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
+
+    return rdb::parser::BasicCreateIndexStatement<Text>(
+            std::move(index_name),
+            std::move(table_name),
+            std::move(column_name),
+            kind);
 }
 
-SqlStatementPtr parse_statement_select(Lexer& lexer)
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicInsertStatement<Text>>
+parse_statement_insert(TokenSource& lexer, ParseContext<Text>& context)
 {
-    std::vector<std::string> column_name_seq;
-    std::string table_name;
-    rdb::parser::Expression expression{0, "N", 0};
-
-    parse_token(lexer, TokenType::KwSelect);
-    parse_column_list(lexer, column_name_seq);
-    parse_argument_from(lexer, table_name, expression);
-    parse_token(lexer, TokenType::Semicolon);
-
-    std::unique_ptr<rdb::parser::SelectStatement> select_statement
-            = std::make_unique<rdb::parser::SelectStatement>(
-                    std::move(table_name),
-                    std::move(column_name_seq),
-                    expression);
-    return SqlStatementPtr(select_statement.release());
+    Text table_name = context.text({});
+    Sequence<Text> column_name_seq(&context.arena);
+
+    if (auto insert = parse_token(lexer, TokenType::KwInsert); !insert) {
+        return insert.error();
+    }
+    if (auto into = parse_argument_into(lexer, table_name, context); !into) {
+        return into.error();
+    }
+    move_to_arena(context.names, column_name_seq);
+    auto rows = parse_argument_values(lexer, column_name_seq.size(), context);
+    if (!rows) {
+        return rows.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
+
+    using ValueColumn = rdb::parser::BasicValueColumn<Text>;
+    std::pmr::polymorphic_allocator<ValueColumn> allocator(&context.arena);
+    size_t columns = column_name_seq.size();
+    ValueColumn* value_columns = allocator.allocate(columns);
+    for (size_t column = 0; column < columns; column++) {
+        new (value_columns + column)
+                ValueColumn(context.columns[column].build(context.arena));
+    }
+    return rdb::parser::BasicInsertStatement<Text>(
+            std::move(table_name),
+            std::move(column_name_seq),
+            ArenaArray<ValueColumn>(value_columns, columns),
+            *rows);
 }
 
-SqlStatementPtr parse_statement_delete(Lexer& lexer)
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicSelectStatement<Text>>
+parse_statement_select(TokenSource& lexer, ParseContext<Text>& context)
 {
-    std::string table_name;
-    rdb::parser::Expression expression{0, "N", 0};
+    Sequence<Text> column_name_seq(&context.arena);
+    Text table_name = context.text({});
+    const rdb::parser::BasicExpression<Text>* expression = nullptr;
 
-    parse_token(lexer, TokenType::KwDelete);
-    parse_argument_from(lexer, table_name, expression);
-    parse_token(lexer, TokenType::Semicolon);
+    if (auto select = parse_token(lexer, TokenType::KwSelect); !select) {
+        return select.error();
+    }
+    if (auto columns = parse_column_list(lexer, context); !columns) {
+        return columns.error();
+    }
+    move_to_arena(context.names, column_name_seq);
+    if (auto from = parse_argument_from(lexer, table_name, expression, context);
+        !from) {
+        return from.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
 
-    std::unique_ptr<rdb::parser::DeleteFromStatement> delete_statement
-            = std::make_unique<rdb::parser::DeleteFromStatement>(
-                    std::move(table_name), expression);
-    return SqlStatementPtr(delete_statement.release());
+    return rdb::parser::BasicSelectStatement<Text>(
+            std::move(table_name), std::move(column_name_seq), expression);
 }
 
-SqlStatementPtr parse_statement_drop(Lexer& lexer)
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicDeleteFromStatement<Text>>
+parse_statement_delete(TokenSource& lexer, ParseContext<Text>& context)
 {
-    std::string table_name;
+    Text table_name = context.text({});
+    const rdb::parser::BasicExpression<Text>* expression = nullptr;
 
-    parse_token(lexer, TokenType::KwDrop);
-    parse_argument_table(lexer, table_name);
-    parse_token(lexer, TokenType::Semicolon);
+    if (auto remove = parse_token(lexer, TokenType::KwDelete); !remove) {
+        return remove.error();
+    }
+    if (auto from = parse_argument_from(lexer, table_name, expression, context);
+        !from) {
+        return from.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
 
-    std::unique_ptr<rdb::parser::DropTableStatement> drop_statement
-            = std::make_unique<rdb::parser::DropTableStatement>(
-                    std::move(table_name));
-    return SqlStatementPtr(drop_statement.release());
+    return rdb::parser::BasicDeleteFromStatement<Text>(
+            std::move(table_name), expression);
 }
-} // namespace
 
-ParseResult rdb::parser::parse_sql(std::string_view sql_inquiry)
+template <typename TokenSource, typename Text>
+Expected<rdb::parser::BasicDropTableStatement<Text>>
+parse_statement_drop(TokenSource& lexer, ParseContext<Text>& context)
 {
-    Lexer lexer(sql_inquiry);
-    ParseResult sql;
-    Token token;
+    Text table_name = context.text({});
 
-    token = lexer.peek();
-    try {
-        while (token.type != TokenType::EndOfFile) {
-            try {
-                switch (token.type) {
-                case TokenType::KwCreate:
-                    sql.sql_script.sql_statements.emplace_back(
-                            parse_statement_create(lexer));
-                    break;
-
-                case TokenType::KwDelete:
-                    sql.sql_script.sql_statements.emplace_back(
-                            parse_statement_delete(lexer));
-                    break;
-
-                case TokenType::KwInsert:
-                    sql.sql_script.sql_statements.emplace_back(
-                            parse_statement_insert(lexer));
-                    break;
-
-                case TokenType::KwSelect:
-                    sql.sql_script.sql_statements.emplace_back(
-                            parse_statement_select(lexer));
-                    break;
-
-                case TokenType::KwDrop:
-                    sql.sql_script.sql_statements.emplace_back(
-                            parse_statement_drop(lexer));
-                    break;
-
-                default:
-                    throw Error(token, ErrorType::NotStatement);
-                }
-            } catch (const Error& error) {
-                switch (error.type()) {
-                case ErrorType::UnexpectedEOF:
-                    throw error;
-
-                default:
-                    sql.errors.push_back(error);
-                    if (error.token_type() != TokenType::Semicolon) {
-                        do {
-                            token = lexer.get();
-                        } while ((token.type != TokenType::Semicolon)
-                                 && (token.type != TokenType::EndOfFile));
-                        if (token.type == TokenType::EndOfFile) {
-                            throw Error(token, ErrorType::UnexpectedEOF);
-                        }
-                    }
-                }
-            }
+    if (auto drop = parse_token(lexer, TokenType::KwDrop); !drop) {
+        return drop.error();
+    }
+    if (auto table = parse_table_name(lexer, TokenType::KwTable, table_name);
+        !table) {
+        return table.error();
+    }
+    if (auto end = parse_token(lexer, TokenType::Semicolon); !end) {
+        return end.error();
+    }
+
+    return rdb::parser::BasicDropTableStatement<Text>(std::move(table_name));
+}
+
+// Appends a parsed statement to sql, or else its error.
+template <typename Text, typename Statement>
+Expected<void>
+add_statement(BasicParseResult<Text>& sql, Expected<Statement>&& statement)
+{
+    if (!statement) {
+        return statement.error();
+    }
+    sql.sql_script.sql_statements.emplace_back(std::move(*statement));
+    return {};
+}
+
+// CREATE TABLE or CREATE [HASH] INDEX, told apart by the token after
+// CREATE; anything else there is reported as a missing TABLE.
+template <typename Text, typename TokenSource>
+Expected<void> parse_statement_create(
+        TokenSource& lexer,
+        ParseContext<Text>& context,
+        BasicParseResult<Text>& sql)
+{
+    if (auto create = parse_token(lexer, TokenType::KwCreate); !create) {
+        return create.error();
+    }
+    TokenType next = lexer.peek().type;
+    if ((next == TokenType::KwHash) || (next == TokenType::KwIndex)) {
+        return add_statement(sql, parse_statement_create_index(lexer, context));
+    }
+    return add_statement(sql, parse_statement_create_table(lexer, context));
+}
+
+template <typename Text, typename TokenSource>
+Expected<void> parse_statement(
+        TokenSource& lexer,
+        ParseContext<Text>& context,
+        BasicParseResult<Text>& sql)
+{
+    context.placeholders = 0;
+    switch (lexer.peek().type) {
+    case TokenType::KwCreate:
+        return parse_statement_create(lexer, context, sql);
 
-            token = lexer.peek();
+    case TokenType::KwDelete:
+        return add_statement(sql, parse_statement_delete(lexer, context));
+
+    case TokenType::KwInsert:
+        return add_statement(sql, parse_statement_insert(lexer, context));
+
+    case TokenType::KwSelect:
+        return add_statement(sql, parse_statement_select(lexer, context));
+
+    case TokenType::KwDrop:
+        return add_statement(sql, parse_statement_drop(lexer, context));
+
+    default:
+        // Consumed, so that a stray ';' is skipped rather than reported
+        // forever.
+        return Error(lexer.get(), ErrorType::NotStatement);
+    }
+}
+
+template <typename Text, typename TokenSource>
+BasicParseResult<Text>
+parse_script(
+        TokenSource& lexer,
+        Position origin = {1, 1},
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+{
+    BasicParseResult<Text> sql(upstream);
+    ParseContext<Text> context{*sql.arena, {}, {}, {}, 0};
+
+    while (lexer.peek().type != TokenType::EndOfFile) {
+        auto statement = parse_statement(lexer, context, sql);
+        if (statement) {
+            continue;
         }
-    } catch (const Error& error) {
+        const Error& error = statement.error();
         sql.errors.push_back(error);
+        if (error.type() == ErrorType::UnexpectedEOF) {
+            break;
+        }
+
+        // Resume after the semicolon ending the failed statement, unless
+        // the error was on that semicolon already.
+        if (error.token_type() != TokenType::Semicolon) {
+            Token token = lexer.skip_past_semicolon();
+            if (token.type == TokenType::EndOfFile) {
+                sql.errors.push_back(Error(token, ErrorType::UnexpectedEOF));
+                break;
+            }
+        }
     }
 
+    // Error-free scripts never need positions, so the source is only indexed
+    // once there is something to report.
+    if (!sql.errors.empty()) {
+        LineIndex line_index(lexer.source(), origin);
+        for (auto& error : sql.errors) {
+            error.locate(line_index);
+        }
+    }
     return sql;
-}
\ No newline at end of file
+}
+} // namespace
+
+ParseResult
+rdb::parser::parse_sql(std::string_view sql_inquiry, Position origin)
+{
+    Lexer lexer(sql_inquiry);
+    return parse_script<String>(lexer, origin);
+}
+
+ParseResult rdb::parser::parse_sql(
+        std::string_view sql_inquiry,
+        std::pmr::memory_resource* upstream,
+        Position origin)
+{
+    Lexer lexer(sql_inquiry);
+    return parse_script<String>(lexer, origin, upstream);
+}
+
+ParseResult rdb::parser::parse_sql(const TokenStream& token_stream)
+{
+    TokenCursor cursor(token_stream);
+    return parse_script<String>(cursor);
+}
+
+ParseResultView
+rdb::parser::parse_sql_view(std::string_view sql_inquiry, Position origin)
+{
+    Lexer lexer(sql_inquiry);
+    return parse_script<std::string_view>(lexer, origin);
+}
+
+template <typename Text>
+ParseResult rdb::parser::to_owning(const BasicParseResult<Text>& sql)
+{
+    ParseResult owning;
+    auto& statements = owning.sql_script.sql_statements;
+    statements.reserve(sql.sql_script.sql_statements.size());
+    for (auto&& statement : sql.sql_script.sql_statements) {
+        statements.push_back(to_owning(statement, *owning.arena));
+    }
+    owning.errors = sql.errors;
+    return owning;
+}
+
+template struct rdb::parser::BasicParseResult<String>;
+template struct rdb::parser::BasicParseResult<std::string_view>;
+template std::ostream& rdb::parser::operator<<(
+        std::ostream&, const rdb::parser::BasicSqlScript<String>&);
+template std::ostream& rdb::parser::operator<<(
+        std::ostream&, const rdb::parser::BasicSqlScript<std::string_view>&);
+template ParseResult rdb::parser::to_owning(const BasicParseResult<String>&);
+template ParseResult
+rdb::parser::to_owning(const BasicParseResult<std::string_view>&);
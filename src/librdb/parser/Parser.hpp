@@ -4,22 +4,62 @@
 #include "SqlStatement.hpp"
 #include "librdb/Token.hpp"
 #include "librdb/lexer/Lexer.hpp"
+#include "librdb/lexer/TokenStream.hpp"
 #include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
 
 namespace rdb::parser {
-using SqlStatementPtr = std::unique_ptr<SqlStatement>;
-
-struct SqlScript {
-    explicit SqlScript() = default;
-    std::vector<SqlStatementPtr> sql_statements;
+// Statements are kept by value in one vector, so large scripts iterate
+// contiguously; the strings and sequences they hold live in the arena.
+template <typename Text>
+struct BasicSqlScript {
+    std::vector<BasicSqlStatement<Text>> sql_statements;
 };
+using SqlScript = BasicSqlScript<String>;
+using SqlScriptView = BasicSqlScript<std::string_view>;
 
-std::ostream& operator<<(std::ostream& os, const rdb::parser::SqlScript& sql);
+template <typename Text>
+std::ostream& operator<<(std::ostream& os, const BasicSqlScript<Text>& sql);
 
-struct ParseResult {
-    SqlScript sql_script;
+// The statements point into arena, which is declared first to outlive them.
+template <typename Text>
+struct BasicParseResult {
+    BasicParseResult();
+    // The arena takes its memory from upstream, which must outlive it.
+    explicit BasicParseResult(std::pmr::memory_resource* upstream);
+    BasicParseResult(BasicParseResult&&) = default;
+    // Assigning would free the old arena while statements still use it.
+    BasicParseResult& operator=(BasicParseResult&&) = delete;
+    std::unique_ptr<Arena> arena;
+    // Those of results merged into this one, whose statements came along.
+    std::vector<std::unique_ptr<Arena>> merged_arenas;
+    BasicSqlScript<Text> sql_script;
     std::vector<Error> errors;
 };
+using ParseResult = BasicParseResult<String>;
+using ParseResultView = BasicParseResult<std::string_view>;
 
-ParseResult parse_sql(std::string_view);
+// Errors are located counting from origin, the position of the first byte of
+// the text in the script it was taken from.
+ParseResult parse_sql(std::string_view, Position origin = {1, 1});
+// As above, with the arena taking its memory from upstream, e.g. to account
+// for it. upstream must outlive the result.
+ParseResult parse_sql(
+        std::string_view,
+        std::pmr::memory_resource* upstream,
+        Position origin = {1, 1});
+// Parses a script lexed up front by tokenize_all(), e.g. to time or run the
+// two phases separately.
+ParseResult parse_sql(const TokenStream&);
+// As parse_sql(), but the statements are the *View flavour: their names and
+// literals point into the script instead of being copied, so the script must
+// outlive the result.
+ParseResultView parse_sql_view(std::string_view, Position origin = {1, 1});
+// Copies the statements of either flavour into a new arena so they no longer
+// depend on the script. Errors are copied as they are; like those of
+// parse_sql(), their lexemes point into the script.
+template <typename Text>
+ParseResult to_owning(const BasicParseResult<Text>& sql);
 } // namespace rdb::parser
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Predicate.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+using rdb::parser::BasicExpression;
+using rdb::parser::BasicOperand;
+using rdb::parser::BasicValue;
+using rdb::parser::ColumnColumnPredicate;
+using rdb::parser::ColumnConstantPredicate;
+using rdb::parser::CompareOp;
+using rdb::parser::CompiledPredicate;
+using rdb::parser::ConstantPredicate;
+using rdb::parser::Placeholder;
+
+namespace {
+[[noreturn]] void throw_placeholder()
+{
+    throw std::invalid_argument(
+            "compile_predicate: a placeholder must be bound first");
+}
+
+template <typename Text>
+std::string_view column_name(const BasicOperand<Text>& operand)
+{
+    return std::get<Text>(operand.val);
+}
+
+template <CompareOp Op, typename Text>
+CompiledPredicate
+column_constant(std::string_view column, const BasicValue<Text>& constant)
+{
+    return std::visit(
+            [column](auto&& value) -> CompiledPredicate {
+                using Alternative = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<Alternative, Placeholder>) {
+                    throw_placeholder();
+                } else if constexpr (std::is_arithmetic_v<Alternative>) {
+                    return ColumnConstantPredicate<Op, Alternative>{
+                            column, value};
+                } else {
+                    return ColumnConstantPredicate<Op, std::string_view>{
+                            column, value};
+                }
+            },
+            constant);
+}
+
+template <CompareOp Op, typename Text>
+bool constant_result(
+        const BasicValue<Text>& left, const BasicValue<Text>& right)
+{
+    return std::visit(
+            [](auto&& l, auto&& r) -> bool {
+                using Left = std::decay_t<decltype(l)>;
+                using Right = std::decay_t<decltype(r)>;
+                if constexpr (
+                        std::is_same_v<Left, Placeholder>
+                        || std::is_same_v<Right, Placeholder>) {
+                    throw_placeholder();
+                } else if constexpr (
+                        std::is_arithmetic_v<Left>
+                        && std::is_arithmetic_v<Right>) {
+                    using Common = std::common_type_t<Left, Right>;
+                    return rdb::parser::compare<Op, Common>(l, r);
+                } else if constexpr (
+                        !std::is_arithmetic_v<Left>
+                        && !std::is_arithmetic_v<Right>) {
+                    return rdb::parser::compare<Op, std::string_view>(l, r);
+                } else {
+                    throw std::invalid_argument(
+                            "compile_predicate: cannot compare text with a "
+                            "number");
+                }
+            },
+            left,
+            right);
+}
+
+template <CompareOp Op, typename Text>
+CompiledPredicate compile_as(const BasicExpression<Text>& expression)
+{
+    const auto& left = expression.loperand;
+    const auto& right = expression.roperand;
+    if (left.is_id && right.is_id) {
+        return ColumnColumnPredicate<Op>{
+                column_name(left), column_name(right)};
+    }
+    if (left.is_id) {
+        return column_constant<Op>(column_name(left), right.val);
+    }
+    if (right.is_id) {
+        return column_constant<rdb::parser::mirrored(Op)>(
+                column_name(right), left.val);
+    }
+    return ConstantPredicate{constant_result<Op>(left.val, right.val)};
+}
+} // namespace
+
+template <typename Text>
+CompiledPredicate
+rdb::parser::compile_predicate(const BasicExpression<Text>& expression)
+{
+    switch (expression.operation) {
+    case CompareOp::Equal:
+        return compile_as<CompareOp::Equal>(expression);
+    case CompareOp::NotEqual:
+        return compile_as<CompareOp::NotEqual>(expression);
+    case CompareOp::Less:
+        return compile_as<CompareOp::Less>(expression);
+    case CompareOp::LessEqual:
+        return compile_as<CompareOp::LessEqual>(expression);
+    case CompareOp::Greater:
+        return compile_as<CompareOp::Greater>(expression);
+    case CompareOp::GreaterEqual:
+        return compile_as<CompareOp::GreaterEqual>(expression);
+    }
+    throw std::invalid_argument("compile_predicate: no such operator");
+}
+
+template CompiledPredicate
+rdb::parser::compile_predicate(const BasicExpression<rdb::parser::String>&);
+template CompiledPredicate
+rdb::parser::compile_predicate(const BasicExpression<std::string_view>&);
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "SqlStatement.hpp"
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+
+namespace rdb::parser {
+// a op b, with the operator fixed at compile time.
+template <CompareOp Op, typename T>
+constexpr bool compare(const T& a, const T& b)
+{
+    if constexpr (Op == CompareOp::Equal) {
+        return a == b;
+    } else if constexpr (Op == CompareOp::NotEqual) {
+        return a != b;
+    } else if constexpr (Op == CompareOp::Less) {
+        return a < b;
+    } else if constexpr (Op == CompareOp::LessEqual) {
+        return a <= b;
+    } else if constexpr (Op == CompareOp::Greater) {
+        return a > b;
+    } else {
+        return a >= b;
+    }
+}
+
+// Predicates compiled from a WHERE clause, each specialised on its operator
+// and the kind of its operands so that testing a row takes no more than the
+// comparison itself. Columns are named as in the clause, which must outlive
+// the predicate; matching the names to columns is up to the caller.
+
+// column op constant. A clause with the constant on the left is mirrored, so
+// the column is always the left operand: 5 < a becomes a > 5. T is long,
+// double or std::string_view, the last holding a text literal's lexeme with
+// its quotes.
+template <CompareOp Op, typename T>
+struct ColumnConstantPredicate {
+    std::string_view column;
+    T constant;
+
+    bool operator()(const T& value) const
+    {
+        return compare<Op>(value, constant);
+    }
+};
+
+// column op column, given both values of a row.
+template <CompareOp Op>
+struct ColumnColumnPredicate {
+    std::string_view left_column;
+    std::string_view right_column;
+
+    template <typename T>
+    bool operator()(const T& left, const T& right) const
+    {
+        return compare<Op>(left, right);
+    }
+};
+
+// A clause naming no column holds for all rows or for none.
+struct ConstantPredicate {
+    bool result;
+};
+
+template <CompareOp Op>
+using PredicatesFor = std::tuple<
+        ColumnConstantPredicate<Op, long>,
+        ColumnConstantPredicate<Op, double>,
+        ColumnConstantPredicate<Op, std::string_view>,
+        ColumnColumnPredicate<Op>>;
+
+template <typename Predicates>
+struct PredicateVariant;
+template <typename... Predicates>
+struct PredicateVariant<std::tuple<Predicates...>> {
+    using type = std::variant<ConstantPredicate, Predicates...>;
+};
+
+// One alternative per (operands, operator): visiting it once per clause
+// yields a predicate to run over every row without a further dispatch.
+using CompiledPredicate = typename PredicateVariant<decltype(std::tuple_cat(
+        std::declval<PredicatesFor<CompareOp::Equal>>(),
+        std::declval<PredicatesFor<CompareOp::NotEqual>>(),
+        std::declval<PredicatesFor<CompareOp::Less>>(),
+        std::declval<PredicatesFor<CompareOp::LessEqual>>(),
+        std::declval<PredicatesFor<CompareOp::Greater>>(),
+        std::declval<PredicatesFor<CompareOp::GreaterEqual>>()))>::type;
+
+// Compiles expression, whose names and text the result views. A clause of
+// two literals is evaluated right away, integers and reals comparing as
+// numbers. Throws std::invalid_argument for a placeholder, which must be
+// bound first, and for a literal text compared with a literal number.
+template <typename Text>
+CompiledPredicate compile_predicate(const BasicExpression<Text>& expression);
+} // namespace rdb::parser
@@ -0,0 +1,301 @@
+#include "PreparedStatement.hpp"
+#include "Parser.hpp"
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+using rdb::parser::Arena;
+using rdb::parser::ArenaArray;
+using rdb::parser::ColumnDefView;
+using rdb::parser::CreateIndexStatementView;
+using rdb::parser::CreateTableStatementView;
+using rdb::parser::DeleteFromStatementView;
+using rdb::parser::DropTableStatementView;
+using rdb::parser::Error;
+using rdb::parser::ErrorType;
+using rdb::parser::Expected;
+using rdb::parser::ExpressionView;
+using rdb::parser::InsertStatementView;
+using rdb::parser::Lexer;
+using rdb::parser::LineIndex;
+using rdb::parser::OperandView;
+using rdb::parser::Placeholder;
+using rdb::parser::PreparedStatement;
+using rdb::parser::SelectStatementView;
+using rdb::parser::Sequence;
+using rdb::parser::SqlStatementView;
+using rdb::parser::TextColumnView;
+using rdb::parser::TokenType;
+using rdb::parser::ValueColumnView;
+using rdb::parser::ValueView;
+
+// The script is copied first, as the statement views it.
+struct PreparedStatement::Prepared {
+    const std::string script;
+    const rdb::parser::ParseResultView parsed;
+    size_t parameter_count;
+
+    explicit Prepared(std::string_view sql)
+        : script{sql},
+          parsed{rdb::parser::parse_sql_view(script)},
+          parameter_count{0}
+    {
+    }
+};
+
+namespace {
+bool is_placeholder(const ValueView& value)
+{
+    return std::holds_alternative<Placeholder>(value);
+}
+
+size_t count_placeholders(const ExpressionView& expression)
+{
+    return is_placeholder(expression.loperand.val)
+            + is_placeholder(expression.roperand.val);
+}
+
+size_t count_placeholders(const CreateTableStatementView&)
+{
+    return 0;
+}
+
+// Placeholders only ever are in boxed columns.
+size_t count_placeholders(const ValueColumnView& column)
+{
+    size_t count = 0;
+    if (auto* values = std::get_if<ArenaArray<ValueView>>(&column)) {
+        for (auto&& value : *values) {
+            count += is_placeholder(value);
+        }
+    }
+    return count;
+}
+
+size_t count_placeholders(const InsertStatementView& statement)
+{
+    size_t count = 0;
+    for (size_t index = 0; index < statement.columns_defined(); index++) {
+        count += count_placeholders(statement.value_column(index));
+    }
+    return count;
+}
+
+template <typename Statement>
+size_t count_placeholders(const Statement& statement)
+{
+    return statement.has_expression()
+            ? count_placeholders(statement.expression())
+            : 0;
+}
+
+size_t count_placeholders(const DropTableStatementView&)
+{
+    return 0;
+}
+
+size_t count_placeholders(const CreateIndexStatementView&)
+{
+    return 0;
+}
+
+// Builds the bound copy of each kind of statement.
+class Binder {
+public:
+    Binder(const std::vector<ValueView>& parameters, Arena& arena)
+        : parameters{parameters}, arena{arena}
+    {
+    }
+
+    SqlStatementView operator()(const CreateTableStatementView& statement)
+    {
+        Sequence<ColumnDefView> column_defs(&arena);
+        column_defs.reserve(statement.columns_defined());
+        for (size_t index = 0; index < statement.columns_defined(); index++) {
+            column_defs.push_back(statement.column_def(index));
+        }
+        return CreateTableStatementView(
+                std::string_view(statement.table_name()),
+                std::move(column_defs));
+    }
+
+    SqlStatementView operator()(const InsertStatementView& statement)
+    {
+        size_t count = statement.columns_defined();
+        std::pmr::polymorphic_allocator<ValueColumnView> allocator(&arena);
+        ValueColumnView* columns = allocator.allocate(count);
+        for (size_t index = 0; index < count; index++) {
+            new (columns + index) ValueColumnView(std::visit(
+                    [this](auto&& values) { return bind(values); },
+                    statement.value_column(index)));
+        }
+        return InsertStatementView(
+                std::string_view(statement.table_name()),
+                column_names(statement),
+                ArenaArray<ValueColumnView>(columns, count),
+                statement.rows());
+    }
+
+    SqlStatementView operator()(const SelectStatementView& statement)
+    {
+        return SelectStatementView(
+                std::string_view(statement.table_name()),
+                column_names(statement),
+                expression(statement));
+    }
+
+    SqlStatementView operator()(const DeleteFromStatementView& statement)
+    {
+        return DeleteFromStatementView(
+                std::string_view(statement.table_name()),
+                expression(statement));
+    }
+
+    SqlStatementView operator()(const DropTableStatementView& statement)
+    {
+        return DropTableStatementView(
+                std::string_view(statement.table_name()));
+    }
+
+    SqlStatementView operator()(const CreateIndexStatementView& statement)
+    {
+        return statement;
+    }
+
+private:
+    const std::vector<ValueView>& parameters;
+    Arena& arena;
+
+    ValueView bind(const ValueView& value) const
+    {
+        if (auto* placeholder = std::get_if<Placeholder>(&value)) {
+            return parameters[placeholder->index];
+        }
+        return value;
+    }
+
+    // A boxed column copied into arena, placeholders replaced.
+    ValueColumnView bind(const ArenaArray<ValueView>& values)
+    {
+        std::pmr::polymorphic_allocator<ValueView> allocator(&arena);
+        ValueView* bound = allocator.allocate(values.size());
+        for (size_t row = 0; row < values.size(); row++) {
+            new (bound + row) ValueView(bind(values[row]));
+        }
+        return ArenaArray<ValueView>(bound, values.size());
+    }
+    // Columns without placeholders are shared: nothing in the arena is
+    // ever changed.
+    ValueColumnView bind(const TextColumnView& values)
+    {
+        return values;
+    }
+    template <typename T>
+    ValueColumnView bind(const ArenaArray<T>& values)
+    {
+        return values;
+    }
+
+    template <typename Statement>
+    Sequence<std::string_view> column_names(const Statement& statement)
+    {
+        Sequence<std::string_view> names(&arena);
+        names.reserve(statement.columns_defined());
+        for (size_t index = 0; index < statement.columns_defined(); index++) {
+            names.push_back(statement.column_name(index));
+        }
+        return names;
+    }
+
+    template <typename Statement>
+    const ExpressionView* expression(const Statement& statement)
+    {
+        if (!statement.has_expression()) {
+            return nullptr;
+        }
+        const ExpressionView& expression = statement.expression();
+        if (count_placeholders(expression) == 0) {
+            return &expression;
+        }
+        return rdb::parser::make_in_arena<ExpressionView>(
+                arena,
+                ExpressionView{
+                        OperandView(
+                                bind(expression.loperand.val),
+                                expression.loperand.is_id),
+                        expression.operation,
+                        OperandView(
+                                bind(expression.roperand.val),
+                                expression.roperand.is_id)});
+    }
+};
+} // namespace
+
+PreparedStatement::PreparedStatement(std::unique_ptr<const Prepared> prepared)
+    : prepared{std::move(prepared)}
+{
+}
+
+PreparedStatement::PreparedStatement(PreparedStatement&&) noexcept = default;
+PreparedStatement&
+PreparedStatement::operator=(PreparedStatement&&) noexcept = default;
+PreparedStatement::~PreparedStatement() = default;
+
+size_t PreparedStatement::parameter_count() const
+{
+    return prepared->parameter_count;
+}
+
+const SqlStatementView& PreparedStatement::statement() const
+{
+    return prepared->parsed.sql_script.sql_statements.front();
+}
+
+SqlStatementView PreparedStatement::bind(
+        const std::vector<ValueView>& parameters, Arena& arena) const
+{
+    if (parameters.size() != parameter_count()) {
+        throw std::invalid_argument(
+                "PreparedStatement: expected "
+                + std::to_string(parameter_count()) + " parameters, got "
+                + std::to_string(parameters.size()));
+    }
+    for (auto&& parameter : parameters) {
+        if (is_placeholder(parameter)) {
+            throw std::invalid_argument(
+                    "PreparedStatement: a parameter cannot be a placeholder");
+        }
+    }
+    return std::visit(Binder(parameters, arena), statement());
+}
+
+Expected<PreparedStatement> rdb::parser::prepare(std::string_view sql)
+{
+    auto prepared = std::make_unique<PreparedStatement::Prepared>(sql);
+    const auto& statements = prepared->parsed.sql_script.sql_statements;
+    if (prepared->parsed.errors.empty() && (statements.size() == 1)) {
+        prepared->parameter_count = std::visit(
+                [](auto&& statement) { return count_placeholders(statement); },
+                statements.front());
+        return PreparedStatement(std::move(prepared));
+    }
+
+    // The errors point into the copy, so sql is read again to report them
+    // against it; this only happens when preparing fails.
+    if (!prepared->parsed.errors.empty()) {
+        return rdb::parser::parse_sql_view(sql).errors.front();
+    }
+    Lexer lexer(sql);
+    std::optional<Error> error;
+    if (statements.empty()) {
+        error.emplace(lexer.get(), ErrorType::UnexpectedEOF);
+    } else {
+        lexer.skip_past_semicolon();
+        error.emplace(
+                lexer.get(), ErrorType::SyntaxError, TokenType::EndOfFile);
+    }
+    error->locate(LineIndex(sql, {1, 1}));
+    return *error;
+}
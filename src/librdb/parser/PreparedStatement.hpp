@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Expected.hpp"
+#include "SqlStatement.hpp"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace rdb::parser {
+// A statement parsed once with `?` in place of some of its literals, to be
+// run many times with different values. bind() fills those in without
+// lexing or parsing anything again.
+class PreparedStatement {
+public:
+    PreparedStatement(PreparedStatement&&) noexcept;
+    PreparedStatement& operator=(PreparedStatement&&) noexcept;
+    ~PreparedStatement();
+
+    size_t parameter_count() const;
+    // The statement as parsed, its placeholders still in place.
+    const SqlStatementView& statement() const;
+    // The statement with every placeholder replaced by parameters[index].
+    // Only its lists and the expressions and INSERT columns holding a
+    // placeholder are built anew in arena; names, text, the other expressions
+    // and columns are shared with the prepared statement and the parameters,
+    // which must outlive the result as well as arena. Throws
+    // std::invalid_argument unless there are parameter_count() parameters,
+    // none of them a placeholder.
+    SqlStatementView
+    bind(const std::vector<ValueView>& parameters, Arena& arena) const;
+
+private:
+    struct Prepared;
+    std::unique_ptr<const Prepared> prepared;
+
+    explicit PreparedStatement(std::unique_ptr<const Prepared> prepared);
+    friend Expected<PreparedStatement> prepare(std::string_view sql);
+};
+
+// Parses sql, which must hold exactly one statement, into a copy of its own.
+// Fails with the first error parse_sql() would report, located and pointing
+// into sql the same way, or with a SyntaxError expecting EndOfFile on the
+// first token of a second statement.
+Expected<PreparedStatement> prepare(std::string_view sql);
+} // namespace rdb::parser
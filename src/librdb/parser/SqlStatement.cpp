@@ -1,61 +1,269 @@
 #include "SqlStatement.hpp"
+#include <stdexcept>
+#include <utility>
 
 namespace rdb::parser {
-std::ostream& operator<<(std::ostream& os, const Value& value)
+std::ostream& operator<<(std::ostream& os, Placeholder)
+{
+    return os << "?";
+}
+
+CompareOp to_compare_op(std::string_view lexeme)
+{
+    if (lexeme == "=") {
+        return CompareOp::Equal;
+    }
+    if (lexeme == "!=") {
+        return CompareOp::NotEqual;
+    }
+    if (lexeme == "<") {
+        return CompareOp::Less;
+    }
+    if (lexeme == "<=") {
+        return CompareOp::LessEqual;
+    }
+    if (lexeme == ">") {
+        return CompareOp::Greater;
+    }
+    if (lexeme == ">=") {
+        return CompareOp::GreaterEqual;
+    }
+    throw std::invalid_argument(
+            "CompareOp: no such operator " + std::string(lexeme));
+}
+
+std::ostream& operator<<(std::ostream& os, CompareOp op)
+{
+    switch (op) {
+    case CompareOp::Equal:
+        return os << "=";
+    case CompareOp::NotEqual:
+        return os << "!=";
+    case CompareOp::Less:
+        return os << "<";
+    case CompareOp::LessEqual:
+        return os << "<=";
+    case CompareOp::Greater:
+        return os << ">";
+    case CompareOp::GreaterEqual:
+        return os << ">=";
+    }
+    return os;
+}
+
+template <typename Text>
+std::ostream& operator<<(std::ostream& os, const BasicValue<Text>& value)
 {
     std::visit([&os](auto&& v) { os << v; }, value);
     return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const Operand& operand)
+template <typename Text>
+std::ostream& operator<<(std::ostream& os, const BasicOperand<Text>& operand)
 {
     os << operand.val;
     return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const Expression& expression)
+template <typename Text>
+std::ostream&
+operator<<(std::ostream& os, const BasicExpression<Text>& expression)
 {
     os << expression.loperand << " " << expression.operation << " "
        << expression.roperand;
     return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const SqlStatement& statement)
+namespace {
+// Deep copies of AST parts of either flavour, allocated from arena.
+String owning_text(std::string_view text, Arena& arena)
+{
+    return String(text, &arena);
+}
+
+template <typename Text>
+Value owning_value(const BasicValue<Text>& value, Arena& arena)
+{
+    return std::visit(
+            [&arena](auto&& v) -> Value {
+                using Alternative = std::decay_t<decltype(v)>;
+                if constexpr (
+                        std::is_arithmetic_v<Alternative>
+                        || std::is_same_v<Alternative, Placeholder>) {
+                    return v;
+                } else {
+                    return owning_text(v, arena);
+                }
+            },
+            value);
+}
+
+template <typename Text>
+const Expression*
+owning_expression(const BasicExpression<Text>* expression, Arena& arena)
 {
-    statement.print(os);
+    if (expression == nullptr) {
+        return nullptr;
+    }
+    return make_in_arena<Expression>(
+            arena,
+            Expression{
+                    Operand(owning_value(expression->loperand.val, arena),
+                            expression->loperand.is_id),
+                    expression->operation,
+                    Operand(owning_value(expression->roperand.val, arena),
+                            expression->roperand.is_id)});
+}
+
+template <typename Text>
+Sequence<String> owning_names(const Sequence<Text>& names, Arena& arena)
+{
+    Sequence<String> owning(&arena);
+    owning.reserve(names.size());
+    for (auto&& name : names) {
+        owning.emplace_back(std::string_view(name));
+    }
+    return owning;
+}
+
+template <typename Text>
+ValueColumn owning_column(const BasicValueColumn<Text>& column, Arena& arena)
+{
+    return std::visit(
+            [&arena](auto&& values) -> ValueColumn {
+                using Values = std::decay_t<decltype(values)>;
+                if constexpr (std::is_same_v<Values, BasicTextColumn<Text>>) {
+                    return TextColumn(arena, values);
+                } else if constexpr (std::is_same_v<
+                                             Values,
+                                             ArenaArray<BasicValue<Text>>>) {
+                    std::pmr::polymorphic_allocator<Value> allocator(&arena);
+                    Value* owning = allocator.allocate(values.size());
+                    for (size_t row = 0; row < values.size(); row++) {
+                        new (owning + row)
+                                Value(owning_value(values[row], arena));
+                    }
+                    return ArenaArray<Value>(owning, values.size());
+                } else {
+                    return Values(arena, values.begin(), values.end());
+                }
+            },
+            column);
+}
+} // namespace
+
+size_t BasicTextColumn<String>::size() const
+{
+    return ends_.size();
+}
+
+std::string_view BasicTextColumn<String>::operator[](size_t row) const
+{
+    size_t begin = (row == 0) ? 0 : ends_[row - 1];
+    return std::string_view(bytes_ + begin, ends_[row] - begin);
+}
+
+size_t BasicTextColumn<std::string_view>::size() const
+{
+    return views_.size();
+}
+
+std::string_view
+BasicTextColumn<std::string_view>::operator[](size_t row) const
+{
+    return views_[row];
+}
+
+template <typename Text>
+size_t column_rows(const BasicValueColumn<Text>& column)
+{
+    return std::visit([](auto&& values) { return values.size(); }, column);
+}
+
+template <typename Text>
+ValueView column_value(const BasicValueColumn<Text>& column, size_t row)
+{
+    return std::visit(
+            [row](auto&& values) -> ValueView {
+                using Values = std::decay_t<decltype(values)>;
+                if constexpr (std::is_same_v<
+                                      Values,
+                                      ArenaArray<BasicValue<Text>>>) {
+                    return std::visit(
+                            [](auto&& v) -> ValueView {
+                                using Alternative = std::decay_t<decltype(v)>;
+                                if constexpr (std::is_same_v<
+                                                      Alternative,
+                                                      Text>) {
+                                    return std::string_view(v);
+                                } else {
+                                    return v;
+                                }
+                            },
+                            values[row]);
+                } else {
+                    return values[row];
+                }
+            },
+            column);
+}
+
+template <typename Text>
+std::ostream&
+operator<<(std::ostream& os, const BasicSqlStatement<Text>& statement)
+{
+    std::visit([&os](auto&& s) { s.print(os); }, statement);
     return os;
 }
 
-Operand::Operand(Value&& val, const bool is_id) : is_id{is_id}, val{val}
+template <typename Text>
+SqlStatement to_owning(const BasicSqlStatement<Text>& statement, Arena& arena)
 {
+    return std::visit(
+            [&arena](auto&& s) -> SqlStatement { return s.to_owning(arena); },
+            statement);
 }
 
-Operand::Operand(long&& val) : is_id{false}, val{val}
+template <typename Text>
+BasicOperand<Text>::BasicOperand(BasicValue<Text>&& val, const bool is_id)
+    : is_id{is_id}, val{std::move(val)}
 {
 }
 
-CreateTableStatement::CreateTableStatement(
-        std::string&& table_name, std::vector<ColumnDef>&& column_def_seq)
-    : table_name_{table_name}, column_def_seq_{column_def_seq}
+template <typename Text>
+BasicOperand<Text>::BasicOperand(long&& val) : is_id{false}, val{val}
 {
 }
 
-const std::string& CreateTableStatement::table_name() const
+template <typename Text>
+BasicCreateTableStatement<Text>::BasicCreateTableStatement(
+        Text&& table_name, Sequence<BasicColumnDef<Text>>&& column_def_seq)
+    : table_name_{std::move(table_name)},
+      column_def_seq_{std::move(column_def_seq)}
+{
+}
+
+template <typename Text>
+const Text& BasicCreateTableStatement<Text>::table_name() const
 {
     return table_name_;
 }
 
-const ColumnDef& CreateTableStatement::column_def(size_t index) const
+template <typename Text>
+const BasicColumnDef<Text>&
+BasicCreateTableStatement<Text>::column_def(size_t index) const
 {
     return column_def_seq_.at(index);
 }
 
-size_t CreateTableStatement::columns_defined() const
+template <typename Text>
+size_t BasicCreateTableStatement<Text>::columns_defined() const
 {
     return column_def_seq_.size();
 }
 
-void CreateTableStatement::print(std::ostream& os) const
+template <typename Text>
+void BasicCreateTableStatement<Text>::print(std::ostream& os) const
 {
     os << "\"create_statement\":\n\t";
     os << "{ \n\t";
@@ -71,37 +279,115 @@ void CreateTableStatement::print(std::ostream& os) const
     os << "] }";
 }
 
-InsertStatement::InsertStatement(
-        std::string&& table_name,
-        std::vector<std::string>&& column_name_seq,
-        std::vector<Value>&& value_seq)
-    : table_name_{table_name},
-      column_name_seq_{column_name_seq},
-      value_seq_{value_seq}
+std::ostream& operator<<(std::ostream& os, IndexKind kind)
+{
+    return os << (kind == IndexKind::Hash ? "hash" : "ordered");
+}
+
+template <typename Text>
+BasicCreateIndexStatement<Text>::BasicCreateIndexStatement(
+        Text&& index_name,
+        Text&& table_name,
+        Text&& column_name,
+        IndexKind kind)
+    : index_name_{std::move(index_name)},
+      table_name_{std::move(table_name)},
+      column_name_{std::move(column_name)},
+      kind_{kind}
+{
+}
+
+template <typename Text>
+const Text& BasicCreateIndexStatement<Text>::index_name() const
+{
+    return index_name_;
+}
+
+template <typename Text>
+const Text& BasicCreateIndexStatement<Text>::table_name() const
+{
+    return table_name_;
+}
+
+template <typename Text>
+const Text& BasicCreateIndexStatement<Text>::column_name() const
+{
+    return column_name_;
+}
+
+template <typename Text>
+IndexKind BasicCreateIndexStatement<Text>::kind() const
+{
+    return kind_;
+}
+
+template <typename Text>
+void BasicCreateIndexStatement<Text>::print(std::ostream& os) const
+{
+    os << "\"create_index_statement\":\n\t";
+    os << "{ \n\t";
+    os << "\"index_name\": " << index_name_ << ",\n\t";
+    os << "\"table_name\": " << table_name_ << ",\n\t";
+    os << "\"column_name\": " << column_name_ << ",\n\t";
+    os << "\"kind\": " << kind_ << "\n\t";
+    os << "}";
+}
+
+template <typename Text>
+BasicInsertStatement<Text>::BasicInsertStatement(
+        Text&& table_name,
+        Sequence<Text>&& column_name_seq,
+        ArenaArray<BasicValueColumn<Text>> value_columns,
+        size_t rows)
+    : table_name_{std::move(table_name)},
+      column_name_seq_{std::move(column_name_seq)},
+      value_columns_{value_columns},
+      rows_{rows}
 {
 }
 
-const std::string& InsertStatement::table_name() const
+template <typename Text>
+const Text& BasicInsertStatement<Text>::table_name() const
 {
     return table_name_;
 }
 
-const std::string& InsertStatement::column_name(size_t index) const
+template <typename Text>
+const Text& BasicInsertStatement<Text>::column_name(size_t index) const
 {
     return column_name_seq_.at(index);
 }
 
-size_t InsertStatement::columns_defined() const
+template <typename Text>
+size_t BasicInsertStatement<Text>::columns_defined() const
 {
     return column_name_seq_.size();
 }
 
-const Value& InsertStatement::value(size_t index) const
+template <typename Text>
+size_t BasicInsertStatement<Text>::rows() const
+{
+    return rows_;
+}
+
+template <typename Text>
+const BasicValueColumn<Text>&
+BasicInsertStatement<Text>::value_column(size_t index) const
+{
+    return value_columns_.at(index);
+}
+
+template <typename Text>
+ValueView BasicInsertStatement<Text>::value(size_t index, size_t row) const
 {
-    return value_seq_.at(index);
+    if (row >= rows_) {
+        throw std::out_of_range("InsertStatement: no such row");
+    }
+    return column_value(value_columns_.at(index), row);
 }
 
-void InsertStatement::print(std::ostream& os) const
+template <typename Text>
+void BasicInsertStatement<Text>::print(std::ostream& os) const
 {
     os << "\"insert_statement\":\n\t";
     os << "{ \n\t";
@@ -110,53 +396,67 @@ void InsertStatement::print(std::ostream& os) const
     for (size_t index = 0; index < column_name_seq_.size(); index++) {
         os << "\t{ ";
         os << "\"column_name\": " << column_name_seq_.at(index) << ", ";
-        os << "\"value\": " << value_seq_.at(index);
+        if (rows_ == 1) {
+            os << "\"value\": " << value(index);
+        } else {
+            os << "\"values\": [";
+            for (size_t row = 0; row < rows_; row++) {
+                os << ((row == 0) ? " " : ", ") << value(index, row);
+            }
+            os << " ]";
+        }
         os << " } ";
         os << "\n\t";
     }
     os << "] }";
 }
 
-SelectStatement::SelectStatement(
-        std::string&& table_name,
-        std::vector<std::string>&& column_name_seq,
-        const Expression& expression)
-    : table_name_{table_name},
-      column_name_seq_{column_name_seq},
-      has_expression_cond_{expression.operation != "N"},
+template <typename Text>
+BasicSelectStatement<Text>::BasicSelectStatement(
+        Text&& table_name,
+        Sequence<Text>&& column_name_seq,
+        const BasicExpression<Text>* expression)
+    : table_name_{std::move(table_name)},
+      column_name_seq_{std::move(column_name_seq)},
       expression_{expression}
 {
 }
 
-const std::string& SelectStatement::table_name() const
+template <typename Text>
+const Text& BasicSelectStatement<Text>::table_name() const
 {
     return table_name_;
 }
 
-const std::string& SelectStatement::column_name(size_t index) const
+template <typename Text>
+const Text& BasicSelectStatement<Text>::column_name(size_t index) const
 {
     return column_name_seq_.at(index);
 }
 
-size_t SelectStatement::columns_defined() const
+template <typename Text>
+size_t BasicSelectStatement<Text>::columns_defined() const
 {
     return column_name_seq_.size();
 }
 
-bool SelectStatement::has_expression() const
+template <typename Text>
+bool BasicSelectStatement<Text>::has_expression() const
 {
-    return has_expression_cond_;
+    return expression_ != nullptr;
 }
 
-const Expression& SelectStatement::expression() const
+template <typename Text>
+const BasicExpression<Text>& BasicSelectStatement<Text>::expression() const
 {
-    if (has_expression_cond_) {
-        return expression_;
+    if (expression_ != nullptr) {
+        return *expression_;
     }
     throw std::runtime_error("SelectStatement: No expression defined");
 }
 
-void SelectStatement::print(std::ostream& os) const
+template <typename Text>
+void BasicSelectStatement<Text>::print(std::ostream& os) const
 {
     os << "\"select_statement\":\n\t";
     os << "{ \n\t";
@@ -169,66 +469,162 @@ void SelectStatement::print(std::ostream& os) const
         os << "\n\t";
     }
     os << "] ";
-    if (has_expression_cond_) {
+    if (expression_ != nullptr) {
         os << ",\n\t";
-        os << "\"expression\": " << expression_ << "\n\t";
+        os << "\"expression\": " << *expression_ << "\n\t";
     }
     os << "}";
 }
 
-DeleteFromStatement::DeleteFromStatement(
-        std::string&& table_name, const Expression& expression)
-    : table_name_{table_name},
-      has_expression_cond_{expression.operation != "N"},
-      expression_{expression}
+template <typename Text>
+BasicDeleteFromStatement<Text>::BasicDeleteFromStatement(
+        Text&& table_name, const BasicExpression<Text>* expression)
+    : table_name_{std::move(table_name)}, expression_{expression}
 {
 }
 
-const std::string& DeleteFromStatement::table_name() const
+template <typename Text>
+const Text& BasicDeleteFromStatement<Text>::table_name() const
 {
     return table_name_;
 }
 
-bool DeleteFromStatement::has_expression() const
+template <typename Text>
+bool BasicDeleteFromStatement<Text>::has_expression() const
 {
-    return has_expression_cond_;
+    return expression_ != nullptr;
 }
 
-const Expression& DeleteFromStatement::expression() const
+template <typename Text>
+const BasicExpression<Text>& BasicDeleteFromStatement<Text>::expression() const
 {
-    if (has_expression_cond_) {
-        return expression_;
+    if (expression_ != nullptr) {
+        return *expression_;
     }
     throw std::runtime_error("DeleteFromStatement: No expression defined");
 }
 
-void DeleteFromStatement::print(std::ostream& os) const
+template <typename Text>
+void BasicDeleteFromStatement<Text>::print(std::ostream& os) const
 {
     os << "\"delete_statement\":\n\t";
     os << "{ \n\t";
     os << "\"table_name\": " << table_name_;
-    if (has_expression_cond_) {
+    if (expression_ != nullptr) {
         os << " ,\n\t";
-        os << "\"expression\": " << expression_;
+        os << "\"expression\": " << *expression_;
     }
     os << "\n\t}";
 }
 
-DropTableStatement::DropTableStatement(std::string&& table_name)
-    : table_name_{table_name}
+template <typename Text>
+BasicDropTableStatement<Text>::BasicDropTableStatement(Text&& table_name)
+    : table_name_{std::move(table_name)}
 {
 }
 
-const std::string& DropTableStatement::table_name() const
+template <typename Text>
+const Text& BasicDropTableStatement<Text>::table_name() const
 {
     return table_name_;
 }
 
-void DropTableStatement::print(std::ostream& os) const
+template <typename Text>
+void BasicDropTableStatement<Text>::print(std::ostream& os) const
 {
     os << "\"drop_statement\":\n\t";
     os << "{ \n\t";
     os << "\"table_name\": " << table_name_ << "\n\t";
     os << "}";
 }
-} // namespace rdb::parser
\ No newline at end of file
+
+template <typename Text>
+CreateTableStatement
+BasicCreateTableStatement<Text>::to_owning(Arena& arena) const
+{
+    Sequence<ColumnDef> column_def_seq(&arena);
+    column_def_seq.reserve(column_def_seq_.size());
+    for (auto&& column_def : column_def_seq_) {
+        column_def_seq.push_back(ColumnDef{
+                owning_text(column_def.column_name, arena),
+                column_def.type_name});
+    }
+    return CreateTableStatement(
+            owning_text(table_name_, arena), std::move(column_def_seq));
+}
+
+template <typename Text>
+CreateIndexStatement
+BasicCreateIndexStatement<Text>::to_owning(Arena& arena) const
+{
+    return CreateIndexStatement(
+            owning_text(index_name_, arena),
+            owning_text(table_name_, arena),
+            owning_text(column_name_, arena),
+            kind_);
+}
+
+template <typename Text>
+InsertStatement BasicInsertStatement<Text>::to_owning(Arena& arena) const
+{
+    std::pmr::polymorphic_allocator<ValueColumn> allocator(&arena);
+    ValueColumn* value_columns = allocator.allocate(value_columns_.size());
+    for (size_t index = 0; index < value_columns_.size(); index++) {
+        new (value_columns + index)
+                ValueColumn(owning_column(value_columns_[index], arena));
+    }
+    return InsertStatement(
+            owning_text(table_name_, arena),
+            owning_names(column_name_seq_, arena),
+            ArenaArray<ValueColumn>(value_columns, value_columns_.size()),
+            rows_);
+}
+
+template <typename Text>
+SelectStatement BasicSelectStatement<Text>::to_owning(Arena& arena) const
+{
+    return SelectStatement(
+            owning_text(table_name_, arena),
+            owning_names(column_name_seq_, arena),
+            owning_expression(expression_, arena));
+}
+
+template <typename Text>
+DeleteFromStatement
+BasicDeleteFromStatement<Text>::to_owning(Arena& arena) const
+{
+    return DeleteFromStatement(
+            owning_text(table_name_, arena),
+            owning_expression(expression_, arena));
+}
+
+template <typename Text>
+DropTableStatement
+BasicDropTableStatement<Text>::to_owning(Arena& arena) const
+{
+    return DropTableStatement(owning_text(table_name_, arena));
+}
+
+#define RDB_INSTANTIATE_AST(Text)                                              \
+    template std::ostream& operator<<(std::ostream&, const BasicValue<Text>&); \
+    template std::ostream& operator<<(                                         \
+            std::ostream&, const BasicOperand<Text>&);                         \
+    template std::ostream& operator<<(                                         \
+            std::ostream&, const BasicExpression<Text>&);                      \
+    template struct BasicOperand<Text>;                                        \
+    template size_t column_rows(const BasicValueColumn<Text>&);                \
+    template ValueView column_value(const BasicValueColumn<Text>&, size_t);    \
+    template class BasicCreateTableStatement<Text>;                            \
+    template class BasicCreateIndexStatement<Text>;                            \
+    template class BasicInsertStatement<Text>;                                 \
+    template class BasicSelectStatement<Text>;                                 \
+    template class BasicDeleteFromStatement<Text>;                             \
+    template class BasicDropTableStatement<Text>;                              \
+    template std::ostream& operator<<(                                         \
+            std::ostream&, const BasicSqlStatement<Text>&);                    \
+    template SqlStatement to_owning(const BasicSqlStatement<Text>&, Arena&);
+
+RDB_INSTANTIATE_AST(String)
+RDB_INSTANTIATE_AST(std::string_view)
+#undef RDB_INSTANTIATE_AST
+} // namespace rdb::parser
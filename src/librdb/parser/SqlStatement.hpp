@@ -1,122 +1,429 @@
 #pragma once
 
 #include "librdb/Token.hpp"
+#include <algorithm>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 namespace rdb::parser {
-using Value = std::variant<long, double, std::string>;
+// Statements and the strings and sequences they hold are all allocated from
+// the arena of the ParseResult they belong to, which releases them at once.
+// Building them with the arena's allocator and then moving them in keeps
+// them there; a copy would fall back to the default allocator.
+using Arena = std::pmr::monotonic_buffer_resource;
+using String = std::pmr::string;
+template <typename T>
+using Sequence = std::pmr::vector<T>;
 
-std::ostream& operator<<(std::ostream& os, const Value& value);
+// A `?` in place of a literal: the index-th parameter of a prepared statement,
+// counting from 0 in the order they appear in it.
+struct Placeholder {
+    size_t index;
+};
+
+std::ostream& operator<<(std::ostream& os, Placeholder placeholder);
+
+// The AST comes in two flavours that differ only in how they hold names and
+// literals: as String, copied into the arena, or as std::string_view into
+// the parsed script, which must then outlive the AST. The latter are the
+// *View aliases below, returned by parse_sql_view().
+template <typename Text>
+using BasicValue = std::variant<long, double, Text, Placeholder>;
+using Value = BasicValue<String>;
+using ValueView = BasicValue<std::string_view>;
 
-struct Operand {
+template <typename Text>
+std::ostream& operator<<(std::ostream& os, const BasicValue<Text>& value);
+
+template <typename Text>
+struct BasicOperand {
     bool is_id;
-    Value val;
-    Operand(Value&& val, const bool is_id = false);
-    Operand(long&& val);
+    BasicValue<Text> val;
+    BasicOperand(BasicValue<Text>&& val, const bool is_id = false);
+    BasicOperand(long&& val);
 };
+using Operand = BasicOperand<String>;
+using OperandView = BasicOperand<std::string_view>;
 
-std::ostream& operator<<(std::ostream& os, const Operand& operand);
+template <typename Text>
+std::ostream& operator<<(std::ostream& os, const BasicOperand<Text>& operand);
 
-typedef struct t_column_def {
-    std::string column_name;
+template <typename Text>
+struct BasicColumnDef {
+    Text column_name;
     TokenType type_name;
-} ColumnDef;
+};
+using ColumnDef = BasicColumnDef<String>;
+using ColumnDefView = BasicColumnDef<std::string_view>;
+
+// The comparison of a WHERE clause, decoded once by the parser.
+enum class CompareOp {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+// The operator an Operation lexeme ("=", "!=", "<", "<=", ">", ">=") spells;
+// throws std::invalid_argument for any other text.
+CompareOp to_compare_op(std::string_view lexeme);
+// The same comparison with its operands swapped: a < b is b > a.
+constexpr CompareOp mirrored(CompareOp op)
+{
+    switch (op) {
+    case CompareOp::Less:
+        return CompareOp::Greater;
+    case CompareOp::LessEqual:
+        return CompareOp::GreaterEqual;
+    case CompareOp::Greater:
+        return CompareOp::Less;
+    case CompareOp::GreaterEqual:
+        return CompareOp::LessEqual;
+    default:
+        return op;
+    }
+}
+
+// Prints the operator as it is written in SQL.
+std::ostream& operator<<(std::ostream& os, CompareOp op);
+
+template <typename Text>
+struct BasicExpression {
+    BasicOperand<Text> loperand;
+    CompareOp operation;
+    BasicOperand<Text> roperand;
+};
+using Expression = BasicExpression<String>;
+using ExpressionView = BasicExpression<std::string_view>;
+
+template <typename Text>
+std::ostream&
+operator<<(std::ostream& os, const BasicExpression<Text>& expression);
+
+// Constructs a T in arena. It is never destroyed, so it may only own memory
+// from the same arena.
+template <typename T, typename... Args>
+T* make_in_arena(Arena& arena, Args&&... args)
+{
+    std::pmr::polymorphic_allocator<T> allocator(&arena);
+    return new (allocator.allocate(1)) T(std::forward<Args>(args)...);
+}
+
+// Text of either flavour from a lexeme; String copies it into arena.
+template <typename Text>
+Text make_text(std::string_view lexeme, Arena& arena)
+{
+    if constexpr (std::is_same_v<Text, String>) {
+        return String(lexeme, &arena);
+    } else {
+        return lexeme;
+    }
+}
+
+// A run of values built in the arena. Nothing there is freed on its own, so
+// unlike a Sequence it needs no allocator and nothing to destroy: a statement
+// holding only these costs nothing to release.
+template <typename T>
+class ArenaArray {
+public:
+    ArenaArray() = default;
+    // Elements already constructed in the arena.
+    ArenaArray(const T* data, size_t size) : data_{data}, size_{size}
+    {
+    }
+    // A copy of [first, last) in arena, whose elements must in turn only own
+    // memory from it.
+    template <typename Iterator>
+    ArenaArray(Arena& arena, Iterator first, Iterator last)
+        : size_{static_cast<size_t>(std::distance(first, last))}
+    {
+        std::pmr::polymorphic_allocator<T> allocator(&arena);
+        T* data = allocator.allocate(size_);
+        std::uninitialized_copy(first, last, data);
+        data_ = data;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+    const T& operator[](size_t index) const
+    {
+        return data_[index];
+    }
+    const T& at(size_t index) const
+    {
+        if (index >= size_) {
+            throw std::out_of_range("ArenaArray: index out of range");
+        }
+        return data_[index];
+    }
+    const T* begin() const
+    {
+        return data_;
+    }
+    const T* end() const
+    {
+        return data_ + size_;
+    }
+
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// The text values of one column of an INSERT, by row. The owning flavour
+// copies them one after another into a single buffer in the arena; the view
+// flavour keeps where they are in the script. Rows is anything with size()
+// and an operator[] giving each row's text.
+template <typename Text>
+class BasicTextColumn;
 
-typedef struct t_expression {
-    Operand loperand;
-    std::string operation;
-    Operand roperand;
-} Expression;
+template <>
+class BasicTextColumn<String> {
+public:
+    template <typename Rows>
+    BasicTextColumn(Arena& arena, const Rows& rows)
+    {
+        std::pmr::polymorphic_allocator<size_t> allocator(&arena);
+        size_t* ends = allocator.allocate(rows.size());
+        size_t bytes = 0;
+        for (size_t row = 0; row < rows.size(); row++) {
+            bytes += std::string_view(rows[row]).size();
+            ends[row] = bytes;
+        }
+        char* buffer = std::pmr::polymorphic_allocator<char>(&arena).allocate(
+                bytes);
+        for (size_t row = 0; row < rows.size(); row++) {
+            std::string_view text(rows[row]);
+            std::copy(
+                    text.begin(), text.end(), buffer + ends[row] - text.size());
+        }
+        bytes_ = buffer;
+        ends_ = ArenaArray<size_t>(ends, rows.size());
+    }
+
+    size_t size() const;
+    std::string_view operator[](size_t row) const;
 
-std::ostream& operator<<(std::ostream& os, const Expression& expression);
+private:
+    const char* bytes_;
+    // Where each row's text ends in bytes_.
+    ArenaArray<size_t> ends_;
+};
 
-class SqlStatement {
+template <>
+class BasicTextColumn<std::string_view> {
 public:
-    virtual ~SqlStatement() = default;
-    virtual void print(std::ostream& os) const = 0;
+    template <typename Rows>
+    BasicTextColumn(Arena& arena, const Rows& rows)
+    {
+        std::pmr::polymorphic_allocator<std::string_view> allocator(&arena);
+        std::string_view* views = allocator.allocate(rows.size());
+        for (size_t row = 0; row < rows.size(); row++) {
+            new (views + row) std::string_view(rows[row]);
+        }
+        views_ = ArenaArray<std::string_view>(views, rows.size());
+    }
+
+    size_t size() const;
+    std::string_view operator[](size_t row) const;
+
+private:
+    ArenaArray<std::string_view> views_;
 };
 
-std::ostream& operator<<(std::ostream& os, const SqlStatement& statement);
+using TextColumn = BasicTextColumn<String>;
+using TextColumnView = BasicTextColumn<std::string_view>;
+
+// The values of one column of an INSERT, by row. A column whose values are
+// all integers, all reals or all text keeps them unboxed in an array of that
+// type; any other mix, or a placeholder among them, boxes every value.
+template <typename Text>
+using BasicValueColumn = std::variant<
+        ArenaArray<long>,
+        ArenaArray<double>,
+        BasicTextColumn<Text>,
+        ArenaArray<BasicValue<Text>>>;
+using ValueColumn = BasicValueColumn<String>;
+using ValueColumnView = BasicValueColumn<std::string_view>;
+
+template <typename Text>
+size_t column_rows(const BasicValueColumn<Text>& column);
+// The value in row, its text (if any) viewing the column.
+template <typename Text>
+ValueView column_value(const BasicValueColumn<Text>& column, size_t row);
 
-class CreateTableStatement : public SqlStatement {
+template <typename Text>
+class BasicCreateTableStatement {
 private:
-    std::string table_name_;
-    std::vector<ColumnDef> column_def_seq_;
+    Text table_name_;
+    Sequence<BasicColumnDef<Text>> column_def_seq_;
 
 public:
-    ~CreateTableStatement() = default;
-    CreateTableStatement(std::string&&, std::vector<ColumnDef>&&);
+    BasicCreateTableStatement(Text&&, Sequence<BasicColumnDef<Text>>&&);
     void print(std::ostream& os) const;
-    const std::string& table_name() const;
-    const ColumnDef& column_def(size_t index) const;
+    // An owning copy of the statement, built in arena.
+    BasicCreateTableStatement<String> to_owning(Arena& arena) const;
+    const Text& table_name() const;
+    const BasicColumnDef<Text>& column_def(size_t index) const;
     size_t columns_defined() const;
 };
 
-class InsertStatement : public SqlStatement {
+// How an index keeps the values of its column: in order, answering any
+// comparison but !=, or hashed, answering = alone.
+enum class IndexKind { Ordered, Hash };
+
+std::ostream& operator<<(std::ostream& os, IndexKind kind);
+
+// CREATE [HASH] INDEX index_name ON table_name (column_name);
+template <typename Text>
+class BasicCreateIndexStatement {
 private:
-    std::string table_name_;
-    std::vector<std::string> column_name_seq_;
-    std::vector<Value> value_seq_;
+    Text index_name_;
+    Text table_name_;
+    Text column_name_;
+    IndexKind kind_;
 
 public:
-    ~InsertStatement() = default;
-    InsertStatement(
-            std::string&&, std::vector<std::string>&&, std::vector<Value>&&);
+    BasicCreateIndexStatement(
+            Text&& index_name,
+            Text&& table_name,
+            Text&& column_name,
+            IndexKind kind);
     void print(std::ostream& os) const;
-    const std::string& table_name() const;
-    const std::string& column_name(size_t index) const;
+    // An owning copy of the statement, built in arena.
+    BasicCreateIndexStatement<String> to_owning(Arena& arena) const;
+    const Text& index_name() const;
+    const Text& table_name() const;
+    const Text& column_name() const;
+    IndexKind kind() const;
+};
+
+// Inserts one or more rows, stored by column: value_column(index) holds the
+// rows' values for column_name(index).
+template <typename Text>
+class BasicInsertStatement {
+private:
+    Text table_name_;
+    Sequence<Text> column_name_seq_;
+    ArenaArray<BasicValueColumn<Text>> value_columns_;
+    size_t rows_;
+
+public:
+    BasicInsertStatement(
+            Text&&,
+            Sequence<Text>&&,
+            ArenaArray<BasicValueColumn<Text>> value_columns,
+            size_t rows);
+    void print(std::ostream& os) const;
+    // An owning copy of the statement, built in arena.
+    BasicInsertStatement<String> to_owning(Arena& arena) const;
+    const Text& table_name() const;
+    const Text& column_name(size_t index) const;
     size_t columns_defined() const;
-    const Value& value(size_t index) const;
+    size_t rows() const;
+    const BasicValueColumn<Text>& value_column(size_t index) const;
+    // The index-th column's value in row, as column_value() returns it.
+    ValueView value(size_t index, size_t row = 0) const;
 };
 
-class SelectStatement : public SqlStatement {
+template <typename Text>
+class BasicSelectStatement {
 private:
-    std::string table_name_;
-    std::vector<std::string> column_name_seq_;
-    bool has_expression_cond_;
-    Expression expression_;
+    Text table_name_;
+    Sequence<Text> column_name_seq_;
+    // Kept in the arena, so that a WHERE clause only costs the statements
+    // that have one; null without it.
+    const BasicExpression<Text>* expression_;
 
 public:
-    ~SelectStatement() = default;
-    SelectStatement(
-            std::string&&,
-            std::vector<std::string>&&,
-            const Expression& = Expression{0, "N", 0});
+    BasicSelectStatement(
+            Text&&,
+            Sequence<Text>&&,
+            const BasicExpression<Text>* expression = nullptr);
     void print(std::ostream& os) const;
-    const std::string& table_name() const;
-    const std::string& column_name(size_t index) const;
+    // An owning copy of the statement, built in arena.
+    BasicSelectStatement<String> to_owning(Arena& arena) const;
+    const Text& table_name() const;
+    const Text& column_name(size_t index) const;
     size_t columns_defined() const;
     bool has_expression() const;
-    const Expression& expression() const;
+    const BasicExpression<Text>& expression() const;
 };
 
-class DeleteFromStatement : public SqlStatement {
+template <typename Text>
+class BasicDeleteFromStatement {
 private:
-    std::string table_name_;
-    bool has_expression_cond_;
-    Expression expression_;
+    Text table_name_;
+    const BasicExpression<Text>* expression_;
 
 public:
-    ~DeleteFromStatement() = default;
-    DeleteFromStatement(
-            std::string&&, const Expression& = Expression{0, "N", 0});
+    BasicDeleteFromStatement(
+            Text&&, const BasicExpression<Text>* expression = nullptr);
     void print(std::ostream& os) const;
-    const std::string& table_name() const;
+    // An owning copy of the statement, built in arena.
+    BasicDeleteFromStatement<String> to_owning(Arena& arena) const;
+    const Text& table_name() const;
     bool has_expression() const;
-    const Expression& expression() const;
+    const BasicExpression<Text>& expression() const;
 };
 
-class DropTableStatement : public SqlStatement {
+template <typename Text>
+class BasicDropTableStatement {
 private:
-    std::string table_name_;
+    Text table_name_;
 
 public:
-    ~DropTableStatement() = default;
-    DropTableStatement(std::string&&);
+    BasicDropTableStatement(Text&&);
     void print(std::ostream& os) const;
-    const std::string& table_name() const;
+    // An owning copy of the statement, built in arena.
+    BasicDropTableStatement<String> to_owning(Arena& arena) const;
+    const Text& table_name() const;
 };
-} // namespace rdb::parser
\ No newline at end of file
+
+using CreateTableStatement = BasicCreateTableStatement<String>;
+using CreateTableStatementView = BasicCreateTableStatement<std::string_view>;
+using CreateIndexStatement = BasicCreateIndexStatement<String>;
+using CreateIndexStatementView = BasicCreateIndexStatement<std::string_view>;
+using InsertStatement = BasicInsertStatement<String>;
+using InsertStatementView = BasicInsertStatement<std::string_view>;
+using SelectStatement = BasicSelectStatement<String>;
+using SelectStatementView = BasicSelectStatement<std::string_view>;
+using DeleteFromStatement = BasicDeleteFromStatement<String>;
+using DeleteFromStatementView = BasicDeleteFromStatement<std::string_view>;
+using DropTableStatement = BasicDropTableStatement<String>;
+using DropTableStatementView = BasicDropTableStatement<std::string_view>;
+
+// A statement of either flavour. Scripts keep them by value, side by side,
+// and consumers dispatch on the alternative with std::visit.
+template <typename Text>
+using BasicSqlStatement = std::variant<
+        BasicCreateTableStatement<Text>,
+        BasicInsertStatement<Text>,
+        BasicSelectStatement<Text>,
+        BasicDeleteFromStatement<Text>,
+        BasicDropTableStatement<Text>,
+        BasicCreateIndexStatement<Text>>;
+using SqlStatement = BasicSqlStatement<String>;
+using SqlStatementView = BasicSqlStatement<std::string_view>;
+
+template <typename Text>
+std::ostream&
+operator<<(std::ostream& os, const BasicSqlStatement<Text>& statement);
+
+// An owning copy, built in arena, of a statement of either flavour.
+template <typename Text>
+SqlStatement to_owning(const BasicSqlStatement<Text>& statement, Arena& arena);
+} // namespace rdb::parser
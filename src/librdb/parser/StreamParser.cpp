@@ -0,0 +1,141 @@
+#include "StreamParser.hpp"
+#include "librdb/lexer/ScanKernels.hpp"
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(RDB_POSIX)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+using rdb::parser::ParseResult;
+using rdb::parser::Position;
+using rdb::parser::StreamParser;
+
+StreamParser::StreamParser(StatementHandler on_statement, ErrorHandler on_error)
+    : on_statement{std::move(on_statement)},
+      on_error{std::move(on_error)},
+      scan_pos{0},
+      in_text{false},
+      quote_pos{0},
+      origin{1, 1}
+{
+}
+
+void StreamParser::feed(std::string_view chunk)
+{
+    buffer.append(chunk);
+
+    // The statements completed by this chunk are parsed together, which
+    // parse_sql() does exactly as it would one at a time.
+    size_t consumed = 0;
+    size_t statement_end;
+    while ((statement_end = find_statement_end()) != std::string::npos) {
+        consumed = statement_end;
+    }
+
+    if (consumed != 0) {
+        parse(std::string_view(buffer).substr(0, consumed));
+        buffer.erase(0, consumed);
+        scan_pos -= consumed;
+        quote_pos -= in_text ? consumed : 0;
+    }
+}
+
+void StreamParser::finish()
+{
+    parse(buffer);
+    buffer.clear();
+    scan_pos = 0;
+    in_text = false;
+}
+
+// Returns the offset just past the next ';' that ends a statement, or npos if
+// the buffered text does not complete one yet. A string literal runs to the
+// next '"' on the same line, exactly as the lexer reads it; a quote that line
+// ends first lexes as a lone Unknown token, and the text after it does not
+// belong to any literal.
+size_t StreamParser::find_statement_end()
+{
+    const char* data = buffer.data();
+    const char* end = data + buffer.size();
+    const char* pos = data + scan_pos;
+    while (true) {
+        if (in_text) {
+            pos = rdb::parser::skip_text(pos, end);
+            if (pos == end) {
+                break;
+            }
+            in_text = false;
+            pos = *pos == '"' ? pos + 1 : data + quote_pos + 1;
+            continue;
+        }
+        pos = rdb::parser::skip_statement(pos, end);
+        if (pos == end) {
+            break;
+        }
+        if (*pos == ';') {
+            scan_pos = pos + 1 - data;
+            return scan_pos;
+        }
+        in_text = true;
+        quote_pos = pos - data;
+        pos++;
+    }
+    scan_pos = pos - data;
+    return std::string::npos;
+}
+
+void StreamParser::parse(std::string_view text)
+{
+    ParseResult sql = rdb::parser::parse_sql(text, origin);
+    for (auto&& statement : sql.sql_script.sql_statements) {
+        on_statement(statement);
+    }
+    for (auto&& error : sql.errors) {
+        on_error(error);
+    }
+
+    size_t newlines = rdb::parser::count_newlines(
+            text.data(), text.data() + text.size());
+    if (newlines == 0) {
+        origin.col += text.size();
+    } else {
+        origin.row += newlines;
+        origin.col = text.size() - text.rfind('\n');
+    }
+}
+
+void rdb::parser::parse_sql_stream(
+        std::istream& input, StreamParser& parser, size_t chunk_size)
+{
+    std::vector<char> chunk(chunk_size);
+    while (input.read(chunk.data(), chunk.size()) || input.gcount() != 0) {
+        parser.feed(std::string_view(
+                chunk.data(), static_cast<size_t>(input.gcount())));
+    }
+    parser.finish();
+}
+
+#if defined(RDB_POSIX)
+void rdb::parser::parse_sql_stream(
+        int fd, StreamParser& parser, size_t chunk_size)
+{
+    std::vector<char> chunk(chunk_size);
+    while (true) {
+        ssize_t count = ::read(fd, chunk.data(), chunk.size());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (count == 0) {
+            break;
+        }
+        parser.feed(std::string_view(chunk.data(), static_cast<size_t>(count)));
+    }
+    parser.finish();
+}
+#endif
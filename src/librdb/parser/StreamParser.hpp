@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Parser.hpp"
+#include "librdb/Platform.hpp"
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace rdb::parser {
+// Both are only valid until the handler returns: the statement belongs to its
+// chunk's ParseResult and the error's lexeme points into the parser's buffer.
+// Errors come already located.
+using StatementHandler = std::function<void(const SqlStatement&)>;
+using ErrorHandler = std::function<void(const Error&)>;
+
+// Parses a script that arrives in chunks of any size, passing every statement
+// to a handler as soon as its closing semicolon has been read. Only the
+// statement in progress is buffered, so memory stays proportional to the
+// largest statement however long the script is.
+//
+// Statements are cut at each ';' outside a string literal. parse_sql() resumes
+// there after an error, and no list runs on past one, so both report the
+// same statements and errors, the latter at the same rows and columns.
+class StreamParser {
+public:
+    StreamParser(StatementHandler on_statement, ErrorHandler on_error);
+    void feed(std::string_view chunk);
+    // Parses whatever follows the last semicolon; call once the input ends.
+    void finish();
+
+private:
+    StatementHandler on_statement;
+    ErrorHandler on_error;
+    std::string buffer;
+    // How far buffer has been searched for the end of its first statement.
+    size_t scan_pos;
+    // Set while scan_pos is inside the string literal opened at quote_pos.
+    bool in_text;
+    size_t quote_pos;
+    Position origin;
+
+    size_t find_statement_end();
+    void parse(std::string_view text);
+};
+
+constexpr size_t StreamChunkSize = 64 * 1024;
+
+// Feed parser from input until it ends, then finish it. Each read waits for a
+// full chunk, so this suits files better than live pipes.
+void parse_sql_stream(
+        std::istream& input,
+        StreamParser& parser,
+        size_t chunk_size = StreamChunkSize);
+#if defined(RDB_POSIX)
+// As above, but hands over whatever each read() returns, so statements from a
+// pipe are reported as soon as they arrive. Throws std::system_error.
+void parse_sql_stream(
+        int fd, StreamParser& parser, size_t chunk_size = StreamChunkSize);
+#endif
+} // namespace rdb::parser
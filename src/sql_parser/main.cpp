@@ -1,12 +1,21 @@
 #include "CLI/App.hpp"
 #include "CLI/Config.hpp"
 #include "CLI/Formatter.hpp"
+#include "librdb/InputSource.hpp"
 #include "librdb/lexer/Lexer.hpp"
+#include "librdb/parser/ParallelParser.hpp"
 #include "librdb/parser/Parser.hpp"
+#include "librdb/parser/StreamParser.hpp"
 
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <system_error>
+
+#if defined(RDB_POSIX)
+#include <unistd.h>
+#endif
 
 int main(int argc, char* argv[])
 {
@@ -14,14 +23,23 @@ int main(int argc, char* argv[])
 
     std::string input_file;
     std::string output_file;
+    bool stream_mode = false;
+    unsigned threads = 1;
 
-    std::ifstream input_file_stream;
     std::ofstream output_file_stream;
 
     CLI::Option* opt_i = app.add_option<std::string>(
             "-i,--input", input_file, "Input File");
     CLI::Option* opt_o = app.add_option<std::string>(
             "-o,--output", output_file, "Output File");
+    app.add_flag(
+            "-s,--stream",
+            stream_mode,
+            "Print each statement as soon as it has been read");
+    app.add_option<unsigned>(
+            "-j,--threads",
+            threads,
+            "Parse on this many threads, 0 meaning one per core");
 
     try {
         app.parse(argc, argv);
@@ -29,32 +47,73 @@ int main(int argc, char* argv[])
         return app.exit(e);
     }
 
-    std::string sql_inquiry;
-    if (*opt_i) {
-        input_file_stream.open(input_file, std::ifstream::in);
-        sql_inquiry = std::string(
-                std::istreambuf_iterator<char>(input_file_stream), {});
-    } else {
-        std::cout << "Type an SQL-expression:" << '\n';
-        std::getline(std::cin, sql_inquiry);
-    }
-
     std::ostream* output_stream = &std::cout;
     if (*opt_o) {
         output_file_stream.open(output_file, std::ofstream::out);
         output_stream = &output_file_stream;
     }
 
-    auto sql(rdb::parser::parse_sql(sql_inquiry));
+    if (stream_mode) {
+        rdb::parser::StreamParser parser(
+                [output_stream](const rdb::parser::SqlStatement& statement) {
+                    *output_stream << statement << "\n";
+                },
+                [](const rdb::parser::Error& error) {
+                    std::clog << error << "\n";
+                });
+        try {
+            if (*opt_i) {
+                std::ifstream input_file_stream(
+                        input_file, std::ifstream::binary);
+                if (!input_file_stream) {
+                    throw std::system_error(
+                            std::make_error_code(
+                                    std::errc::no_such_file_or_directory),
+                            input_file);
+                }
+                rdb::parser::parse_sql_stream(input_file_stream, parser);
+            } else {
+#if defined(RDB_POSIX)
+                rdb::parser::parse_sql_stream(STDIN_FILENO, parser);
+#else
+                rdb::parser::parse_sql_stream(std::cin, parser);
+#endif
+            }
+        } catch (const std::system_error& e) {
+            std::clog << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    std::optional<rdb::InputSource> sql_inquiry;
+    try {
+        if (*opt_i) {
+            sql_inquiry.emplace(input_file);
+        } else if (!rdb::InputSource::standard_input_is_terminal()) {
+            sql_inquiry.emplace(rdb::InputSource::standard_input());
+        } else {
+            std::cout << "Type an SQL-expression:" << '\n';
+            std::string line;
+            std::getline(std::cin, line);
+            sql_inquiry = rdb::InputSource::from_text(std::move(line));
+        }
+    } catch (const std::system_error& e) {
+        std::clog << e.what() << "\n";
+        return 1;
+    }
+
+    auto sql(
+            (threads == 1)
+                    ? rdb::parser::parse_sql(sql_inquiry->view())
+                    : rdb::parser::parse_sql_parallel(
+                            sql_inquiry->view(), threads));
 
     *output_stream << sql.sql_script << "\n";
     for (auto&& error : sql.errors) {
         std::clog << error << "\n";
     }
 
-    if (input_file_stream.is_open()) {
-        input_file_stream.close();
-    }
     if (output_file_stream.is_open()) {
         output_file_stream.close();
     }
@@ -0,0 +1,114 @@
+#include "librdb/BufferPool.hpp"
+#include "librdb/Pager.hpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using rdb::BufferPool;
+using rdb::PageId;
+using rdb::Pager;
+using rdb::PinnedPage;
+
+namespace {
+class BufferPoolTest : public ::testing::Test {
+protected:
+    const std::string path = ::testing::TempDir() + "BufferPoolTest.pages";
+    Pager pager{path};
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    // A new page holding text at its start.
+    static PageId write(BufferPool& pool, const std::string& text)
+    {
+        PinnedPage page = pool.pin_new();
+        std::memcpy(page.data(), text.c_str(), text.size() + 1);
+        return page.id();
+    }
+
+    static std::string read(BufferPool& pool, PageId id)
+    {
+        return pool.pin(id).data();
+    }
+};
+} // namespace
+
+TEST_F(BufferPoolTest, PagerReusesFreedPages)
+{
+    std::vector<char> out(Pager::PageSize, 'x');
+    std::vector<char> in(Pager::PageSize);
+    PageId first = pager.allocate();
+    PageId second = pager.allocate();
+    ASSERT_NE(first, second);
+    pager.write(second, out.data());
+    pager.read(second, in.data());
+    ASSERT_EQ(in, out);
+    pager.free(first);
+    ASSERT_EQ(pager.allocate(), first);
+    ASSERT_EQ(pager.pages(), 2);
+}
+
+TEST_F(BufferPoolTest, EvictsAndReadsBack)
+{
+    BufferPool pool(pager, 4);
+    std::vector<PageId> pages;
+    for (int page = 0; page < 20; page++) {
+        pages.push_back(write(pool, "page " + std::to_string(page)));
+    }
+    ASSERT_EQ(pool.stats().evictions, 16);
+    ASSERT_EQ(pool.stats().writes, 16);
+    // Newest first: the four still in frames, then the others read back.
+    for (int page = 19; page >= 0; page--) {
+        ASSERT_EQ(read(pool, pages[page]), "page " + std::to_string(page));
+    }
+    ASSERT_EQ(pool.stats().misses, 16);
+    ASSERT_EQ(pool.stats().hits, 4);
+    ASSERT_DOUBLE_EQ(pool.stats().hit_ratio(), 0.2);
+}
+
+TEST_F(BufferPoolTest, KeepsPinnedAndReferencedPages)
+{
+    BufferPool pool(pager, 3);
+    PageId hot = write(pool, "hot");
+    PinnedPage pinned = pool.pin(write(pool, "pinned"));
+    ASSERT_EQ(pool.pin_count(pinned.id()), 1);
+    {
+        PinnedPage again = pool.pin(pinned.id());
+        ASSERT_EQ(pool.pin_count(pinned.id()), 2);
+    }
+    ASSERT_EQ(pool.pin_count(pinned.id()), 1);
+
+    // The third frame is the only one the clock can take from now on, save
+    // for hot whenever its reference bit is clear.
+    for (int page = 0; page < 10; page++) {
+        write(pool, "cold");
+        read(pool, hot);
+    }
+    pool.reset_stats();
+    ASSERT_EQ(read(pool, hot), "hot");
+    ASSERT_EQ(std::string(pinned.data()), "pinned");
+    ASSERT_EQ(pool.stats().hits, 1);
+
+    PinnedPage other = pool.pin(hot);
+    PinnedPage third = pool.pin_new();
+    ASSERT_THROW(pool.pin_new(), std::runtime_error);
+}
+
+TEST_F(BufferPoolTest, FreedPagesAreForgotten)
+{
+    BufferPool pool(pager, 2);
+    PageId page = write(pool, "gone");
+    {
+        PinnedPage pinned = pool.pin(page);
+        ASSERT_THROW(pool.free(page), std::logic_error);
+    }
+    pool.free(page);
+    ASSERT_EQ(pool.pin_count(page), 0);
+    ASSERT_EQ(write(pool, "reused"), page);
+    ASSERT_EQ(read(pool, page), "reused");
+}
@@ -0,0 +1,63 @@
+#include "librdb/InputSource.hpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+using rdb::InputSource;
+
+namespace {
+class InputSourceTest : public ::testing::Test {
+protected:
+    const std::string path = ::testing::TempDir() + "InputSourceTest.sql";
+
+    void write(const std::string& content)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+};
+} // namespace
+
+TEST_F(InputSourceTest, ReadsWholeFile)
+{
+    std::string content("CREATE TABLE t (x INT);\n");
+    for (int i = 0; i < 12; i++) {
+        content += content;
+    }
+    write(content);
+
+    InputSource input(path);
+    ASSERT_EQ(input.view(), content);
+#if defined(RDB_POSIX)
+    ASSERT_TRUE(input.is_mapped());
+#endif
+
+    InputSource moved(std::move(input));
+    ASSERT_EQ(moved.view(), content);
+}
+
+TEST_F(InputSourceTest, HandlesEmptyFile)
+{
+    write("");
+    InputSource input(path);
+    ASSERT_TRUE(input.view().empty());
+}
+
+TEST_F(InputSourceTest, ThrowsOnMissingFile)
+{
+    ASSERT_THROW(InputSource(path + ".missing"), std::system_error);
+}
+
+TEST(InputSourceTextTest, WrapsText)
+{
+    InputSource input = InputSource::from_text("DROP TABLE t;");
+    ASSERT_FALSE(input.is_mapped());
+    ASSERT_EQ(input.view(), "DROP TABLE t;");
+}
@@ -0,0 +1,60 @@
+#include "librdb/WorkStealingPool.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using rdb::WorkStealingPool;
+
+TEST(WorkStealingPoolTest, RunsEveryIndexOnce)
+{
+    for (unsigned threads : {1, 2, 5}) {
+        WorkStealingPool pool(threads);
+        ASSERT_EQ(pool.size(), threads);
+        for (size_t count : {0, 1, 3, 100, 1000}) {
+            std::vector<std::atomic<int>> runs(count);
+            pool.run(count, [&runs](size_t index) { runs[index]++; });
+            for (size_t index = 0; index < count; index++) {
+                ASSERT_EQ(runs[index], 1) << threads << " " << index;
+            }
+        }
+    }
+}
+
+TEST(WorkStealingPoolTest, StealsFromBusyThreads)
+{
+    WorkStealingPool pool(4);
+    std::atomic<size_t> done(0);
+    // Index 0 is thread 0's first task; the rest of its range has to be
+    // taken by the others while it waits for them.
+    pool.run(64, [&done](size_t index) {
+        if (index == 0) {
+            while (done < 63) {
+                std::this_thread::yield();
+            }
+        }
+        done++;
+    });
+    ASSERT_EQ(done, 64);
+}
+
+TEST(WorkStealingPoolTest, RethrowsAfterBatchCompletes)
+{
+    WorkStealingPool pool(3);
+    std::atomic<size_t> runs(0);
+    ASSERT_THROW(
+            pool.run(50,
+                     [&runs](size_t index) {
+                         runs++;
+                         if (index % 10 == 3) {
+                             throw std::runtime_error("task failed");
+                         }
+                     }),
+            std::runtime_error);
+    ASSERT_EQ(runs, 50);
+
+    runs = 0;
+    pool.run(10, [&runs](size_t) { runs++; });
+    ASSERT_EQ(runs, 10);
+}
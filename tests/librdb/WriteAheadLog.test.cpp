@@ -0,0 +1,150 @@
+#include "librdb/WriteAheadLog.hpp"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using rdb::WriteAheadLog;
+
+namespace {
+class WriteAheadLogTest : public ::testing::Test {
+protected:
+    const std::string path = ::testing::TempDir() + "WriteAheadLogTest.log";
+
+    void SetUp() override
+    {
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    // The records in the log, as a new WriteAheadLog replays them.
+    std::vector<std::string> records()
+    {
+        std::vector<std::string> replayed;
+        WriteAheadLog log(path, [&replayed](std::string_view record) {
+            replayed.emplace_back(record);
+        });
+        EXPECT_EQ(log.replayed(), replayed.size());
+        return replayed;
+    }
+
+    size_t file_size()
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return static_cast<size_t>(file.tellg());
+    }
+};
+
+void ignore(std::string_view)
+{
+}
+} // namespace
+
+TEST_F(WriteAheadLogTest, ReplaysCommittedRecords)
+{
+    {
+        WriteAheadLog log(path, ignore);
+        ASSERT_EQ(log.replayed(), 0);
+        log.commit("first");
+        log.commit("");
+        log.commit(std::string("with\0zero", 9));
+        ASSERT_EQ(log.flushes(), 3);
+    }
+    {
+        WriteAheadLog log(path, ignore);
+        ASSERT_EQ(log.replayed(), 3);
+        log.commit("fourth");
+    }
+    ASSERT_EQ(
+            records(),
+            std::vector<std::string>(
+                    {"first", "", std::string("with\0zero", 9), "fourth"}));
+}
+
+TEST_F(WriteAheadLogTest, WritesOutUnflushedRecordsWhenClosed)
+{
+    {
+        WriteAheadLog log(path, ignore);
+        ASSERT_EQ(log.append("a"), 1);
+        ASSERT_EQ(log.append("b"), 2);
+        log.flush(1);
+        ASSERT_EQ(log.flushes(), 1);
+        log.flush(2);
+        ASSERT_EQ(log.flushes(), 1);
+        log.append("c");
+    }
+    ASSERT_EQ(records(), std::vector<std::string>({"a", "b", "c"}));
+}
+
+TEST_F(WriteAheadLogTest, CutsOffTornRecord)
+{
+    {
+        WriteAheadLog log(path, ignore);
+        log.commit("kept");
+        log.commit("torn record");
+    }
+    size_t whole = file_size();
+    {
+        // A crash in the middle of writing the second record, then garbage.
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes(whole, '\0');
+        in.read(bytes.data(), static_cast<std::streamsize>(whole));
+        in.close();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << bytes.substr(0, whole - 3);
+    }
+    {
+        WriteAheadLog log(path, ignore);
+        ASSERT_EQ(log.replayed(), 1);
+        log.commit("after");
+    }
+    ASSERT_EQ(records(), std::vector<std::string>({"kept", "after"}));
+
+    // A record whose bytes do not match its checksum ends the log as well.
+    {
+        std::fstream file(
+                path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('X');
+    }
+    ASSERT_EQ(records(), std::vector<std::string>({"kept"}));
+}
+
+TEST_F(WriteAheadLogTest, GroupsConcurrentCommits)
+{
+    constexpr size_t Threads = 8;
+    constexpr size_t Commits = 50;
+    {
+        WriteAheadLog log(path, ignore, std::chrono::microseconds(200));
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < Threads; thread++) {
+            writers.emplace_back([&log, thread] {
+                for (size_t commit = 0; commit < Commits; commit++) {
+                    log.commit(
+                            std::to_string(thread) + ":"
+                            + std::to_string(commit));
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        ASSERT_LE(log.flushes(), Threads * Commits);
+    }
+    auto replayed = records();
+    ASSERT_EQ(replayed.size(), Threads * Commits);
+    // Each thread's records are in the order it committed them.
+    std::vector<size_t> next(Threads, 0);
+    for (const auto& record : replayed) {
+        size_t colon = record.find(':');
+        size_t thread = std::stoul(record.substr(0, colon));
+        ASSERT_EQ(std::stoul(record.substr(colon + 1)), next[thread]++);
+    }
+}
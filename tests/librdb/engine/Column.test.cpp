@@ -0,0 +1,58 @@
+#include "librdb/engine/Column.hpp"
+#include "librdb/engine/Selection.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using rdb::engine::Column;
+using rdb::engine::Selection;
+using rdb::engine::TextColumn;
+
+TEST(SelectionTest, PacksRowsIntoWords)
+{
+    Selection all(70, true);
+    ASSERT_EQ(all.word_count(), 2);
+    ASSERT_EQ(all.count(), 70);
+    ASSERT_TRUE(all.test(69));
+    ASSERT_EQ(all.words()[1], (uint64_t{1} << 6) - 1);
+
+    Selection some(130);
+    ASSERT_EQ(some.count(), 0);
+    some.words()[0] = 0b101;
+    some.words()[2] = 0b10;
+    std::vector<size_t> rows;
+    some.for_each([&rows](size_t row) { rows.push_back(row); });
+    ASSERT_EQ(rows, (std::vector<size_t>{0, 2, 129}));
+}
+
+TEST(ColumnTest, GatherAndRetain)
+{
+    TextColumn texts;
+    std::vector<long> numbers;
+    for (long row = 0; row < 100; row++) {
+        texts.push_back(std::string(row % 3, 'x') + std::to_string(row));
+        numbers.push_back(row);
+    }
+    Selection odd(100);
+    for (size_t word = 0; word < odd.word_count(); word++) {
+        odd.words()[word] = 0xaaaaaaaaaaaaaaaaULL;
+    }
+    odd.words()[1] &= (uint64_t{1} << 36) - 1;
+
+    Column text_column = texts;
+    auto gathered = std::get<TextColumn>(rdb::engine::gather(text_column, odd));
+    ASSERT_EQ(gathered.size(), 50);
+    ASSERT_EQ(gathered[1], "3");
+    ASSERT_EQ(gathered[49], "99");
+
+    Column number_column = numbers;
+    rdb::engine::retain(number_column, odd);
+    rdb::engine::retain(text_column, odd);
+    ASSERT_EQ(rdb::engine::column_rows(number_column), 50);
+    ASSERT_EQ(std::get<std::vector<long>>(number_column)[49], 98);
+    const auto& kept = std::get<TextColumn>(text_column);
+    ASSERT_EQ(kept.size(), 50);
+    ASSERT_EQ(kept[0], "0");
+    ASSERT_EQ(kept[1], "xx2");
+    ASSERT_EQ(kept[49], "xx98");
+}
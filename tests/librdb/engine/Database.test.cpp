@@ -0,0 +1,359 @@
+#include "librdb/engine/Database.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using rdb::engine::Database;
+using rdb::engine::ExecErrorType;
+using rdb::engine::ExecResult;
+using rdb::engine::Expected;
+using rdb::engine::Table;
+
+namespace {
+// Parses and runs sql, which must parse cleanly.
+std::vector<Expected<ExecResult>> run(Database& database, std::string_view sql)
+{
+    auto parsed = rdb::parser::parse_sql_view(sql);
+    EXPECT_TRUE(parsed.errors.empty());
+    return database.execute(parsed.sql_script);
+}
+
+std::string print(const Table& table)
+{
+    std::ostringstream os;
+    os << table;
+    return os.str();
+}
+} // namespace
+
+TEST(DatabaseTest, RunsEveryKindOfStatement)
+{
+    Database database;
+    auto results = run(
+            database,
+            "CREATE TABLE users (name TEXT, age INT, meters REAL);"
+            "INSERT INTO users (name, age, meters) VALUES "
+            "(\"Ann\", 31, 1.65), (\"Bob\", 17, 1.8), (\"Cid\", 45, 2);"
+            "INSERT INTO users (age, meters, name) VALUES (9, 1.2, \"Dee\");"
+            "SELECT name age FROM users WHERE age >= 18;"
+            "DELETE FROM users WHERE meters > 1.7;"
+            "SELECT name meters FROM users;");
+    ASSERT_EQ(results.size(), 6);
+    for (auto&& result : results) {
+        ASSERT_TRUE(result) << result.error();
+    }
+    ASSERT_EQ(results[1]->affected, 3);
+    ASSERT_EQ(results[2]->affected, 1);
+    ASSERT_EQ(print(results[3]->rows), "name, age\n\"Ann\", 31\n\"Cid\", 45\n");
+    ASSERT_EQ(results[4]->affected, 2);
+    ASSERT_EQ(
+            print(results[5]->rows),
+            "name, meters\n\"Ann\", 1.65\n\"Dee\", 1.2\n");
+
+    const Table* users = database.table("users");
+    ASSERT_NE(users, nullptr);
+    ASSERT_EQ(users->rows(), 2);
+
+    run(database, "DROP TABLE users;");
+    ASSERT_EQ(database.table("users"), nullptr);
+    ASSERT_EQ(database.tables(), 0);
+}
+
+TEST(DatabaseTest, ColumnsAreTypedArrays)
+{
+    Database database;
+    run(database,
+        "CREATE TABLE t (i INT, r REAL, s TEXT);"
+        "INSERT INTO t (i, r, s) VALUES (1, 2, \"x\"), (3, 4.5, \"yz\");");
+    const Table& table = *database.table("t");
+    ASSERT_EQ(
+            std::get<std::vector<long>>(table.column(0)),
+            (std::vector<long>{1, 3}));
+    // Integers widen into REAL columns.
+    ASSERT_EQ(
+            std::get<std::vector<double>>(table.column(1)),
+            (std::vector<double>{2.0, 4.5}));
+    const auto& texts = std::get<rdb::engine::TextColumn>(table.column(2));
+    ASSERT_EQ(texts[0], "x");
+    ASSERT_EQ(texts[1], "yz");
+}
+
+TEST(DatabaseTest, WhereForms)
+{
+    Database database;
+    run(database,
+        "CREATE TABLE p (lo INT, hi REAL, tag TEXT);"
+        "INSERT INTO p (lo, hi, tag) VALUES "
+        "(1, 0.5, \"a\"), (2, 2.5, \"b\"), (3, 3, \"c\"), (4, 9.5, \"b\");");
+    auto results = run(
+            database,
+            "SELECT tag FROM p WHERE lo < hi;"
+            "SELECT lo FROM p WHERE 2.5 <= hi;"
+            "SELECT lo FROM p WHERE tag = \"b\";"
+            "SELECT lo FROM p WHERE 1 = 1;"
+            "SELECT lo FROM p WHERE 1 > 2;");
+    ASSERT_EQ(print(results[0]->rows), "tag\n\"b\"\n\"b\"\n");
+    ASSERT_EQ(print(results[1]->rows), "lo\n2\n3\n4\n");
+    ASSERT_EQ(print(results[2]->rows), "lo\n2\n4\n");
+    ASSERT_EQ(results[3]->rows.rows(), 4);
+    ASSERT_EQ(results[4]->rows.rows(), 0);
+}
+
+TEST(DatabaseTest, FailedStatementsChangeNothing)
+{
+    Database database;
+    auto results = run(
+            database,
+            "CREATE TABLE t (a INT, b TEXT);"
+            "CREATE TABLE t (a INT);"
+            "CREATE TABLE u (a INT, a REAL);"
+            "INSERT INTO v (a) VALUES (1);"
+            "INSERT INTO t (a, c) VALUES (1, 2);"
+            "INSERT INTO t (a, a) VALUES (1, 2);"
+            "INSERT INTO t (a) VALUES (1);"
+            "INSERT INTO t (a, b) VALUES (1, \"x\"), (2.5, \"y\");"
+            "INSERT INTO t (a, b) VALUES (1, 2);"
+            "SELECT c FROM t;"
+            "SELECT a FROM t WHERE b > 1;"
+            "DELETE FROM t WHERE a = \"1\";"
+            "DELETE FROM t WHERE 1 = \"1\";"
+            "DROP TABLE u;");
+    std::vector<ExecErrorType> expected{
+            ExecErrorType::TableExists,
+            ExecErrorType::DuplicateColumn,
+            ExecErrorType::NoSuchTable,
+            ExecErrorType::NoSuchColumn,
+            ExecErrorType::DuplicateColumn,
+            ExecErrorType::MissingColumn,
+            ExecErrorType::TypeMismatch,
+            ExecErrorType::TypeMismatch,
+            ExecErrorType::NoSuchColumn,
+            ExecErrorType::TypeMismatch,
+            ExecErrorType::TypeMismatch,
+            ExecErrorType::TypeMismatch,
+            ExecErrorType::NoSuchTable};
+    ASSERT_TRUE(results[0]);
+    ASSERT_EQ(results.size(), expected.size() + 1);
+    for (size_t index = 0; index < expected.size(); index++) {
+        ASSERT_FALSE(results[index + 1]) << index;
+        ASSERT_EQ(results[index + 1].error().type(), expected[index]) << index;
+    }
+    ASSERT_EQ(results[6].error().name(), "b");
+    ASSERT_EQ(database.table("t")->rows(), 0);
+    ASSERT_EQ(database.tables(), 1);
+}
+
+TEST(DatabaseTest, PlaceholdersMustBeBound)
+{
+    Database database;
+    auto results = run(
+            database,
+            "CREATE TABLE t (a INT);"
+            "INSERT INTO t (a) VALUES (?);"
+            "SELECT a FROM t WHERE a = ?;");
+    ASSERT_EQ(results[1].error().type(), ExecErrorType::UnboundPlaceholder);
+    ASSERT_EQ(results[2].error().type(), ExecErrorType::UnboundPlaceholder);
+}
+
+TEST(DatabaseTest, DeletesAcrossWords)
+{
+    Database database;
+    std::string sql = "CREATE TABLE t (n INT, s TEXT);"
+                      "INSERT INTO t (n, s) VALUES ";
+    for (int row = 0; row < 200; row++) {
+        sql += (row == 0 ? "(" : ", (") + std::to_string(row) + ", \"v"
+                + std::to_string(row) + "\")";
+    }
+    sql += "; DELETE FROM t WHERE n > 70; DELETE FROM t WHERE n < 3;";
+    sql += "SELECT s FROM t WHERE n >= 69;";
+    auto results = run(database, sql);
+    ASSERT_EQ(results[2]->affected, 129);
+    ASSERT_EQ(results[3]->affected, 3);
+    ASSERT_EQ(database.table("t")->rows(), 68);
+    ASSERT_EQ(print(results[4]->rows), "s\n\"v69\"\n\"v70\"\n");
+}
+
+TEST(DatabaseTest, IndexesAnswerLikeScans)
+{
+    std::string sql = "CREATE TABLE t (n INT, r REAL, s TEXT);"
+                      "INSERT INTO t (n, r, s) VALUES ";
+    for (int row = 0; row < 300; row++) {
+        sql += (row == 0 ? "(" : ", (") + std::to_string(row % 50) + ", "
+                + std::to_string(row % 7) + ".5, \"v"
+                + std::to_string(row % 11) + "\")";
+    }
+    sql += ";";
+    const std::string queries
+            = "SELECT n s FROM t WHERE n = 7;"
+              "SELECT n s FROM t WHERE 12 > n;"
+              "SELECT n s FROM t WHERE r <= 3;"
+              "SELECT n s FROM t WHERE s >= \"v5\";"
+              "SELECT n s FROM t WHERE n != 7;"
+              "SELECT n s FROM t WHERE n = 2.5;"
+              "DELETE FROM t WHERE n < 10;"
+              "INSERT INTO t (n, r, s) VALUES (7, 0.5, \"v5\");"
+              "SELECT n s FROM t WHERE n = 7;"
+              "SELECT n s FROM t WHERE s = \"v5\";"
+              "SELECT n s FROM t WHERE r > 4;";
+
+    Database scanned;
+    run(scanned, sql);
+    Database indexed;
+    run(indexed, sql);
+    auto created = run(
+            indexed,
+            "CREATE HASH INDEX nh ON t (n);"
+            "CREATE INDEX no ON t (n);"
+            "CREATE INDEX ro ON t (r);"
+            "CREATE HASH INDEX sh ON t (s);"
+            "CREATE INDEX so ON t (s);");
+    for (auto&& result : created) {
+        ASSERT_TRUE(result) << result.error();
+    }
+    ASSERT_EQ(indexed.table("t")->indexes(), 5);
+
+    auto expected = run(scanned, queries);
+    auto actual = run(indexed, queries);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t index = 0; index < actual.size(); index++) {
+        ASSERT_TRUE(actual[index]) << actual[index].error();
+        ASSERT_EQ(actual[index]->affected, expected[index]->affected);
+        ASSERT_EQ(print(actual[index]->rows), print(expected[index]->rows))
+                << index;
+    }
+}
+
+TEST(DatabaseTest, CreateIndexErrors)
+{
+    Database database;
+    auto results = run(
+            database,
+            "CREATE TABLE a (x INT);"
+            "CREATE TABLE b (y TEXT);"
+            "CREATE INDEX i ON a (x);"
+            "CREATE HASH INDEX i ON b (y);"
+            "CREATE INDEX j ON a (y);"
+            "CREATE INDEX j ON c (x);"
+            "SELECT x FROM a WHERE x = \"1\";");
+    ASSERT_TRUE(results[2]);
+    ASSERT_EQ(results[3].error().type(), ExecErrorType::IndexExists);
+    ASSERT_EQ(results[4].error().type(), ExecErrorType::NoSuchColumn);
+    ASSERT_EQ(results[5].error().type(), ExecErrorType::NoSuchTable);
+    // The index does not answer for text, and the scan reports it.
+    ASSERT_EQ(results[6].error().type(), ExecErrorType::TypeMismatch);
+    ASSERT_EQ(database.table("b")->indexes(), 0);
+}
+
+TEST(DatabaseTest, LogRebuildsTables)
+{
+    const std::string path = ::testing::TempDir() + "DatabaseTest.log";
+    std::remove(path.c_str());
+    const std::string script
+            = "CREATE TABLE t (n INT, r REAL, s TEXT);"
+              "CREATE TABLE gone (x INT);"
+              "INSERT INTO t (n, r, s) VALUES (1, 1.5, \"a\"), (2, 2.5, \"b\"),"
+              "(3, 3.5, \"c c\"), (4, 4.5, \"\");"
+              "CREATE HASH INDEX tn ON t (n);"
+              "DELETE FROM t WHERE n = 2;"
+              "INSERT INTO t (s, n, r) VALUES (\"e\", 5, 5.5);"
+              "DELETE FROM t WHERE n > 100;"
+              "INSERT INTO t (n, r, s) VALUES (6, \"wrong\", \"f\");"
+              "DROP TABLE gone;"
+              "CREATE INDEX ts ON t (s);";
+    std::string expected;
+    {
+        Database database(path);
+        ASSERT_EQ(database.log()->replayed(), 0);
+        run(database, script);
+        expected = print(*database.table("t"));
+        // No record for the statements that changed nothing.
+        ASSERT_EQ(database.log()->flushes(), 8);
+    }
+    {
+        Database database(path);
+        ASSERT_EQ(database.log()->replayed(), 8);
+        ASSERT_EQ(database.tables(), 1);
+        ASSERT_EQ(print(*database.table("t")), expected);
+        ASSERT_EQ(database.table("t")->indexes(), 2);
+        auto results = run(
+                database,
+                "SELECT s FROM t WHERE n = 5;"
+                "DELETE FROM t WHERE s = \"a\";");
+        ASSERT_EQ(print(results[0]->rows), "s\n\"e\"\n");
+        ASSERT_EQ(results[1]->affected, 1);
+    }
+    {
+        Database database(path);
+        ASSERT_EQ(database.log()->replayed(), 9);
+        ASSERT_EQ(database.table("t")->rows(), 3);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(DatabaseTest, PagedTablesAnswerLikeTablesInMemory)
+{
+    const std::string path = ::testing::TempDir() + "DatabaseTest.pages";
+    rdb::Pager pager(path);
+    rdb::BufferPool pool(pager, 8);
+    Database paged(pool);
+    Database in_memory;
+
+    std::string sql = "CREATE TABLE t (n INT, r REAL, s TEXT);";
+    for (int statement = 0; statement < 20; statement++) {
+        sql += "INSERT INTO t (n, r, s) VALUES ";
+        for (int row = 0; row < 500; row++) {
+            int n = statement * 500 + row;
+            sql += (row == 0 ? "(" : ", (") + std::to_string(n) + ", "
+                    + std::to_string(n % 13) + ".25, \""
+                    + std::string(static_cast<size_t>(n % 40), 'x') + "\")";
+        }
+        sql += ";";
+    }
+    sql += "SELECT n r s FROM t;"
+           "DELETE FROM t WHERE r < 6;"
+           "SELECT s n FROM t WHERE n >= 7000;"
+           "DELETE FROM t WHERE n < 5000;"
+           "INSERT INTO t (n, r, s) VALUES (-1, 0.5, \"last\");"
+           "SELECT n FROM t WHERE s = \"last\";"
+           "SELECT n r s FROM t WHERE r > n;"
+           "SELECT n r s FROM t;";
+    auto expected = run(in_memory, sql);
+    auto actual = run(paged, sql);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t index = 0; index < actual.size(); index++) {
+        ASSERT_TRUE(actual[index]) << actual[index].error();
+        ASSERT_EQ(actual[index]->affected, expected[index]->affected);
+        ASSERT_EQ(print(actual[index]->rows), print(expected[index]->rows))
+                << index;
+    }
+
+    const auto* table = paged.paged_table("t");
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(paged.table("t"), nullptr);
+    ASSERT_EQ(table->rows(), in_memory.table("t")->rows());
+    ASSERT_GT(table->pages(), pool.frames());
+    ASSERT_GT(pool.stats().evictions, 0);
+    ASSERT_GT(pool.stats().prefetches, 0);
+
+    auto results = run(
+            paged,
+            "INSERT INTO t (n, r, s) VALUES (1, 1.0, \""
+                    + std::string(rdb::Pager::PageSize, 'x')
+                    + "\");"
+                      "CREATE INDEX tn ON t (n);"
+                      "SELECT m FROM t;"
+                      "DELETE FROM t WHERE s = 1;"
+                      "DROP TABLE t;"
+                      "SELECT n FROM t;");
+    ASSERT_EQ(results[0].error().type(), ExecErrorType::RowTooLarge);
+    ASSERT_EQ(results[1].error().type(), ExecErrorType::NotIndexable);
+    ASSERT_EQ(results[2].error().type(), ExecErrorType::NoSuchColumn);
+    ASSERT_EQ(results[3].error().type(), ExecErrorType::TypeMismatch);
+    ASSERT_TRUE(results[4]);
+    ASSERT_EQ(results[5].error().type(), ExecErrorType::NoSuchTable);
+    ASSERT_EQ(paged.tables(), 0);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,119 @@
+#include "librdb/Simd.hpp"
+#include "librdb/engine/FilterKernels.hpp"
+#include "librdb/engine/Selection.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using rdb::SimdLevel;
+using rdb::engine::Selection;
+using rdb::parser::CompareOp;
+
+namespace {
+const std::vector<SimdLevel> Levels(
+        {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2});
+
+const std::vector<CompareOp> Ops(
+        {CompareOp::Equal,
+         CompareOp::NotEqual,
+         CompareOp::Less,
+         CompareOp::LessEqual,
+         CompareOp::Greater,
+         CompareOp::GreaterEqual});
+
+class FilterKernelsTest : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        rdb::set_simd_level(rdb::detected_simd_level());
+    }
+};
+
+template <typename T>
+bool compare(CompareOp op, T a, T b)
+{
+    switch (op) {
+    case CompareOp::Equal:
+        return rdb::parser::compare<CompareOp::Equal>(a, b);
+    case CompareOp::NotEqual:
+        return rdb::parser::compare<CompareOp::NotEqual>(a, b);
+    case CompareOp::Less:
+        return rdb::parser::compare<CompareOp::Less>(a, b);
+    case CompareOp::LessEqual:
+        return rdb::parser::compare<CompareOp::LessEqual>(a, b);
+    case CompareOp::Greater:
+        return rdb::parser::compare<CompareOp::Greater>(a, b);
+    default:
+        return rdb::parser::compare<CompareOp::GreaterEqual>(a, b);
+    }
+}
+
+// Every level, operator and number of rows up to three words and a bit,
+// so that each kernel ends both on and inside a word; the bits past the last
+// row must come out clear.
+template <typename T>
+void expect_rows_match(const std::vector<T>& values, T constant)
+{
+    for (SimdLevel level : Levels) {
+        rdb::set_simd_level(level);
+        for (CompareOp op : Ops) {
+            for (size_t rows = 0; rows <= values.size(); rows++) {
+                Selection selection(rows, true);
+                rdb::engine::filter_constant(
+                        op, values.data(), constant, selection);
+                for (size_t row = 0; row < rows; row++) {
+                    ASSERT_EQ(
+                            selection.test(row),
+                            compare(op, values[row], constant))
+                            << "level " << static_cast<int>(level) << ", "
+                            << op << ", " << rows << " rows, row " << row;
+                }
+                size_t count = 0;
+                for (size_t row = 0; row < rows; row++) {
+                    count += compare(op, values[row], constant);
+                }
+                ASSERT_EQ(selection.count(), count);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_F(FilterKernelsTest, IntColumns)
+{
+    std::mt19937 random(5);
+    std::vector<long> values;
+    for (size_t row = 0; row < 3 * 64 + 7; row++) {
+        values.push_back(
+                std::uniform_int_distribution<long>(-3, 3)(random));
+    }
+    // Comparisons across the sign and at the ends of the range, which a
+    // signed lane compare must get right.
+    values[5] = std::numeric_limits<long>::min();
+    values[70] = std::numeric_limits<long>::max();
+    expect_rows_match(values, 0L);
+    expect_rows_match(values, -3L);
+    expect_rows_match(values, std::numeric_limits<long>::max());
+    expect_rows_match(values, std::numeric_limits<long>::min());
+}
+
+TEST_F(FilterKernelsTest, RealColumns)
+{
+    std::mt19937 random(9);
+    std::vector<double> values;
+    for (size_t row = 0; row < 3 * 64 + 7; row++) {
+        values.push_back(
+                std::uniform_int_distribution<int>(-4, 4)(random) / 2.0);
+    }
+    values[3] = -0.0;
+    values[64] = std::numeric_limits<double>::infinity();
+    values[130] = -std::numeric_limits<double>::infinity();
+    values[131] = std::nan("");
+    expect_rows_match(values, 0.0);
+    expect_rows_match(values, 1.5);
+    expect_rows_match(values, -std::numeric_limits<double>::infinity());
+}
@@ -0,0 +1,181 @@
+#include "librdb/engine/Column.hpp"
+#include "librdb/engine/Index.hpp"
+#include "librdb/engine/Selection.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using rdb::engine::Column;
+using rdb::engine::Index;
+using rdb::engine::Renumbering;
+using rdb::engine::Selection;
+using rdb::engine::TextColumn;
+using rdb::parser::CompareOp;
+using rdb::parser::IndexKind;
+
+namespace {
+const std::vector<CompareOp> Ops(
+        {CompareOp::Equal,
+         CompareOp::NotEqual,
+         CompareOp::Less,
+         CompareOp::LessEqual,
+         CompareOp::Greater,
+         CompareOp::GreaterEqual});
+
+template <typename T>
+bool compare(CompareOp op, const T& a, const T& b)
+{
+    switch (op) {
+    case CompareOp::Equal:
+        return rdb::parser::compare<CompareOp::Equal>(a, b);
+    case CompareOp::NotEqual:
+        return rdb::parser::compare<CompareOp::NotEqual>(a, b);
+    case CompareOp::Less:
+        return rdb::parser::compare<CompareOp::Less>(a, b);
+    case CompareOp::LessEqual:
+        return rdb::parser::compare<CompareOp::LessEqual>(a, b);
+    case CompareOp::Greater:
+        return rdb::parser::compare<CompareOp::Greater>(a, b);
+    default:
+        return rdb::parser::compare<CompareOp::GreaterEqual>(a, b);
+    }
+}
+
+// The index must find exactly the rows a scan of values would, in order,
+// for every operator it answers.
+template <typename Values, typename T>
+void expect_index_matches(
+        const Index& index, const Values& values, const T& constant)
+{
+    for (CompareOp op : Ops) {
+        std::vector<size_t> rows;
+        if (!index.select(op, constant, rows)) {
+            ASSERT_FALSE(index.answers(op));
+            continue;
+        }
+        std::vector<size_t> expected;
+        for (size_t row = 0; row < values.size(); row++) {
+            if (compare(op, T(values[row]), constant)) {
+                expected.push_back(row);
+            }
+        }
+        ASSERT_EQ(rows, expected) << op << " " << constant;
+    }
+}
+
+// Random values in [0, distinct) inserted in several batches, some rows
+// removed between them; both kinds of index are checked after each step.
+void check_long_indexes(size_t distinct)
+{
+    std::mt19937 random(static_cast<unsigned>(distinct));
+    std::vector<long> values;
+    Index hash("h", 0, IndexKind::Hash, Column(values));
+    Index ordered("o", 0, IndexKind::Ordered, Column(values));
+    for (int batch = 0; batch < 6; batch++) {
+        size_t first = values.size();
+        size_t rows = std::uniform_int_distribution<size_t>(1, 900)(random);
+        for (size_t row = 0; row < rows; row++) {
+            values.push_back(static_cast<long>(random() % distinct) - 3);
+        }
+        Column column(values);
+        hash.append(column, first);
+        ordered.append(column, first);
+
+        if (batch % 2 == 1) {
+            Selection removed(values.size());
+            for (size_t row = 0; row < values.size(); row++) {
+                if (random() % 3 == 0) {
+                    removed.set(row);
+                }
+            }
+            hash.remove_rows(removed);
+            ordered.remove_rows(removed);
+            std::vector<long> kept;
+            for (size_t row = 0; row < values.size(); row++) {
+                if (!removed.test(row)) {
+                    kept.push_back(values[row]);
+                }
+            }
+            values.swap(kept);
+        }
+
+        for (long constant : {-4L, -3L, 0L, 5L, static_cast<long>(distinct)}) {
+            expect_index_matches(hash, values, constant);
+            expect_index_matches(ordered, values, constant);
+        }
+    }
+}
+} // namespace
+
+TEST(IndexTest, LongsWithFewAndManyDistinctValues)
+{
+    check_long_indexes(4);
+    check_long_indexes(100);
+    check_long_indexes(100000);
+}
+
+TEST(IndexTest, ValuesInsertedInOrder)
+{
+    std::vector<long> values;
+    for (long row = 0; row < 10000; row++) {
+        values.push_back(row / 3);
+    }
+    Index ordered("o", 0, IndexKind::Ordered, Column(values));
+    for (long constant : {0L, 1L, 1700L, 3333L, 3334L}) {
+        expect_index_matches(ordered, values, constant);
+    }
+}
+
+TEST(IndexTest, RealsAndTexts)
+{
+    std::vector<double> reals({1.5, -0.0, 2, 1.5, -7.25, 0.0});
+    Index reals_hash("rh", 0, IndexKind::Hash, Column(reals));
+    Index reals_ordered("ro", 0, IndexKind::Ordered, Column(reals));
+    for (double constant : {0.0, -0.0, 1.5, 2.0, 3.0}) {
+        expect_index_matches(reals_hash, reals, constant);
+        expect_index_matches(reals_ordered, reals, constant);
+    }
+    // An integer constant is looked up in a REAL column as a double.
+    std::vector<size_t> rows;
+    ASSERT_TRUE(reals_hash.select(CompareOp::Equal, 2L, rows));
+    ASSERT_EQ(rows, std::vector<size_t>({2}));
+
+    TextColumn texts;
+    std::vector<std::string> strings;
+    for (int row = 0; row < 300; row++) {
+        strings.push_back("k" + std::to_string(row % 37));
+        texts.push_back(strings.back());
+    }
+    Index texts_hash("th", 0, IndexKind::Hash, Column(texts));
+    Index texts_ordered("to", 0, IndexKind::Ordered, Column(texts));
+    for (std::string constant : {"k0", "k20", "k36", "k5", "x", ""}) {
+        expect_index_matches(texts_hash, strings, constant);
+        expect_index_matches(texts_ordered, strings, constant);
+    }
+}
+
+TEST(IndexTest, ConstantsOfAnotherTypeAreNotAnswered)
+{
+    Index ints("i", 0, IndexKind::Ordered, Column(std::vector<long>{1, 2}));
+    std::vector<size_t> rows;
+    ASSERT_FALSE(ints.select(CompareOp::Equal, 1.0, rows));
+    ASSERT_FALSE(ints.select(CompareOp::Equal, "1", rows));
+    ASSERT_FALSE(ints.select(CompareOp::NotEqual, 1L, rows));
+    ASSERT_TRUE(rows.empty());
+}
+
+TEST(IndexTest, RenumberingClosesUpRows)
+{
+    Selection removed(130);
+    for (size_t row : {0, 5, 63, 64, 100}) {
+        removed.set(row);
+    }
+    Renumbering renumbering(removed);
+    ASSERT_EQ(renumbering(0), Renumbering::Removed);
+    ASSERT_EQ(renumbering(1), 0);
+    ASSERT_EQ(renumbering(6), 4);
+    ASSERT_EQ(renumbering(65), 61);
+    ASSERT_EQ(renumbering(129), 124);
+}
@@ -0,0 +1,53 @@
+#include "librdb/lexer/Fingerprint.hpp"
+#include "gtest/gtest.h"
+#include <string>
+
+using rdb::parser::Fingerprint;
+
+TEST(FingerprintTest, NormalizesLiteralsKeywordsAndWhitespace)
+{
+    Fingerprint sql = rdb::parser::fingerprint(
+            "insert   into users (name,age)\n\tvalues ( \"Ann\", 42 ) ;"
+            "select a b from users where age >= -0.5;");
+    ASSERT_EQ(
+            sql.normalized,
+            "INSERT INTO users (name, age) VALUES (?, ?); "
+            "SELECT a b FROM users WHERE age >= ?;");
+    ASSERT_EQ(sql.digest, rdb::parser::fnv1a_64(sql.normalized));
+}
+
+TEST(FingerprintTest, SameShapeSameDigest)
+{
+    auto first = rdb::parser::fingerprint("DELETE FROM t WHERE a = 1;");
+    auto second = rdb::parser::fingerprint(
+            "Delete  From t\r\nWhere a = \"one\"  ;");
+    auto other = rdb::parser::fingerprint("DELETE FROM t WHERE b = 1;");
+    ASSERT_EQ(first.normalized, second.normalized);
+    ASSERT_EQ(first.digest, second.digest);
+    ASSERT_NE(first.digest, other.digest);
+
+    // Placeholders already are what literals become.
+    ASSERT_EQ(
+            rdb::parser::fingerprint("DELETE FROM t WHERE a = ?;").digest,
+            first.digest);
+}
+
+TEST(FingerprintTest, DigestIsStable)
+{
+    // Reference values of 64-bit FNV-1a, which must never change: digests
+    // are stored and compared across processes and builds.
+    ASSERT_EQ(rdb::parser::fnv1a_64(""), 0xcbf29ce484222325ULL);
+    ASSERT_EQ(rdb::parser::fnv1a_64("a"), 0xaf63dc4c8601ec8cULL);
+    ASSERT_EQ(rdb::parser::fnv1a_64("foobar"), 0x85944171f73967e8ULL);
+}
+
+TEST(FingerprintTest, KeepsMalformedInput)
+{
+    Fingerprint sql;
+    rdb::parser::fingerprint("DROP @ x\"", sql);
+    ASSERT_EQ(sql.normalized, "DROP @ x \"");
+
+    rdb::parser::fingerprint("  \n", sql);
+    ASSERT_EQ(sql.normalized, "");
+    ASSERT_EQ(sql.digest, rdb::parser::fnv1a_64(""));
+}
@@ -1,14 +1,22 @@
 #include "librdb/lexer/Lexer.hpp"
+#include "librdb/lexer/LineIndex.hpp"
+#include "librdb/lexer/RegexLexer.hpp"
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <array>
 #include <queue>
+#include <random>
 #include <string>
 #include <string_view>
 #include <vector>
 
 using rdb::parser::Lexer;
+using rdb::parser::LineIndex;
+using rdb::parser::Position;
+using rdb::parser::RegexLexer;
 using rdb::parser::Token;
 using rdb::parser::TokenType;
+using rdb::parser::TokenTypes;
 
 TEST(LexerTest, HandlesRubbishInput)
 {
@@ -56,6 +64,31 @@ TEST(LexerTest, HandlesExprInput)
     }
 }
 
+TEST(LexerTest, HandlesPlaceholderInput)
+{
+    std::string instring("(?,?" "?) x?\"?\"");
+    Lexer lexer(instring);
+    std::vector<TokenType> token_expected_seq(
+            {TokenType::ParenthesisOpening,
+             TokenType::Placeholder,
+             TokenType::Comma,
+             TokenType::Placeholder,
+             TokenType::Placeholder,
+             TokenType::ParenthesisClosing,
+             TokenType::VarId,
+             TokenType::Placeholder,
+             TokenType::VarText,
+             TokenType::EndOfFile});
+
+    for (auto&& expected : token_expected_seq) {
+        Token token = lexer.get();
+        ASSERT_EQ(token.type, expected);
+        if (expected == TokenType::Placeholder) {
+            ASSERT_EQ(token.lexeme, "?");
+        }
+    }
+}
+
 TEST(LexerTest, HandlesIntInput)
 {
     std::string instring("(1.345 <= 4 )(4>0.2)( 0< 66 )");
@@ -200,10 +233,49 @@ TEST(LexerTest, LexerPeekTest)
     ASSERT_EQ(token.lexeme, "a");
 }
 
+TEST(LexerTest, LexerPeekAheadTest)
+{
+    std::string instring("SELECT a b FROM t;");
+    Lexer lexer(instring);
+    std::vector<Token> peeked;
+
+    for (size_t n = 0; n < Lexer::MaxLookahead; n++) {
+        peeked.push_back(lexer.peek(n));
+    }
+    ASSERT_THROW(lexer.peek(Lexer::MaxLookahead), std::out_of_range);
+    for (auto&& token : peeked) {
+        ASSERT_EQ(lexer.get().lexeme, token.lexeme);
+    }
+    ASSERT_EQ(lexer.peek(1).lexeme, ";");
+    ASSERT_EQ(lexer.get().lexeme, "t");
+}
+
+TEST(LexerTest, ScansEveryByteOnce)
+{
+    std::string instring(
+            "CREATE TABLE users (name TEXT, age INT);\n  SELECT name age "
+            "FROM users WHERE age >= 22;\n");
+    Lexer lexer(instring);
+    Token token;
+
+    // The parser's pattern: peek at the next token(s), then consume them.
+    do {
+        Token peeked = lexer.peek();
+        lexer.peek(2);
+        size_t scanned = lexer.bytes_scanned();
+        token = lexer.get();
+        ASSERT_EQ(token.lexeme, peeked.lexeme);
+        ASSERT_EQ(lexer.bytes_scanned(), scanned);
+    } while (token.type != TokenType::EndOfFile);
+
+    ASSERT_EQ(lexer.bytes_scanned(), instring.size());
+}
+
 TEST(LexerTest, CorrectColRowInfo)
 {
     std::string instring("INT a;\nText s = \"aaa bbb\";\nreal b = 1.0");
     Lexer lexer(instring);
+    LineIndex line_index(instring);
     std::vector<Token> token_seq;
     std::vector<size_t> token_col_expected_seq(
             {1, 5, 6, 1, 6, 8, 10, 19, 1, 6, 8, 10, 13});
@@ -217,7 +289,147 @@ TEST(LexerTest, CorrectColRowInfo)
     ASSERT_EQ(token_col_expected_seq.size(), token_seq.size());
     int count = token_col_expected_seq.size();
     for (int i = 0; i < count; i++) {
-        ASSERT_EQ(token_seq[i].parsed_col, token_col_expected_seq[i]);
-        ASSERT_EQ(token_seq[i].parsed_row, token_row_expected_seq[i]);
+        Position position = line_index.locate(token_seq[i].offset);
+        ASSERT_EQ(position.col, token_col_expected_seq[i]);
+        ASSERT_EQ(position.row, token_row_expected_seq[i]);
+    }
+}
+
+TEST(LexerTest, RecognisesEveryKeywordCaseInsensitively)
+{
+    for (auto&& info : TokenTypes) {
+        if (info.keyword.empty()) {
+            continue;
+        }
+        std::string upper(info.keyword);
+        std::string lower(upper);
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        std::string mixed(lower);
+        mixed.front() = upper.front();
+
+        for (auto&& spelling : {upper, lower, mixed}) {
+            std::string instring(
+                    spelling + ";" + spelling + "1 " + spelling + "=");
+            Lexer lexer(instring);
+            ASSERT_EQ(lexer.get().type, info.type) << spelling;
+            ASSERT_EQ(lexer.get().type, TokenType::Semicolon);
+            ASSERT_EQ(lexer.get().type, TokenType::VarId) << spelling + "1";
+            ASSERT_EQ(lexer.get().type, TokenType::VarId) << spelling + "=";
+        }
+    }
+}
+
+TEST(LexerTest, KeywordNearMissesAreIdentifiers)
+{
+    std::string instring("CREAT CREATES INTEGER TXT TEXTT DROPS RE4L SELECT9");
+    Lexer lexer(instring);
+    Token token;
+
+    while ((token = lexer.get()).type != TokenType::EndOfFile) {
+        ASSERT_EQ(token.type, TokenType::VarId) << token.lexeme;
+    }
+}
+
+namespace {
+void expect_same_tokens_as_regex_lexer(const std::string& instring)
+{
+    Lexer lexer(instring);
+    RegexLexer reference(instring);
+    Token token;
+    Token expected;
+
+    do {
+        token = lexer.get();
+        expected = reference.get();
+        ASSERT_EQ(token.type, expected.type) << instring;
+        ASSERT_EQ(token.lexeme, expected.lexeme) << instring;
+        ASSERT_EQ(token.offset, expected.offset) << instring;
+    } while (expected.type != TokenType::EndOfFile);
+}
+} // namespace
+
+TEST(LexerTest, MatchesRegexLexerOnCorpus)
+{
+    std::vector<std::string> corpus(
+            {"!///\\    *&&^%$# @  .\n'\"",
+             "((({<= <= >})))",
+             "(1.345 <= 4 )(4>0.2)( 0< 66 )",
+             "(\"(lorem ipsum )\")\"66 domina\\\"   \n 00",
+             "TEXT tXt = (\"{Never gonna give you up! Never gonna let you "
+             "down!}\");\nint i=0;\nReAl PI =3.1415;",
+             "INT a = 0;",
+             "INT a;\nText s = \"aaa bbb\";\nreal b = 1.0",
+             "-0.5 +0 -12.5 12. 0123 1.2.3 -x + -",
+             "INTO INTEGER int( FROM=a WHERE\vb SELECT\fc VALUES,",
+             "\"unterminated\n\"also\r\"\" != !! <> =<"});
+
+    for (auto&& instring : corpus) {
+        expect_same_tokens_as_regex_lexer(instring);
     }
-}
\ No newline at end of file
+}
+
+TEST(LexerTest, MatchesRegexLexerOnGeneratedInput)
+{
+    constexpr std::array<std::string_view, 32> fragments{
+            "CREATE", "select", "InSeRt", "delete", "DROP", "values",
+            "table",  "int",    "INTO",   "Real",   "text", "where",
+            "from",   "abc",    "x1",     "0",      "7",    "42",
+            "0.",     ".5",     "-",      "+",      "\"",   "\"a b\"",
+            "<",      ">",      "=",      "!",      " ",    "\n\t",
+            "(),;{}", "\v?\r"};
+    std::mt19937 random(2021);
+    std::uniform_int_distribution<size_t> pick(0, fragments.size() - 1);
+
+    for (int input = 0; input < 300; input++) {
+        std::string instring;
+        for (int fragment = 0; fragment < 40; fragment++) {
+            instring += fragments[pick(random)];
+        }
+        expect_same_tokens_as_regex_lexer(instring);
+    }
+}
+
+namespace {
+// The token get() calls end on when looking for the next Semicolon.
+Token get_past_semicolon(Lexer& lexer)
+{
+    Token token;
+    do {
+        token = lexer.get();
+    } while ((token.type != TokenType::Semicolon)
+             && (token.type != TokenType::EndOfFile));
+    return token;
+}
+} // namespace
+
+TEST(LexerTest, SkipsPastSemicolonLikeGet)
+{
+    constexpr std::array<std::string_view, 16> fragments{
+            "DROP", "t", " ", ";", ";", "\"", "\"a;b\"", "\n",
+            "\r",   "(", "7", "x;", "\";\n", "\"\"", "@", "\t;"};
+    std::mt19937 random(13);
+    std::uniform_int_distribution<size_t> pick(0, fragments.size() - 1);
+
+    for (int input = 0; input < 500; input++) {
+        std::string instring;
+        for (int fragment = 0; fragment < 30; fragment++) {
+            instring += fragments[pick(random)];
+        }
+        Lexer skipping(instring);
+        Lexer getting(instring);
+        Token expected;
+        do {
+            // Tokens peeked before skipping are consumed first.
+            size_t peeked = random() % Lexer::MaxLookahead;
+            for (size_t n = 0; n < peeked; n++) {
+                skipping.peek(n);
+            }
+            Token skipped = skipping.skip_past_semicolon();
+            expected = get_past_semicolon(getting);
+            ASSERT_EQ(skipped.type, expected.type) << instring;
+            ASSERT_EQ(skipped.offset, expected.offset) << instring;
+            ASSERT_EQ(skipped.lexeme, expected.lexeme) << instring;
+            ASSERT_EQ(skipping.get().offset, getting.get().offset) << instring;
+        } while (expected.type != TokenType::EndOfFile);
+    }
+}
@@ -0,0 +1,37 @@
+#include "librdb/lexer/LineIndex.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using rdb::parser::LineIndex;
+using rdb::parser::Position;
+
+TEST(LineIndexTest, LocatesOffsets)
+{
+    std::string instring("ab\n\ncd\r\n\nlast");
+    LineIndex line_index(instring);
+    ASSERT_EQ(line_index.lines(), 5);
+
+    std::vector<Position> expected_seq(
+            {{1, 1}, {1, 2}, {1, 3}, {2, 1}, {3, 1}, {3, 2}, {3, 3}, {3, 4},
+             {4, 1}, {5, 1}, {5, 2}, {5, 3}, {5, 4}, {5, 5}});
+    ASSERT_EQ(expected_seq.size(), instring.size() + 1);
+    for (size_t offset = 0; offset <= instring.size(); offset++) {
+        Position position = line_index.locate(offset);
+        ASSERT_EQ(position.row, expected_seq[offset].row) << offset;
+        ASSERT_EQ(position.col, expected_seq[offset].col) << offset;
+    }
+}
+
+TEST(LineIndexTest, HandlesEmptyAndTrailingNewline)
+{
+    LineIndex empty("");
+    ASSERT_EQ(empty.lines(), 1);
+    ASSERT_EQ(empty.locate(0).row, 1);
+    ASSERT_EQ(empty.locate(0).col, 1);
+
+    LineIndex trailing("x\n");
+    ASSERT_EQ(trailing.lines(), 2);
+    ASSERT_EQ(trailing.locate(2).row, 2);
+    ASSERT_EQ(trailing.locate(2).col, 1);
+}
@@ -0,0 +1,169 @@
+#include "librdb/Simd.hpp"
+#include "librdb/lexer/Lexer.hpp"
+#include "librdb/lexer/LineIndex.hpp"
+#include "librdb/lexer/ScanKernels.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using rdb::SimdLevel;
+using rdb::parser::Lexer;
+using rdb::parser::LineIndex;
+using rdb::parser::Token;
+using rdb::parser::TokenType;
+
+namespace {
+using Kernel = const char* (*)(const char*, const char*);
+
+const std::vector<SimdLevel> Levels(
+        {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2});
+
+class ScanKernelsTest : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        rdb::set_simd_level(rdb::detected_simd_level());
+    }
+};
+
+// Long runs of one kind of byte broken by single bytes of any kind, so that
+// every kernel sees runs ending inside, at the border of and after a vector.
+std::string make_runs(std::mt19937& random, std::string_view alphabet)
+{
+    constexpr std::string_view breakers = " \t\n\r\"a9_;(-.\v";
+    std::string runs;
+    for (int run = 0; run < 8; run++) {
+        size_t length = std::uniform_int_distribution<size_t>(0, 70)(random);
+        for (size_t i = 0; i < length; i++) {
+            runs += alphabet[random() % alphabet.length()];
+        }
+        runs += breakers[random() % breakers.length()];
+    }
+    return runs;
+}
+
+void expect_levels_agree(Kernel kernel, std::string_view alphabet)
+{
+    std::mt19937 random(17);
+    for (int input = 0; input < 200; input++) {
+        std::string runs = make_runs(random, alphabet);
+        for (size_t begin = 0; begin < runs.length(); begin++) {
+            const char* first = runs.data() + begin;
+            const char* last = runs.data() + runs.length();
+            rdb::set_simd_level(SimdLevel::Scalar);
+            const char* expected = kernel(first, last);
+            for (SimdLevel level : Levels) {
+                rdb::set_simd_level(level);
+                ASSERT_EQ(kernel(first, last), expected) << runs;
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_F(ScanKernelsTest, WhitespaceLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_whitespace, " \t\n\r");
+}
+
+TEST_F(ScanKernelsTest, AlnumLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_alnum, "azAZ09mM@[`{/:\x80\xff");
+}
+
+TEST_F(ScanKernelsTest, DigitsLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_digits, "0123456789/:");
+}
+
+TEST_F(ScanKernelsTest, TextLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_text, "lorem ipsum\t\\'\x80");
+}
+
+TEST_F(ScanKernelsTest, LineLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_line, "lorem ipsum\r\"\x80");
+}
+
+TEST_F(ScanKernelsTest, StatementLevelsAgree)
+{
+    expect_levels_agree(rdb::parser::skip_statement, "SELECT a, 'b'\n\x80");
+}
+
+TEST_F(ScanKernelsTest, CountsNewlines)
+{
+    std::mt19937 random(3);
+    for (int input = 0; input < 100; input++) {
+        std::string runs = make_runs(random, "\n \n\r");
+        size_t expected = std::count(runs.begin(), runs.end(), '\n');
+        for (SimdLevel level : Levels) {
+            rdb::set_simd_level(level);
+            ASSERT_EQ(
+                    rdb::parser::count_newlines(
+                            runs.data(), runs.data() + runs.length()),
+                    expected);
+        }
+    }
+}
+
+TEST_F(ScanKernelsTest, LexerPositionsAgreeAcrossLevels)
+{
+    std::string instring(
+            "CREATE TABLE users (name TEXT);\n"
+            "                                        \n"
+            "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tINSERT INTO users (name) "
+            "VALUES (\"a rather long string literal that spans more than "
+            "thirty-two bytes\");\r\n"
+            "SELECT averyveryveryverylongidentifiernamethatkeepsgoing FROM t "
+            "WHERE x = 123456789012345678.123456789012345678;\n"
+            "\"an unterminated literal that runs over forty bytes\n;");
+
+    rdb::set_simd_level(SimdLevel::Scalar);
+    std::vector<Token> expected;
+    Lexer scalar_lexer(instring);
+    do {
+        expected.push_back(scalar_lexer.get());
+    } while (expected.back().type != TokenType::EndOfFile);
+
+    for (SimdLevel level : Levels) {
+        rdb::set_simd_level(level);
+        Lexer lexer(instring);
+        for (auto&& expected_token : expected) {
+            Token token = lexer.get();
+            ASSERT_EQ(token.type, expected_token.type);
+            ASSERT_EQ(token.lexeme, expected_token.lexeme);
+            ASSERT_EQ(token.offset, expected_token.offset);
+        }
+    }
+    rdb::parser::Position position
+            = LineIndex(instring).locate(expected[8].offset);
+    EXPECT_EQ(position.row, 3);
+    EXPECT_EQ(position.col, 22);
+}
+
+TEST_F(ScanKernelsTest, LineIndexAgreesAcrossLevels)
+{
+    std::mt19937 random(5);
+    for (int input = 0; input < 100; input++) {
+        std::string runs = make_runs(random, "abc \r");
+        rdb::set_simd_level(SimdLevel::Scalar);
+        LineIndex expected(runs);
+        for (SimdLevel level : Levels) {
+            rdb::set_simd_level(level);
+            LineIndex line_index(runs);
+            ASSERT_EQ(line_index.lines(), expected.lines());
+            for (size_t offset = 0; offset <= runs.length(); offset++) {
+                ASSERT_EQ(
+                        line_index.locate(offset).row,
+                        expected.locate(offset).row);
+                ASSERT_EQ(
+                        line_index.locate(offset).col,
+                        expected.locate(offset).col);
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "librdb/lexer/Lexer.hpp"
+#include "librdb/lexer/TokenStream.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using rdb::parser::Lexer;
+using rdb::parser::ParseResult;
+using rdb::parser::Token;
+using rdb::parser::TokenCursor;
+using rdb::parser::TokenStream;
+using rdb::parser::TokenType;
+
+namespace {
+const std::string Script(
+        "CREATE TABLE users (name TEXT, age INT, meters REAL);\n"
+        "\tINSERT INTO users (name, age) VALUES (\"Jo\", -12);\r\n"
+        "SELECT name, age FROM users WHERE meters >= 1.75;\n\n"
+        "DELETE FROM users WHERE name != \"unterminated;\n"
+        "SELECT * FROM;   DROP TABLE users;\n"
+        "!@ CREATE TABLE t (x INT);\n"
+        "  \n");
+
+std::string print(const ParseResult& sql)
+{
+    std::stringstream out;
+    out << sql.sql_script;
+    for (auto&& error : sql.errors) {
+        out << error << '\n';
+    }
+    return out.str();
+}
+} // namespace
+
+TEST(TokenStreamTest, MatchesLexer)
+{
+    TokenStream stream = rdb::parser::tokenize_all(Script);
+    Lexer lexer(Script);
+    for (size_t i = 0; i < stream.size(); i++) {
+        Token token = lexer.get();
+        ASSERT_EQ(stream.type(i), token.type) << i;
+        ASSERT_EQ(stream.lexeme(i), token.lexeme) << i;
+    }
+    EXPECT_EQ(stream.type(stream.size() - 1), TokenType::EndOfFile);
+    EXPECT_EQ(stream.offsets.back(), Script.length());
+}
+
+TEST(TokenStreamTest, CursorYieldsLexerTokens)
+{
+    TokenStream stream = rdb::parser::tokenize_all(Script);
+    TokenCursor cursor(stream);
+    Lexer lexer(Script);
+    Token token;
+    do {
+        token = lexer.get();
+        ASSERT_EQ(cursor.peek(1).lexeme, lexer.peek().lexeme);
+        ASSERT_EQ(cursor.peek(1).offset, lexer.peek().offset);
+        Token streamed = cursor.get();
+        ASSERT_EQ(streamed.type, token.type);
+        ASSERT_EQ(streamed.lexeme, token.lexeme);
+        ASSERT_EQ(streamed.offset, token.offset) << token.lexeme;
+    } while (token.type != TokenType::EndOfFile);
+
+    EXPECT_EQ(cursor.get().type, TokenType::EndOfFile);
+    EXPECT_EQ(cursor.peek(3).type, TokenType::EndOfFile);
+}
+
+TEST(TokenStreamTest, CursorSkipsPastSemicolonLikeLexer)
+{
+    TokenStream stream = rdb::parser::tokenize_all(Script);
+    TokenCursor cursor(stream);
+    Lexer lexer(Script);
+    Token token;
+    do {
+        token = lexer.skip_past_semicolon();
+        Token streamed = cursor.skip_past_semicolon();
+        ASSERT_EQ(streamed.type, token.type);
+        ASSERT_EQ(streamed.offset, token.offset);
+        ASSERT_EQ(cursor.peek().offset, lexer.peek().offset);
+    } while (token.type != TokenType::EndOfFile);
+}
+
+TEST(TokenStreamTest, HandlesEmptySource)
+{
+    TokenStream stream = rdb::parser::tokenize_all(" \n\t");
+    ASSERT_EQ(stream.size(), 1);
+    EXPECT_EQ(stream.type(0), TokenType::EndOfFile);
+}
+
+TEST(TokenStreamTest, ParsesLikeParseSql)
+{
+    ParseResult expected = rdb::parser::parse_sql(Script);
+    ParseResult streamed
+            = rdb::parser::parse_sql(rdb::parser::tokenize_all(Script));
+
+    EXPECT_FALSE(expected.errors.empty());
+    EXPECT_EQ(
+            streamed.sql_script.sql_statements.size(),
+            expected.sql_script.sql_statements.size());
+    EXPECT_EQ(print(streamed), print(expected));
+}
@@ -0,0 +1,53 @@
+#include "librdb/parser/Expected.hpp"
+#include "gtest/gtest.h"
+#include <string>
+
+using rdb::parser::Error;
+using rdb::parser::ErrorType;
+using rdb::parser::Expected;
+using rdb::parser::Token;
+using rdb::parser::TokenType;
+
+namespace {
+Expected<int> parse_digit(char c)
+{
+    if (c < '0' || c > '9') {
+        return Error(Token(TokenType::Unknown), ErrorType::VarSyntaxError);
+    }
+    return c - '0';
+}
+
+Expected<void> check_digit(char c)
+{
+    if (auto digit = parse_digit(c); !digit) {
+        return digit.error();
+    }
+    return {};
+}
+} // namespace
+
+TEST(ExpectedTest, HoldsValueOrError)
+{
+    auto digit = parse_digit('7');
+    ASSERT_TRUE(digit);
+    ASSERT_EQ(*digit, 7);
+
+    auto letter = parse_digit('x');
+    ASSERT_FALSE(letter);
+    ASSERT_EQ(letter.error().type(), ErrorType::VarSyntaxError);
+}
+
+TEST(ExpectedTest, PassesErrorsOn)
+{
+    ASSERT_TRUE(check_digit('0'));
+    auto letter = check_digit('x');
+    ASSERT_FALSE(letter.has_value());
+    ASSERT_EQ(letter.error().type(), ErrorType::VarSyntaxError);
+}
+
+TEST(ExpectedTest, HoldsMoveOnlyValues)
+{
+    Expected<std::string> text(std::string(100, 'a'));
+    std::string moved = std::move(*text);
+    ASSERT_EQ(moved, std::string(100, 'a'));
+}
@@ -0,0 +1,101 @@
+#include "librdb/parser/Literals.hpp"
+#include "gtest/gtest.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+
+using rdb::parser::decode_int;
+using rdb::parser::decode_real;
+
+TEST(LiteralsTest, DecodesIntegers)
+{
+    long value = 0;
+    ASSERT_EQ(decode_int("0", value), std::errc());
+    ASSERT_EQ(value, 0);
+    ASSERT_EQ(decode_int("-7", value), std::errc());
+    ASSERT_EQ(value, -7);
+    ASSERT_EQ(decode_int("+12", value), std::errc());
+    ASSERT_EQ(value, 12);
+    ASSERT_EQ(decode_int("12345678", value), std::errc());
+    ASSERT_EQ(value, 12345678);
+    ASSERT_EQ(decode_int("-1234567890123456", value), std::errc());
+    ASSERT_EQ(value, -1234567890123456);
+
+    std::string max = std::to_string(std::numeric_limits<long>::max());
+    ASSERT_EQ(decode_int(max, value), std::errc());
+    ASSERT_EQ(value, std::numeric_limits<long>::max());
+    std::string min = std::to_string(std::numeric_limits<long>::min());
+    ASSERT_EQ(decode_int(min, value), std::errc());
+    ASSERT_EQ(value, std::numeric_limits<long>::min());
+}
+
+TEST(LiteralsTest, ReportsBadIntegers)
+{
+    long value = 42;
+    ASSERT_EQ(
+            decode_int("99999999999999999999", value),
+            std::errc::result_out_of_range);
+    ASSERT_EQ(decode_int("", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_int("-", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_int("+-1", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_int("12a", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_int("1.5", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_int("1 ", value), std::errc::invalid_argument);
+    ASSERT_EQ(value, 42);
+}
+
+TEST(LiteralsTest, DecodesReals)
+{
+    double value = 0;
+    ASSERT_EQ(decode_real("0.5", value), std::errc());
+    ASSERT_EQ(value, 0.5);
+    ASSERT_EQ(decode_real("-12.25", value), std::errc());
+    ASSERT_EQ(value, -12.25);
+    ASSERT_EQ(decode_real("+0.1", value), std::errc());
+    ASSERT_EQ(value, 0.1);
+    ASSERT_EQ(decode_real("-0.0", value), std::errc());
+    ASSERT_TRUE(std::signbit(value));
+    // Past the fast path's 15 digits.
+    ASSERT_EQ(decode_real("3.14159265358979323846", value), std::errc());
+    ASSERT_EQ(value, 3.14159265358979323846);
+
+    ASSERT_EQ(decode_real("1.2.3", value), std::errc::invalid_argument);
+    ASSERT_EQ(decode_real("-", value), std::errc::invalid_argument);
+}
+
+// The fast paths must agree with std::from_chars on everything they take.
+TEST(LiteralsTest, MatchesFromChars)
+{
+    std::mt19937_64 random(7);
+    char buffer[64];
+    for (int round = 0; round < 100000; round++) {
+        int digits = std::uniform_int_distribution<int>(1, 18)(random);
+        long integer = static_cast<long>(random() >> 1);
+        std::string lexeme = std::to_string(integer).substr(0, digits);
+        if (round % 2) {
+            lexeme.insert(0, "-");
+        }
+        long decoded = 0;
+        long expected = 0;
+        ASSERT_EQ(decode_int(lexeme, decoded), std::errc()) << lexeme;
+        std::from_chars(
+                lexeme.data(), lexeme.data() + lexeme.size(), expected);
+        ASSERT_EQ(decoded, expected) << lexeme;
+
+        int decimals = std::uniform_int_distribution<int>(1, 17)(random);
+        double real = std::uniform_real_distribution<double>(-1e6, 1e6)(
+                random);
+        std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, real);
+        lexeme = buffer;
+        double decoded_real = 0;
+        double expected_real = 0;
+        ASSERT_EQ(decode_real(lexeme, decoded_real), std::errc()) << lexeme;
+        std::from_chars(
+                lexeme.data(), lexeme.data() + lexeme.size(), expected_real);
+        ASSERT_EQ(decoded_real, expected_real) << lexeme;
+    }
+}
@@ -0,0 +1,124 @@
+#include "librdb/parser/ParallelParser.hpp"
+#include "librdb/parser/Parser.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using rdb::WorkStealingPool;
+using rdb::parser::ParseResult;
+
+namespace {
+// Statements and errors printed in the order they are reported.
+struct Report {
+    std::vector<std::string> statements;
+    std::vector<std::string> errors;
+};
+
+template <typename T>
+std::string print(const T& item)
+{
+    std::stringstream out;
+    out << item;
+    return out.str();
+}
+
+Report report(const ParseResult& sql)
+{
+    Report printed;
+    for (auto&& statement : sql.sql_script.sql_statements) {
+        printed.statements.push_back(print(statement));
+    }
+    for (auto&& error : sql.errors) {
+        printed.errors.push_back(print(error));
+    }
+    return printed;
+}
+
+void expect_same_report(WorkStealingPool& pool, const std::string& script)
+{
+    Report expected = report(rdb::parser::parse_sql(script));
+    for (size_t chunk_size : {1, 2, 3, 5, 8, 13, 64, 4096}) {
+        Report parallel = report(
+                rdb::parser::parse_sql_parallel(script, pool, chunk_size));
+        ASSERT_EQ(parallel.statements, expected.statements)
+                << script << "\nchunk size " << chunk_size;
+        ASSERT_EQ(parallel.errors, expected.errors)
+                << script << "\nchunk size " << chunk_size;
+    }
+}
+} // namespace
+
+TEST(ParallelParserTest, MatchesParseSql)
+{
+    std::vector<std::string> scripts(
+            {"CREATE TABLE users (name TEXT, age INT, meters REAL);\n"
+             "INSERT INTO users (name, age) VALUES (\"a;b\", 7);\r\n"
+             "SELECT name FROM users WHERE name != \";\";\n  DROP TABLE "
+             "users;",
+             "CREATE table animals;\ninsert into animals (kind, family) "
+             "VALUES (\"Rabbit\",\"Mammals\");\n insert values "
+             "(\"Snake\",\"Reptiles\");\ndrop animals;",
+             "DELETE FROM t WHERE x = \"open;\nDROP TABLE t;\n\"still; "
+             "open\r;DROP TABLE u;",
+             "SELECT a FROM b;\nSELECT c FROM",
+             "INSERT INTO t (a, b\n;DROP TABLE t;\nDROP TABLE u;",
+             "  \n\t",
+             "",
+             "drop table x\n\n;;; ;\"\";\"",
+             "DROP TABLE a;\"\"\"\";DROP TABLE b;\n  DROP x"});
+    for (unsigned threads : {1, 2, 4}) {
+        WorkStealingPool pool(threads);
+        for (auto&& script : scripts) {
+            expect_same_report(pool, script);
+        }
+    }
+}
+
+TEST(ParallelParserTest, MatchesParseSqlOnGeneratedInput)
+{
+    const std::vector<std::string> pieces(
+            {"CREATE TABLE t (a INT, b TEXT);",
+             "INSERT INTO t (a, b) VALUES (1, \"x;y\");",
+             "SELECT a b FROM t WHERE a >= 2;",
+             "DELETE FROM t;",
+             "DROP TABLE t;",
+             "\"",
+             ";",
+             "\n",
+             "\r\n",
+             " ",
+             "DROP",
+             "t",
+             "(a, ",
+             "\"a; b\"",
+             "@"});
+    std::mt19937 random(13);
+    WorkStealingPool pool(3);
+    for (int input = 0; input < 300; input++) {
+        std::string script;
+        for (int piece = 0; piece < 16; piece++) {
+            script += pieces[random() % pieces.size()];
+        }
+        expect_same_report(pool, script);
+    }
+}
+
+TEST(ParallelParserTest, StatementsOutliveTheirChunks)
+{
+    std::string script;
+    for (int i = 0; i < 2000; i++) {
+        script += "INSERT INTO t (x, y) VALUES (" + std::to_string(i)
+                + ", \"row;" + std::to_string(i) + "\");\n";
+    }
+    Report expected = report(rdb::parser::parse_sql(script));
+
+    ParseResult sql = rdb::parser::parse_sql_parallel(script, 4, 1024);
+    ASSERT_GT(sql.merged_arenas.size(), 1);
+    script.assign(script.size(), ' ');
+    Report parallel = report(sql);
+    ASSERT_EQ(parallel.statements, expected.statements);
+    ASSERT_TRUE(parallel.errors.empty());
+}
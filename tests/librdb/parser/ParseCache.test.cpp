@@ -0,0 +1,129 @@
+#include "librdb/parser/ParseCache.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using rdb::parser::ParseCache;
+
+namespace {
+std::string print(const rdb::parser::ParseResult& sql)
+{
+    std::stringstream out;
+    out << sql.sql_script;
+    for (auto&& error : sql.errors) {
+        out << error << "\n";
+    }
+    return out.str();
+}
+} // namespace
+
+TEST(ParseCacheTest, RepeatedScriptIsAHit)
+{
+    ParseCache cache(1 << 20);
+    std::string script("SELECT a b FROM t WHERE a > 1; DROP x;");
+
+    auto first = cache.parse(script);
+    auto second = cache.parse(std::string(script));
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(print(*first), print(rdb::parser::parse_sql(script)));
+
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 1);
+    ASSERT_EQ(stats.evictions, 0);
+    ASSERT_EQ(stats.entries, 1);
+    ASSERT_GT(stats.memory_used, script.size());
+    ASSERT_LE(stats.memory_used, cache.memory_budget());
+}
+
+TEST(ParseCacheTest, ResultsOutliveScriptAndEviction)
+{
+    ParseCache cache(1 << 20);
+    std::string script("INSERT INTO t (a) VALUES (\"text\"); DROP x;");
+    const std::string expected = print(rdb::parser::parse_sql(script));
+
+    auto sql = cache.parse(script);
+    script.assign(script.size(), '#');
+    cache.clear();
+    ASSERT_EQ(cache.stats().entries, 0);
+    ASSERT_EQ(print(*sql), expected);
+    ASSERT_EQ(sql->errors.size(), 1);
+}
+
+TEST(ParseCacheTest, EvictsLeastRecentlyUsed)
+{
+    ParseCache probe(1 << 20);
+    probe.parse("DROP TABLE t0;");
+    const size_t entry_size = probe.stats().memory_used;
+
+    // Room for three entries of about the same size.
+    ParseCache cache(entry_size * 3 + entry_size / 2);
+    cache.parse("DROP TABLE t0;");
+    cache.parse("DROP TABLE t1;");
+    cache.parse("DROP TABLE t2;");
+    cache.parse("DROP TABLE t0;");
+    cache.parse("DROP TABLE t3;");
+    ASSERT_EQ(cache.stats().evictions, 1);
+    ASSERT_EQ(cache.stats().entries, 3);
+
+    // t1 was the least recently used; t0 was used again before t3 came.
+    cache.parse("DROP TABLE t0;");
+    cache.parse("DROP TABLE t2;");
+    cache.parse("DROP TABLE t3;");
+    ASSERT_EQ(cache.stats().hits, 4);
+    cache.parse("DROP TABLE t1;");
+    ASSERT_EQ(cache.stats().hits, 4);
+    ASSERT_EQ(cache.stats().misses, 5);
+    ASSERT_LE(cache.stats().memory_used, cache.memory_budget());
+}
+
+TEST(ParseCacheTest, OversizedScriptIsNotCached)
+{
+    ParseCache cache(64);
+    auto sql = cache.parse("CREATE TABLE t (a INT, b TEXT, c REAL);");
+    ASSERT_EQ(sql->sql_script.sql_statements.size(), 1);
+    cache.parse("CREATE TABLE t (a INT, b TEXT, c REAL);");
+
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.misses, 2);
+    ASSERT_EQ(stats.entries, 0);
+    ASSERT_EQ(stats.memory_used, 0);
+}
+
+TEST(ParseCacheTest, SharedBetweenThreads)
+{
+    ParseCache cache(1 << 16);
+    std::vector<std::string> scripts;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 50; i++) {
+        scripts.push_back(
+                "INSERT INTO t (a, b) VALUES (" + std::to_string(i)
+                + ", \"s\"); DROP t" + std::to_string(i) + ";");
+        expected.push_back(print(rdb::parser::parse_sql(scripts.back())));
+    }
+
+    std::atomic<bool> mismatch(false);
+    std::vector<std::thread> threads;
+    for (unsigned thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&, thread] {
+            for (size_t i = 0; i < 2000; i++) {
+                size_t script = (i * 7 + thread) % scripts.size();
+                if (print(*cache.parse(scripts[script]))
+                    != expected[script]) {
+                    mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(mismatch);
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.hits + stats.misses, 8000);
+    ASSERT_LE(stats.memory_used, cache.memory_budget());
+}
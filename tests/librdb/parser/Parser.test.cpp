@@ -1,16 +1,20 @@
 #include "librdb/lexer/Lexer.hpp"
 #include "librdb/parser/Parser.hpp"
 #include "gtest/gtest.h"
+#include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
-#include <typeinfo>
+#include <variant>
 
 using rdb::parser::ColumnDef;
 using rdb::parser::ErrorType;
 using rdb::parser::Expression;
+using rdb::parser::IndexKind;
 using rdb::parser::Lexer;
 using rdb::parser::ParseResult;
 using rdb::parser::SqlStatement;
+using rdb::parser::String;
 using rdb::parser::TokenType;
 using rdb::parser::Value;
 
@@ -22,14 +26,12 @@ TEST(ParserTest, CreateStatementExtraction)
 
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::CreateTableStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::CreateTableStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::CreateTableStatement>(
+            sql.sql_script.sql_statements[0]));
 
     rdb::parser::CreateTableStatement statement
-            = dynamic_cast<rdb::parser::CreateTableStatement&>(
-                    *sql.sql_script.sql_statements[0]);
+            = std::get<rdb::parser::CreateTableStatement>(
+                    sql.sql_script.sql_statements[0]);
     ASSERT_EQ(statement.table_name(), "users");
     ASSERT_EQ(statement.columns_defined(), 3);
 
@@ -53,14 +55,12 @@ TEST(ParserTest, InsertStatementExtraction)
 
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::InsertStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::InsertStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[0]));
 
     rdb::parser::InsertStatement statement
-            = dynamic_cast<rdb::parser::InsertStatement&>(
-                    *sql.sql_script.sql_statements[0]);
+            = std::get<rdb::parser::InsertStatement>(
+                    sql.sql_script.sql_statements[0]);
     ASSERT_EQ(statement.table_name(), "users");
     ASSERT_EQ(statement.columns_defined(), 3);
 
@@ -69,7 +69,7 @@ TEST(ParserTest, InsertStatementExtraction)
     for (size_t i = 0; i < 3; i++) {
         ASSERT_EQ(statement.column_name(i), column_name_expected_seq[i]);
     }
-    ASSERT_EQ(std::get<std::string>(statement.value(0)), "\"James\"");
+    ASSERT_EQ(std::get<std::string_view>(statement.value(0)), "\"James\"");
     ASSERT_EQ(std::get<long>(statement.value(1)), 29);
     ASSERT_DOUBLE_EQ(std::get<double>(statement.value(2)), 1.8);
 }
@@ -83,21 +83,17 @@ TEST(ParserTest, SelectStatementExtraction)
 
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::SelectStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::SelectStatement*));
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::SelectStatement*>(
-                    sql.sql_script.sql_statements[1].get())),
-            typeid(rdb::parser::SelectStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::SelectStatement>(
+            sql.sql_script.sql_statements[0]));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::SelectStatement>(
+            sql.sql_script.sql_statements[1]));
 
     rdb::parser::SelectStatement statement_expr
-            = dynamic_cast<rdb::parser::SelectStatement&>(
-                    *sql.sql_script.sql_statements[0]);
+            = std::get<rdb::parser::SelectStatement>(
+                    sql.sql_script.sql_statements[0]);
     rdb::parser::SelectStatement statement_no_expr
-            = dynamic_cast<rdb::parser::SelectStatement&>(
-                    *sql.sql_script.sql_statements[1]);
+            = std::get<rdb::parser::SelectStatement>(
+                    sql.sql_script.sql_statements[1]);
     ASSERT_EQ(statement_expr.table_name(), "users");
     ASSERT_EQ(statement_no_expr.table_name(), "users");
     ASSERT_EQ(statement_expr.columns_defined(), 2);
@@ -112,9 +108,9 @@ TEST(ParserTest, SelectStatementExtraction)
     ASSERT_EQ(statement_expr.has_expression(), true);
     ASSERT_EQ(statement_no_expr.has_expression(), false);
     Expression expression = statement_expr.expression();
-    ASSERT_EQ(std::get<std::string>(expression.loperand.val), "age");
+    ASSERT_EQ(std::get<String>(expression.loperand.val), "age");
     ASSERT_EQ(expression.loperand.is_id, true);
-    ASSERT_EQ(expression.operation, ">=");
+    ASSERT_EQ(expression.operation, rdb::parser::CompareOp::GreaterEqual);
     ASSERT_EQ(std::get<long>(expression.roperand.val), 22);
     ASSERT_EQ(expression.roperand.is_id, false);
 }
@@ -127,31 +123,27 @@ TEST(ParserTest, DeleteStatementExtraction)
 
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::DeleteFromStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::DeleteFromStatement*));
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::DeleteFromStatement*>(
-                    sql.sql_script.sql_statements[1].get())),
-            typeid(rdb::parser::DeleteFromStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::DeleteFromStatement>(
+            sql.sql_script.sql_statements[0]));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::DeleteFromStatement>(
+            sql.sql_script.sql_statements[1]));
 
     rdb::parser::DeleteFromStatement statement_no_expr
-            = dynamic_cast<rdb::parser::DeleteFromStatement&>(
-                    *sql.sql_script.sql_statements[0]);
+            = std::get<rdb::parser::DeleteFromStatement>(
+                    sql.sql_script.sql_statements[0]);
     rdb::parser::DeleteFromStatement statement_expr
-            = dynamic_cast<rdb::parser::DeleteFromStatement&>(
-                    *sql.sql_script.sql_statements[1]);
+            = std::get<rdb::parser::DeleteFromStatement>(
+                    sql.sql_script.sql_statements[1]);
     ASSERT_EQ(statement_no_expr.table_name(), "companies");
     ASSERT_EQ(statement_expr.table_name(), "users");
 
     ASSERT_EQ(statement_expr.has_expression(), true);
     ASSERT_EQ(statement_no_expr.has_expression(), false);
     Expression expression = statement_expr.expression();
-    ASSERT_EQ(std::get<std::string>(expression.loperand.val), "name");
+    ASSERT_EQ(std::get<String>(expression.loperand.val), "name");
     ASSERT_EQ(expression.loperand.is_id, true);
-    ASSERT_EQ(expression.operation, "=");
-    ASSERT_EQ(std::get<std::string>(expression.roperand.val), "\"James\"");
+    ASSERT_EQ(expression.operation, rdb::parser::CompareOp::Equal);
+    ASSERT_EQ(std::get<String>(expression.roperand.val), "\"James\"");
     ASSERT_EQ(expression.roperand.is_id, false);
 }
 
@@ -162,17 +154,65 @@ TEST(ParserTest, DropStatementExtraction)
 
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::DropTableStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::DropTableStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::DropTableStatement>(
+            sql.sql_script.sql_statements[0]));
 
     rdb::parser::DropTableStatement statement
-            = dynamic_cast<rdb::parser::DropTableStatement&>(
-                    *sql.sql_script.sql_statements[0]);
+            = std::get<rdb::parser::DropTableStatement>(
+                    sql.sql_script.sql_statements[0]);
     ASSERT_EQ(statement.table_name(), "users");
 }
 
+TEST(ParserTest, CreateIndexStatementExtraction)
+{
+    std::string instring(
+            "CREATE INDEX byage ON users (age);"
+            "create hash index byname on users (name);");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.errors.size(), 0);
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
+
+    const auto& ordered = std::get<rdb::parser::CreateIndexStatement>(
+            sql.sql_script.sql_statements[0]);
+    ASSERT_EQ(ordered.index_name(), "byage");
+    ASSERT_EQ(ordered.table_name(), "users");
+    ASSERT_EQ(ordered.column_name(), "age");
+    ASSERT_EQ(ordered.kind(), IndexKind::Ordered);
+
+    const auto& hash = std::get<rdb::parser::CreateIndexStatement>(
+            sql.sql_script.sql_statements[1]);
+    ASSERT_EQ(hash.index_name(), "byname");
+    ASSERT_EQ(hash.column_name(), "name");
+    ASSERT_EQ(hash.kind(), IndexKind::Hash);
+
+    auto view(rdb::parser::parse_sql_view(instring));
+    std::stringstream owning_out;
+    std::stringstream view_out;
+    owning_out << sql.sql_script;
+    view_out << view.sql_script;
+    ASSERT_EQ(owning_out.str(), view_out.str());
+}
+
+TEST(ParserTest, CreateIndexErrors)
+{
+    auto sql(rdb::parser::parse_sql(
+            "CREATE HASH TABLE t (a INT);"
+            "CREATE INDEX i ON t a;"
+            "CREATE INDEX i ON t (a, b);"
+            "CREATE INDEX ON t (a);"
+            "CREATE TABLE t (a INT);"));
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
+    ASSERT_EQ(sql.errors.size(), 4);
+    ASSERT_EQ(sql.errors[0].token_type(), TokenType::KwTable);
+    ASSERT_EQ(sql.errors[1].token_type(), TokenType::VarId);
+    ASSERT_EQ(sql.errors[2].token_type(), TokenType::Comma);
+    ASSERT_EQ(sql.errors[3].token_type(), TokenType::KwOn);
+    for (auto&& error : sql.errors) {
+        ASSERT_EQ(error.type(), ErrorType::SyntaxError);
+    }
+}
+
 TEST(ParserTest, LawfulInput)
 {
     std::string instring(
@@ -184,18 +224,12 @@ TEST(ParserTest, LawfulInput)
     ASSERT_EQ(sql.errors.size(), 0);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 3);
 
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::CreateTableStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::CreateTableStatement*));
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::InsertStatement*>(
-                    sql.sql_script.sql_statements[1].get())),
-            typeid(rdb::parser::InsertStatement*));
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::DropTableStatement*>(
-                    sql.sql_script.sql_statements[2].get())),
-            typeid(rdb::parser::DropTableStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::CreateTableStatement>(
+            sql.sql_script.sql_statements[0]));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[1]));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::DropTableStatement>(
+            sql.sql_script.sql_statements[2]));
 }
 
 TEST(ParserTest, PartlyChaoticInput)
@@ -209,10 +243,8 @@ TEST(ParserTest, PartlyChaoticInput)
     ASSERT_EQ(sql.errors.size(), 3);
     ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
 
-    ASSERT_EQ(
-            typeid(dynamic_cast<rdb::parser::InsertStatement*>(
-                    sql.sql_script.sql_statements[0].get())),
-            typeid(rdb::parser::InsertStatement*));
+    ASSERT_TRUE(std::holds_alternative<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[0]));
 }
 
 TEST(ParserTest, Misprints)
@@ -228,4 +260,270 @@ TEST(ParserTest, Misprints)
     ASSERT_EQ(sql.errors.at(0).type(), ErrorType::NotStatement);
     ASSERT_EQ(sql.errors.at(1).type(), ErrorType::SyntaxError);
     ASSERT_EQ(sql.errors.at(2).type(), ErrorType::UnexpectedEOF);
-}
\ No newline at end of file
+}
+TEST(ParserTest, ErrorsReportRowAndCol)
+{
+    std::string instring(
+            "CREATE table animals;\n  drop table\n\t animals");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.errors.size(), 2);
+    ASSERT_EQ(sql.errors[0].position().row, 1);
+    ASSERT_EQ(sql.errors[0].position().col, 21);
+    ASSERT_EQ(sql.errors[1].position().row, 3);
+    ASSERT_EQ(sql.errors[1].position().col, 10);
+
+    std::stringstream out;
+    out << sql.errors[0];
+    ASSERT_EQ(
+            out.str(),
+            "! (Semicolon, ;) at row 1, col 21:\n"
+            "  Error::SyntaxError (expected ParenthesisOpening)");
+}
+
+TEST(ParserTest, StraySemicolons)
+{
+    std::string instring(";DROP TABLE a;; ;\nDROP TABLE b;");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
+    ASSERT_EQ(sql.errors.size(), 3);
+    for (auto&& error : sql.errors) {
+        ASSERT_EQ(error.type(), ErrorType::NotStatement);
+        ASSERT_EQ(error.token_type(), TokenType::Semicolon);
+    }
+}
+
+TEST(ParserTest, ListsEndAtSemicolon)
+{
+    std::string instring(
+            "CREATE TABLE a (x INT;\nINSERT INTO b (x, y;DROP TABLE c;\n"
+            "INSERT INTO d (x) VALUES (1;DROP TABLE e;");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
+    ASSERT_EQ(sql.errors.size(), 3);
+    for (auto&& error : sql.errors) {
+        ASSERT_EQ(error.type(), ErrorType::WrongListDefinition);
+        ASSERT_EQ(error.token_type(), TokenType::Semicolon);
+    }
+}
+
+TEST(ParserTest, StatementsLiveInArena)
+{
+    std::string instring(
+            "INSERT INTO aratherlongtablename (firstlongcolumnname) "
+            "VALUES (\"a string literal too long for SSO\");\n"
+            "SELECT aratherlongcolumnname FROM t "
+            "WHERE aratherlongcolumnname = \"another long literal\";");
+    auto sql(rdb::parser::parse_sql(instring));
+    ASSERT_EQ(sql.errors.size(), 0);
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 2);
+    auto* arena = sql.arena.get();
+
+    auto& insert = std::get<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[0]);
+    ASSERT_EQ(insert.table_name().get_allocator().resource(), arena);
+    ASSERT_EQ(insert.column_name(0).get_allocator().resource(), arena);
+    ASSERT_EQ(
+            std::get<rdb::parser::TextColumn>(insert.value_column(0))[0],
+            "\"a string literal too long for SSO\"");
+
+    auto& select = std::get<rdb::parser::SelectStatement>(
+            sql.sql_script.sql_statements[1]);
+    ASSERT_EQ(select.column_name(0).get_allocator().resource(), arena);
+    ASSERT_EQ(
+            std::get<String>(select.expression().roperand.val)
+                    .get_allocator()
+                    .resource(),
+            arena);
+
+    ParseResult moved(std::move(sql));
+    ASSERT_EQ(moved.arena.get(), arena);
+    ASSERT_EQ(insert.table_name(), "aratherlongtablename");
+    // The text column is a copy in the arena, not a view into the script.
+    instring.assign(instring.size(), ' ');
+    ASSERT_EQ(
+            std::get<rdb::parser::TextColumn>(insert.value_column(0))[0],
+            "\"a string literal too long for SSO\"");
+}
+
+namespace {
+template <typename Text>
+std::string print_script(const rdb::parser::BasicParseResult<Text>& sql)
+{
+    std::stringstream out;
+    out << sql.sql_script;
+    for (auto&& error : sql.errors) {
+        out << error << "\n";
+    }
+    return out.str();
+}
+
+bool points_into(std::string_view text, const std::string& source)
+{
+    return text.data() >= source.data()
+            && text.data() + text.size() <= source.data() + source.size();
+}
+} // namespace
+
+TEST(ParserTest, ViewStatementsPointIntoSource)
+{
+    std::string instring(
+            "CREATE TABLE t (a INT, b TEXT);\n"
+            "INSERT INTO t (a, b) VALUES (1, \"one\");\n"
+            "SELECT a b FROM t WHERE b = \"one\";\n"
+            "DELETE FROM t WHERE a > 0.5;\n"
+            "DROP TABLE t;");
+    auto sql(rdb::parser::parse_sql_view(instring));
+    ASSERT_EQ(sql.errors.size(), 0);
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 5);
+    ASSERT_EQ(
+            print_script(sql), print_script(rdb::parser::parse_sql(instring)));
+
+    auto& create = std::get<rdb::parser::CreateTableStatementView>(
+            sql.sql_script.sql_statements[0]);
+    ASSERT_TRUE(points_into(create.table_name(), instring));
+    ASSERT_TRUE(points_into(create.column_def(1).column_name, instring));
+
+    auto& insert = std::get<rdb::parser::InsertStatementView>(
+            sql.sql_script.sql_statements[1]);
+    ASSERT_TRUE(points_into(insert.column_name(0), instring));
+    ASSERT_TRUE(points_into(
+            std::get<std::string_view>(insert.value(1)), instring));
+
+    auto& select = std::get<rdb::parser::SelectStatementView>(
+            sql.sql_script.sql_statements[2]);
+    ASSERT_TRUE(select.has_expression());
+    ASSERT_TRUE(points_into(
+            std::get<std::string_view>(select.expression().loperand.val),
+            instring));
+    ASSERT_EQ(
+            std::get<std::string_view>(select.expression().roperand.val),
+            "\"one\"");
+
+    auto& remove = std::get<rdb::parser::DeleteFromStatementView>(
+            sql.sql_script.sql_statements[3]);
+    ASSERT_EQ(std::get<double>(remove.expression().roperand.val), 0.5);
+}
+
+TEST(ParserTest, ViewErrorsMatchParseSql)
+{
+    std::string instring(
+            "CREATE table animals;\ninsert into animals (kind) VALUES "
+            "(\"Rabbit\"); SELECT x FROM y;\ndrop animals;");
+    ASSERT_EQ(
+            print_script(rdb::parser::parse_sql_view(instring)),
+            print_script(rdb::parser::parse_sql(instring)));
+}
+
+TEST(ParserTest, ToOwningOutlivesSource)
+{
+    std::string expected;
+    std::optional<ParseResult> owning;
+    {
+        std::string instring(
+                "CREATE TABLE t (a INT, b TEXT);\n"
+                "INSERT INTO t (a, b) VALUES (1, \"one\");\n"
+                "SELECT a FROM t;\n"
+                "SELECT a b FROM t WHERE b = \"one\";\n"
+                "DELETE FROM t;\n"
+                "DELETE FROM t WHERE a != 2;\n"
+                "DROP TABLE t;");
+        auto view(rdb::parser::parse_sql_view(instring));
+        expected = print_script(view);
+        owning.emplace(rdb::parser::to_owning(view));
+        instring.assign(instring.size(), '#');
+    }
+    ASSERT_EQ(print_script(*owning), expected);
+
+    auto& statements = owning->sql_script.sql_statements;
+    auto& select = std::get<rdb::parser::SelectStatement>(statements[3]);
+    ASSERT_EQ(
+            select.table_name().get_allocator().resource(),
+            owning->arena.get());
+    ASSERT_FALSE(std::get<rdb::parser::SelectStatement>(statements[2])
+                         .has_expression());
+}
+
+TEST(ParserTest, MultiRowInsertIsColumnar)
+{
+    std::string instring(
+            "INSERT INTO t (id, name, score, misc) VALUES "
+            "(1, \"a\", 0.5, 7), (2, \"bb\", 1.5, \"x\"),\n"
+            "(3, \"\", 2.5, 0.25);");
+    auto sql(rdb::parser::parse_sql(instring));
+    ASSERT_EQ(sql.errors.size(), 0);
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
+
+    const auto& insert = std::get<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[0]);
+    ASSERT_EQ(insert.rows(), 3);
+    ASSERT_EQ(insert.columns_defined(), 4);
+
+    auto& ids
+            = std::get<rdb::parser::ArenaArray<long>>(insert.value_column(0));
+    ASSERT_EQ(
+            std::vector<long>(ids.begin(), ids.end()),
+            (std::vector<long>{1, 2, 3}));
+    auto& names = std::get<rdb::parser::TextColumn>(insert.value_column(1));
+    ASSERT_EQ(names.size(), 3);
+    ASSERT_EQ(names[0], "\"a\"");
+    ASSERT_EQ(names[1], "\"bb\"");
+    ASSERT_EQ(names[2], "\"\"");
+    auto& scores
+            = std::get<rdb::parser::ArenaArray<double>>(insert.value_column(2));
+    ASSERT_DOUBLE_EQ(scores[2], 2.5);
+
+    // Values of different types in one column are boxed, in row order.
+    auto& misc
+            = std::get<rdb::parser::ArenaArray<Value>>(insert.value_column(3));
+    ASSERT_EQ(std::get<long>(misc[0]), 7);
+    ASSERT_EQ(std::get<String>(misc[1]), "\"x\"");
+    ASSERT_DOUBLE_EQ(std::get<double>(insert.value(3, 2)), 0.25);
+
+    auto view(rdb::parser::parse_sql_view(instring));
+    ASSERT_EQ(print_script(view), print_script(sql));
+    ASSERT_EQ(print_script(rdb::parser::to_owning(view)), print_script(sql));
+}
+
+TEST(ParserTest, InsertRowsMatchColumns)
+{
+    std::string instring(
+            "INSERT INTO t (a, b) VALUES (1, 2), (3);\n"
+            "INSERT INTO t (a, b) VALUES (1, 2), (3, 4, 5);\n"
+            "INSERT INTO t (a) VALUES (1), ;\n"
+            "INSERT INTO t (a) VALUES (1) (2);\n"
+            "INSERT INTO t (a) VALUES (1), (2);");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
+    ASSERT_EQ(sql.errors.size(), 4);
+    ASSERT_EQ(sql.errors[0].type(), ErrorType::WrongListDefinition);
+    ASSERT_EQ(sql.errors[0].token_type(), TokenType::ParenthesisClosing);
+    ASSERT_EQ(sql.errors[1].type(), ErrorType::WrongListDefinition);
+    ASSERT_EQ(sql.errors[1].position().row, 2);
+    ASSERT_EQ(sql.errors[1].token_type(), TokenType::ParenthesisClosing);
+    ASSERT_EQ(sql.errors[2].token_type(), TokenType::Semicolon);
+    ASSERT_EQ(sql.errors[3].token_type(), TokenType::ParenthesisOpening);
+}
+
+TEST(ParserTest, NumbersOutOfRange)
+{
+    std::string instring(
+            "INSERT INTO t (a, b) VALUES (+1, 99999999999999999999);\n"
+            "SELECT a FROM t WHERE a = -99999999999999999999;\n"
+            "INSERT INTO t (a) VALUES (-0.5), (12345678.25);");
+    auto sql(rdb::parser::parse_sql(instring));
+
+    ASSERT_EQ(sql.errors.size(), 2);
+    for (auto&& error : sql.errors) {
+        ASSERT_EQ(error.type(), ErrorType::VarOutOfRange);
+        ASSERT_EQ(error.token_type(), TokenType::VarInt);
+    }
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 1);
+    const auto& insert = std::get<rdb::parser::InsertStatement>(
+            sql.sql_script.sql_statements[0]);
+    ASSERT_DOUBLE_EQ(std::get<double>(insert.value(0, 0)), -0.5);
+    ASSERT_DOUBLE_EQ(std::get<double>(insert.value(0, 1)), 12345678.25);
+}
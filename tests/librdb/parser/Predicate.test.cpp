@@ -0,0 +1,117 @@
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/Predicate.hpp"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+
+using rdb::parser::ColumnColumnPredicate;
+using rdb::parser::ColumnConstantPredicate;
+using rdb::parser::CompareOp;
+using rdb::parser::CompiledPredicate;
+using rdb::parser::ConstantPredicate;
+using rdb::parser::SelectStatementView;
+
+namespace {
+// The WHERE clause of a single SELECT, compiled; the script and its AST are
+// kept for the predicate to view.
+struct Compiled {
+    std::string sql;
+    rdb::parser::ParseResultView parsed;
+    CompiledPredicate predicate;
+
+    explicit Compiled(std::string_view where)
+        : sql{"SELECT a FROM t WHERE " + std::string(where) + ";"},
+          parsed{rdb::parser::parse_sql_view(sql)},
+          predicate{rdb::parser::compile_predicate(
+                  std::get<SelectStatementView>(
+                          parsed.sql_script.sql_statements.at(0))
+                          .expression())}
+    {
+    }
+};
+} // namespace
+
+TEST(PredicateTest, CompareOpRoundTrips)
+{
+    for (std::string_view lexeme : {"=", "!=", "<", "<=", ">", ">="}) {
+        std::ostringstream os;
+        os << rdb::parser::to_compare_op(lexeme);
+        ASSERT_EQ(os.str(), lexeme);
+    }
+    ASSERT_THROW(rdb::parser::to_compare_op("=="), std::invalid_argument);
+    ASSERT_EQ(rdb::parser::mirrored(CompareOp::Less), CompareOp::Greater);
+    ASSERT_EQ(rdb::parser::mirrored(CompareOp::Equal), CompareOp::Equal);
+}
+
+TEST(PredicateTest, ColumnAgainstConstant)
+{
+    Compiled adult("age >= 18");
+    auto* typed = std::get_if<
+            ColumnConstantPredicate<CompareOp::GreaterEqual, long>>(
+            &adult.predicate);
+    ASSERT_NE(typed, nullptr);
+    ASSERT_EQ(typed->column, "age");
+    ASSERT_TRUE((*typed)(18));
+    ASSERT_FALSE((*typed)(17));
+
+    // The constant is moved to the right, the operator mirrored.
+    Compiled scored("0.5 < score");
+    auto* real
+            = std::get_if<ColumnConstantPredicate<CompareOp::Greater, double>>(
+                    &scored.predicate);
+    ASSERT_NE(real, nullptr);
+    ASSERT_EQ(real->column, "score");
+    ASSERT_TRUE((*real)(0.75));
+    ASSERT_FALSE((*real)(0.5));
+
+    Compiled named("name != \"Ann\"");
+    auto* text = std::get_if<
+            ColumnConstantPredicate<CompareOp::NotEqual, std::string_view>>(
+            &named.predicate);
+    ASSERT_NE(text, nullptr);
+    ASSERT_TRUE((*text)("\"Bob\""));
+    ASSERT_FALSE((*text)("\"Ann\""));
+}
+
+TEST(PredicateTest, ColumnAgainstColumn)
+{
+    Compiled range("low <= high");
+    auto* typed = std::get_if<ColumnColumnPredicate<CompareOp::LessEqual>>(
+            &range.predicate);
+    ASSERT_NE(typed, nullptr);
+    ASSERT_EQ(typed->left_column, "low");
+    ASSERT_EQ(typed->right_column, "high");
+    ASSERT_TRUE((*typed)(1L, 2L));
+    ASSERT_FALSE((*typed)(2.5, 1.5));
+}
+
+TEST(PredicateTest, ConstantsAreFolded)
+{
+    ASSERT_TRUE(std::get<ConstantPredicate>(Compiled("1 < 1.5").predicate)
+                        .result);
+    ASSERT_FALSE(std::get<ConstantPredicate>(Compiled("2 = 2.5").predicate)
+                         .result);
+    ASSERT_TRUE(std::get<ConstantPredicate>(
+                        Compiled("\"a\" < \"b\"").predicate)
+                        .result);
+    ASSERT_THROW(Compiled("1 = \"1\""), std::invalid_argument);
+}
+
+TEST(PredicateTest, PlaceholdersMustBeBound)
+{
+    ASSERT_THROW(Compiled("age = ?"), std::invalid_argument);
+    ASSERT_THROW(Compiled("? = 1"), std::invalid_argument);
+
+    // The owning flavour compiles the same way.
+    std::string sql("DELETE FROM t WHERE id = 7;");
+    auto parsed = rdb::parser::parse_sql(sql);
+    auto predicate = rdb::parser::compile_predicate(
+            std::get<rdb::parser::DeleteFromStatement>(
+                    parsed.sql_script.sql_statements[0])
+                    .expression());
+    ASSERT_TRUE((std::get<ColumnConstantPredicate<CompareOp::Equal, long>>(
+            predicate)(7)));
+}
@@ -0,0 +1,166 @@
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/PreparedStatement.hpp"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+using rdb::parser::Arena;
+using rdb::parser::ErrorType;
+using rdb::parser::InsertStatementView;
+using rdb::parser::Placeholder;
+using rdb::parser::SelectStatementView;
+using rdb::parser::TokenType;
+using rdb::parser::ValueView;
+
+namespace {
+template <typename T>
+std::string print(const T& item)
+{
+    std::stringstream out;
+    out << item;
+    return out.str();
+}
+
+// What parse_sql() makes of sql, which must hold a single statement.
+std::string parse_one(const std::string& sql)
+{
+    auto parsed = rdb::parser::parse_sql(sql);
+    EXPECT_TRUE(parsed.errors.empty()) << sql;
+    EXPECT_EQ(parsed.sql_script.sql_statements.size(), 1) << sql;
+    return print(parsed.sql_script.sql_statements.front());
+}
+} // namespace
+
+TEST(PreparedStatementTest, ParsesPlaceholdersAsValues)
+{
+    auto sql(rdb::parser::parse_sql(
+            "INSERT INTO t (a, b, c) VALUES (?, 1, ?);"
+            "SELECT a FROM t WHERE ? < b;"
+            "DELETE FROM t WHERE a = ?;"));
+    ASSERT_TRUE(sql.errors.empty());
+    ASSERT_EQ(sql.sql_script.sql_statements.size(), 3);
+
+    const auto& insert
+            = std::get<rdb::parser::InsertStatement>(
+                    sql.sql_script.sql_statements[0]);
+    ASSERT_EQ(std::get<Placeholder>(insert.value(0)).index, 0);
+    ASSERT_EQ(std::get<long>(insert.value(1)), 1);
+    ASSERT_EQ(std::get<Placeholder>(insert.value(2)).index, 1);
+
+    // Placeholders are numbered afresh in every statement.
+    const auto& select
+            = std::get<rdb::parser::SelectStatement>(
+                    sql.sql_script.sql_statements[1]);
+    const auto& loperand = select.expression().loperand;
+    ASSERT_EQ(std::get<Placeholder>(loperand.val).index, 0);
+    ASSERT_FALSE(loperand.is_id);
+    ASSERT_EQ(print(select.expression()), "? < b");
+}
+
+TEST(PreparedStatementTest, BindMatchesParsingTheLiterals)
+{
+    auto insert(rdb::parser::prepare(
+            "INSERT INTO users (name, age, meters) VALUES (?, ?, 1.5);"));
+    ASSERT_TRUE(insert);
+    ASSERT_EQ(insert->parameter_count(), 2);
+
+    Arena arena;
+    std::string name("\"Ann\"");
+    for (long age = 0; age < 3; age++) {
+        auto bound = insert->bind({ValueView(name), ValueView(age)}, arena);
+        ASSERT_EQ(
+                print(bound),
+                parse_one(
+                        "INSERT INTO users (name, age, meters) "
+                        "VALUES (\"Ann\", "
+                        + std::to_string(age) + ", 1.5);"));
+    }
+
+    auto select(rdb::parser::prepare("SELECT a b FROM t WHERE a >= ?;"));
+    ASSERT_TRUE(select);
+    auto bound = select->bind({ValueView(2.5)}, arena);
+    ASSERT_EQ(print(bound), parse_one("SELECT a b FROM t WHERE a >= 2.5;"));
+
+    // The template keeps its placeholders.
+    ASSERT_EQ(
+            print(select->statement()),
+            parse_one("SELECT a b FROM t WHERE a >= ?;"));
+}
+
+TEST(PreparedStatementTest, BindsEveryRow)
+{
+    auto insert(rdb::parser::prepare(
+            "INSERT INTO t (a, b) VALUES (?, 1), (\"x\", ?), (?, 3);"));
+    ASSERT_TRUE(insert);
+    ASSERT_EQ(insert->parameter_count(), 3);
+
+    Arena arena;
+    auto bound = insert->bind(
+            {ValueView(0.5), ValueView(2L), ValueView("\"y\"")}, arena);
+    ASSERT_EQ(
+            print(bound),
+            parse_one("INSERT INTO t (a, b) VALUES (0.5, 1), (\"x\", 2), "
+                      "(\"y\", 3);"));
+    ASSERT_EQ(std::get<InsertStatementView>(bound).rows(), 3);
+}
+
+TEST(PreparedStatementTest, BindSharesWhatHoldsNoPlaceholder)
+{
+    auto select(rdb::parser::prepare("SELECT a FROM t WHERE a = 1;"));
+    ASSERT_TRUE(select);
+    ASSERT_EQ(select->parameter_count(), 0);
+
+    Arena arena;
+    auto bound = select->bind({}, arena);
+    const auto& original = std::get<SelectStatementView>(select->statement());
+    const auto& copy = std::get<SelectStatementView>(bound);
+    ASSERT_EQ(&copy.expression(), &original.expression());
+    ASSERT_EQ(copy.table_name().data(), original.table_name().data());
+}
+
+TEST(PreparedStatementTest, OutlivesItsSource)
+{
+    std::string sql("INSERT INTO t (a) VALUES (?);");
+    auto insert(rdb::parser::prepare(sql));
+    ASSERT_TRUE(insert);
+    sql.assign(sql.size(), ' ');
+
+    Arena arena;
+    auto bound = insert->bind({ValueView(7L)}, arena);
+    ASSERT_EQ(print(bound), parse_one("INSERT INTO t (a) VALUES (7);"));
+}
+
+TEST(PreparedStatementTest, BindChecksParameters)
+{
+    auto insert(rdb::parser::prepare("INSERT INTO t (a, b) VALUES (?, ?);"));
+    ASSERT_TRUE(insert);
+    Arena arena;
+    ASSERT_THROW(insert->bind({ValueView(1L)}, arena), std::invalid_argument);
+    ASSERT_THROW(
+            insert->bind({ValueView(1L), ValueView(Placeholder{0})}, arena),
+            std::invalid_argument);
+}
+
+TEST(PreparedStatementTest, RejectsAnythingButOneStatement)
+{
+    std::string bad("INSERT INTO t (a) VALUES (?, ;");
+    auto error = rdb::parser::prepare(bad);
+    ASSERT_FALSE(error);
+    ASSERT_EQ(
+            print(error.error()),
+            print(rdb::parser::parse_sql(bad).errors.front()));
+
+    auto two = rdb::parser::prepare("DROP TABLE a;\n  DROP TABLE b;");
+    ASSERT_FALSE(two);
+    ASSERT_EQ(two.error().type(), ErrorType::SyntaxError);
+    ASSERT_EQ(two.error().token_type(), TokenType::KwDrop);
+    ASSERT_EQ(two.error().position().row, 2);
+    ASSERT_EQ(two.error().position().col, 3);
+
+    auto none = rdb::parser::prepare("  ");
+    ASSERT_FALSE(none);
+    ASSERT_EQ(none.error().type(), ErrorType::UnexpectedEOF);
+}
@@ -0,0 +1,163 @@
+#include "librdb/parser/Parser.hpp"
+#include "librdb/parser/StreamParser.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using rdb::parser::Error;
+using rdb::parser::SqlStatement;
+using rdb::parser::StreamParser;
+
+namespace {
+// Statements and errors printed in the order they are reported.
+struct Report {
+    std::vector<std::string> statements;
+    std::vector<std::string> errors;
+};
+
+template <typename T>
+std::string print(const T& item)
+{
+    std::stringstream out;
+    out << item;
+    return out.str();
+}
+
+Report parse_whole(std::string_view script)
+{
+    Report report;
+    auto sql(rdb::parser::parse_sql(script));
+    for (auto&& statement : sql.sql_script.sql_statements) {
+        report.statements.push_back(print(statement));
+    }
+    for (auto&& error : sql.errors) {
+        report.errors.push_back(print(error));
+    }
+    return report;
+}
+
+Report parse_streamed(std::string_view script, size_t chunk_size)
+{
+    Report report;
+    StreamParser parser(
+            [&report](const SqlStatement& statement) {
+                report.statements.push_back(print(statement));
+            },
+            [&report](const Error& error) {
+                report.errors.push_back(print(error));
+            });
+    for (size_t pos = 0; pos < script.size(); pos += chunk_size) {
+        parser.feed(script.substr(pos, chunk_size));
+    }
+    parser.finish();
+    return report;
+}
+
+void expect_same_report(const std::string& script)
+{
+    Report expected = parse_whole(script);
+    for (size_t chunk_size : {1, 2, 3, 5, 8, 13, 64, 4096}) {
+        Report streamed = parse_streamed(script, chunk_size);
+        ASSERT_EQ(streamed.statements, expected.statements)
+                << script << "\nchunk size " << chunk_size;
+        ASSERT_EQ(streamed.errors, expected.errors)
+                << script << "\nchunk size " << chunk_size;
+    }
+}
+} // namespace
+
+TEST(StreamParserTest, MatchesParseSql)
+{
+    std::vector<std::string> scripts(
+            {"CREATE TABLE users (name TEXT, age INT, meters REAL);\n"
+             "INSERT INTO users (name, age) VALUES (\"a;b\", 7);\r\n"
+             "SELECT name FROM users WHERE name != \";\";  DROP TABLE users;",
+             "CREATE table animals;\ninsert into animals (kind, family) "
+             "VALUES (\"Rabbit\",\"Mammals\"); insert values "
+             "(\"Snake\",\"Reptiles\");\ndrop animals;",
+             "DELETE FROM t WHERE x = \"open;\nDROP TABLE t;\n\"still; "
+             "open\r;DROP TABLE u;",
+             "SELECT a FROM b; SELECT c FROM",
+             "  \n\t",
+             "",
+             "drop table x\n\n;;; ;\"\";\"",
+             "DROP TABLE a;\"\"\"\";DROP TABLE b;\n  DROP x",
+             "CREATE TABLE a (x INT;\nINSERT INTO b (x, y;DROP TABLE c;\n"
+             "INSERT INTO d (x) VALUES (1;DROP TABLE e;"});
+    for (auto&& script : scripts) {
+        expect_same_report(script);
+    }
+}
+
+TEST(StreamParserTest, MatchesParseSqlOnGeneratedInput)
+{
+    const std::vector<std::string> pieces(
+            {"CREATE TABLE t (a INT, b TEXT);",
+             "INSERT INTO t (a, b) VALUES (1, \"x;y\");",
+             "SELECT a, b FROM t WHERE a >= 2;",
+             "DELETE FROM t;",
+             "DROP TABLE t;",
+             "\"",
+             ";",
+             "\n",
+             "\r\n",
+             " ",
+             "DROP",
+             "t",
+             "\"a; b\"",
+             "@"});
+    std::mt19937 random(11);
+    for (int input = 0; input < 300; input++) {
+        std::string script;
+        for (int piece = 0; piece < 12; piece++) {
+            script += pieces[random() % pieces.size()];
+        }
+        expect_same_report(script);
+    }
+}
+
+TEST(StreamParserTest, ReportsStatementsBeforeInputEnds)
+{
+    size_t statements = 0;
+    StreamParser parser(
+            [&statements](const SqlStatement&) { statements++; },
+            [](const Error&) {});
+
+    parser.feed("DROP TABLE a; DROP TABLE b; INSERT INTO c (x) VALUES (\"");
+    ASSERT_EQ(statements, 2);
+    parser.feed(";\"");
+    ASSERT_EQ(statements, 2);
+    parser.feed(");");
+    ASSERT_EQ(statements, 3);
+    parser.finish();
+    ASSERT_EQ(statements, 3);
+}
+
+TEST(StreamParserTest, ReadsIstream)
+{
+    std::string script;
+    for (int i = 0; i < 1000; i++) {
+        script += "INSERT INTO t (x, y) VALUES (" + std::to_string(i)
+                + ", \"row;" + std::to_string(i) + "\");\n";
+    }
+    script += "DROP t;";
+    Report expected = parse_whole(script);
+
+    Report streamed;
+    StreamParser parser(
+            [&streamed](const SqlStatement& statement) {
+                streamed.statements.push_back(print(statement));
+            },
+            [&streamed](const Error& error) {
+                streamed.errors.push_back(print(error));
+            });
+    std::istringstream input(script);
+    rdb::parser::parse_sql_stream(input, parser, 100);
+
+    ASSERT_EQ(streamed.statements, expected.statements);
+    ASSERT_EQ(streamed.errors, expected.errors);
+    ASSERT_EQ(streamed.errors.size(), 1);
+}